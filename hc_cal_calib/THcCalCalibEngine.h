@@ -0,0 +1,284 @@
+#ifndef ROOT_THcCalCalibEngine
+#define ROOT_THcCalCalibEngine
+
+#include "TMath.h"
+#include <vector>
+#include <thread>
+
+using namespace std;
+
+//
+// Calorimeter calibration engine, common to the HMS and SHMS calibrations.
+//
+// Holds the calibration tracks read from the tree in a columnar cache: one
+// entry per track in the track columns (momentum, coordinates, delta), and
+// one entry per fired PMT in the PMT columns (channel, ADC signal, coordinate
+// corrected signal at unit gain). The tree is read once; the thresholds,
+// the calibration vectors and matrix and the calibrated histograms are all
+// computed from the cache.
+//
+// Energy depositions are linear in the gains, so with the gains alpha the
+// energy seen by a PMT is alpha[channel-1] times its unit gain signal.
+//
+// The vectors and the correlation matrix are accumulated in parallel:
+// each thread takes a contiguous range of tracks and fills its own partial
+// sums, which are added up in thread order at the end.
+//
+
+class THcCalCalibEngine {
+
+ public:
+  THcCalCalibEngine(UInt_t npmts);
+  ~THcCalCalibEngine();
+
+  void Clear();
+
+  void AddTrack(Double_t p, Double_t x, Double_t xp, Double_t y, Double_t yp,
+		Double_t delta);
+  void AddPMT(UInt_t channel, Double_t adc, Double_t signal);
+
+  UInt_t GetNtracks() {return fP.size();}
+  UInt_t GetNPMTs() {return fChannel.size();}
+
+  Double_t GetP(UInt_t it) {return fP[it];}          //GeV
+  Double_t GetX(UInt_t it) {return fX[it];}
+  Double_t GetXp(UInt_t it) {return fXp[it];}
+  Double_t GetY(UInt_t it) {return fY[it];}
+  Double_t GetYp(UInt_t it) {return fYp[it];}
+  Double_t GetDelta(UInt_t it) {return fDelta[it];}
+
+  // PMTs of track it are entries GetFirst(it) to GetLast(it)-1.
+  UInt_t GetFirst(UInt_t it) {return fFirst[it];}
+  UInt_t GetLast(UInt_t it) {
+    return (it+1 < fFirst.size() ? fFirst[it+1] : fChannel.size());
+  }
+
+  UInt_t GetChannel(UInt_t ie) {return fChannel[ie];}
+  Double_t GetADC(UInt_t ie) {return fADC[ie];}
+  Double_t GetSignal(UInt_t ie) {return fSignal[ie];}
+
+  Double_t Enorm(UInt_t it, const Double_t* alpha);
+
+  UInt_t Accumulate(const Double_t* alpha, Double_t lothr, Double_t hithr,
+		    Double_t& e0, Double_t* qe, Double_t* q0, Double_t* Q,
+		    UInt_t* hitcount, UInt_t nthreads=0);
+
+ private:
+
+  // Partial sums of one thread.
+  struct Sums {
+    UInt_t nev;
+    Double_t e0;
+    vector<Double_t> qe, q0, Q;
+    vector<UInt_t> hitcount;
+  };
+
+  void AccumulateRange(UInt_t first, UInt_t last, const Double_t* alpha,
+		       Double_t lothr, Double_t hithr, Sums* sums);
+
+  UInt_t fNpmts;
+
+  // Track columns.
+  vector<Double_t> fP;       // momentum, GeV
+  vector<Double_t> fX;       // at the calorimeter face
+  vector<Double_t> fXp;
+  vector<Double_t> fY;       // at the calorimeter face
+  vector<Double_t> fYp;
+  vector<Double_t> fDelta;   // momentum deviation, %
+  vector<UInt_t> fFirst;     // first PMT entry of the track
+
+  // PMT columns.
+  vector<UInt_t> fChannel;   // PMT channel, 1 to fNpmts
+  vector<Double_t> fADC;     // pedestal subtracted ADC signal
+  vector<Double_t> fSignal;  // coordinate corrected signal, unit gain
+};
+
+//------------------------------------------------------------------------------
+
+THcCalCalibEngine::THcCalCalibEngine(UInt_t npmts) {
+  fNpmts = npmts;
+};
+
+//------------------------------------------------------------------------------
+
+THcCalCalibEngine::~THcCalCalibEngine() {
+};
+
+//------------------------------------------------------------------------------
+
+void THcCalCalibEngine::Clear() {
+
+  // Empty the cache.
+
+  fP.clear();
+  fX.clear();
+  fXp.clear();
+  fY.clear();
+  fYp.clear();
+  fDelta.clear();
+  fFirst.clear();
+  fChannel.clear();
+  fADC.clear();
+  fSignal.clear();
+};
+
+//------------------------------------------------------------------------------
+
+void THcCalCalibEngine::AddTrack(Double_t p,
+				 Double_t x, Double_t xp, Double_t y, Double_t yp,
+				 Double_t delta) {
+
+  // Add a track. The PMTs added next belong to it.
+
+  fP.push_back(p);
+  fX.push_back(x);
+  fXp.push_back(xp);
+  fY.push_back(y);
+  fYp.push_back(yp);
+  fDelta.push_back(delta);
+  fFirst.push_back(fChannel.size());
+};
+
+//------------------------------------------------------------------------------
+
+void THcCalCalibEngine::AddPMT(UInt_t channel, Double_t adc, Double_t signal) {
+
+  // Add a fired PMT to the last track.
+
+  fChannel.push_back(channel);
+  fADC.push_back(adc);
+  fSignal.push_back(signal);
+};
+
+//------------------------------------------------------------------------------
+
+Double_t THcCalCalibEngine::Enorm(UInt_t it, const Double_t* alpha) {
+
+  // Normalized to the track momentum energy deposition of track it, with
+  // the gains alpha.
+
+  Double_t sum = 0;
+
+  UInt_t last = GetLast(it);
+  for (UInt_t ie=fFirst[it]; ie<last; ie++)
+    sum += fSignal[ie]*alpha[fChannel[ie]-1];
+
+  return sum/fP[it]/1000.;
+}
+
+//------------------------------------------------------------------------------
+
+void THcCalCalibEngine::AccumulateRange(UInt_t first, UInt_t last,
+					const Double_t* alpha,
+					Double_t lothr, Double_t hithr,
+					Sums* sums) {
+
+  // Accumulate the tracks first to last-1 into sums. Tracks are selected
+  // by their normalized energy deposition with the gains alpha; the
+  // vectors and matrix are composed from the unit gain signals.
+
+  sums->nev = 0;
+  sums->e0 = 0.;
+  sums->qe.assign(fNpmts, 0.);
+  sums->q0.assign(fNpmts, 0.);
+  sums->Q.assign(fNpmts*fNpmts, 0.);
+  sums->hitcount.assign(fNpmts, 0);
+
+  Double_t* qe = &sums->qe[0];
+  Double_t* q0 = &sums->q0[0];
+  Double_t* Q = &sums->Q[0];
+  UInt_t* hitcount = &sums->hitcount[0];
+
+  for (UInt_t it=first; it<last; it++) {
+
+    Double_t Enorm = this->Enorm(it, alpha);
+    if (Enorm<=lothr || Enorm>=hithr) continue;
+
+    Double_t P = fP[it]*1000.;     //MeV
+    sums->e0 += P;
+
+    UInt_t ilast = GetLast(it);
+    for (UInt_t i=fFirst[it]; i<ilast; i++) {
+
+      UInt_t ic = fChannel[i]-1;
+      Double_t is = fSignal[i];
+
+      qe[ic] += is*P;
+      q0[ic] += is;
+      hitcount[ic]++;
+
+      // Correlation matrix, symmetric.
+
+      Double_t* Qi = Q + ic*fNpmts;
+      Qi[ic] += is*is;
+      for (UInt_t j=i+1; j<ilast; j++) {
+	UInt_t jc = fChannel[j]-1;
+	Double_t ij = is*fSignal[j];
+	Qi[jc] += ij;
+	Q[jc*fNpmts+ic] += ij;
+      }
+
+    }
+
+    sums->nev++;
+  }
+
+}
+
+//------------------------------------------------------------------------------
+
+UInt_t THcCalCalibEngine::Accumulate(const Double_t* alpha,
+				     Double_t lothr, Double_t hithr,
+				     Double_t& e0, Double_t* qe, Double_t* q0,
+				     Double_t* Q, UInt_t* hitcount,
+				     UInt_t nthreads) {
+
+  // Add the sum of track momenta of the selected tracks to e0, and their
+  // unit gain signals to the vectors qe (signal times momentum) and q0,
+  // the fNpmts x fNpmts correlation matrix Q (row by row) and the hit
+  // counters. Tracks are selected with lothr < Enorm(alpha) < hithr.
+  // Use nthreads threads, or one per core if 0. Returns the number of
+  // selected tracks.
+
+  UInt_t ntracks = GetNtracks();
+
+  if (nthreads == 0) nthreads = thread::hardware_concurrency();
+  if (nthreads == 0) nthreads = 1;
+  if (nthreads > ntracks) nthreads = TMath::Max(ntracks, 1U);
+
+  vector<Sums> sums(nthreads);
+
+  if (nthreads == 1)
+    AccumulateRange(0, ntracks, alpha, lothr, hithr, &sums[0]);
+  else {
+    vector<thread> workers;
+    for (UInt_t k=0; k<nthreads; k++) {
+      UInt_t first = (UInt_t)((ULong64_t)ntracks*k/nthreads);
+      UInt_t last = (UInt_t)((ULong64_t)ntracks*(k+1)/nthreads);
+      workers.push_back(thread(&THcCalCalibEngine::AccumulateRange, this,
+			       first, last, alpha, lothr, hithr, &sums[k]));
+    }
+    for (UInt_t k=0; k<nthreads; k++) workers[k].join();
+  }
+
+  // Reduce the partial sums, in thread order so that the result does not
+  // depend on the scheduling.
+
+  UInt_t nev = 0;
+
+  for (UInt_t k=0; k<nthreads; k++) {
+    nev += sums[k].nev;
+    e0 += sums[k].e0;
+    for (UInt_t i=0; i<fNpmts; i++) {
+      qe[i] += sums[k].qe[i];
+      q0[i] += sums[k].q0[i];
+      hitcount[i] += sums[k].hitcount[i];
+    }
+    for (UInt_t i=0; i<fNpmts*fNpmts; i++)
+      Q[i] += sums[k].Q[i];
+  }
+
+  return nev;
+}
+
+#endif
@@ -96,6 +96,7 @@ void THcShTrack::Reset(Double_t p,
   Xp = xp;
   Y = y;
   Yp =yp;
+  for (THcShHitIt i = Hits.begin(); i != Hits.end(); ++i) delete *i;
   Hits.clear();
 };
 
@@ -2,6 +2,7 @@
 #define ROOT_THcShowerCalib
 
 #include "THcShTrack.h"
+#include "../THcCalCalibEngine.h"
 #include "TH1F.h"
 #include "TH2F.h"
 #include "TVectorD.h"
@@ -32,7 +33,7 @@ class THcShowerCalib {
   ~THcShowerCalib();
 
   void Init();
-  void ReadShRawTrack(THcShTrack &trk, UInt_t ientry);
+  void ReadShRawTracks();
   void CalcThresholds();
   void ComposeVMs();
   void SolveAlphas();
@@ -40,6 +41,8 @@ class THcShowerCalib {
   void SaveAlphas();
   void SaveRawData();
 
+  void SetNthreads(UInt_t n) {fNthreads = n;}   // 0: one per core
+
   TH1F* hEunc;
   TH1F* hEuncSel;
   TH1F* hEcal;
@@ -55,6 +58,9 @@ class THcShowerCalib {
 
   TTree* fTree;
   UInt_t fNentries;
+  UInt_t fNthreads;    // Number of threads to compose the matrix with.
+
+  THcCalCalibEngine fEngine;   // Cached tracks.
 
   // Quantities for calculations of the calibration constants.
 
@@ -73,12 +79,16 @@ class THcShowerCalib {
 
 //------------------------------------------------------------------------------
 
-THcShowerCalib::THcShowerCalib() {};
+THcShowerCalib::THcShowerCalib() : fEngine(THcShTrack::fNpmts) {
+  fNthreads = 0;
+};
 
 //------------------------------------------------------------------------------
 
-THcShowerCalib::THcShowerCalib(Int_t RunNumber) {
+THcShowerCalib::THcShowerCalib(Int_t RunNumber) :
+  fEngine(THcShTrack::fNpmts) {
   fRunNumber = RunNumber;
+  fNthreads = 0;
 };
 
 //------------------------------------------------------------------------------
@@ -100,8 +110,23 @@ void THcShowerCalib::SaveRawData() {
 
   THcShTrack trk;
 
-  for (UInt_t ientry=0; ientry<fNentries; ientry++) {
-    ReadShRawTrack(trk, ientry);
+  for (UInt_t it=0; it<fEngine.GetNtracks(); it++) {
+
+    // Rebuild the track from the cache. The negative side PMT of a block
+    // follows its positive side PMT.
+
+    trk.Reset(fEngine.GetP(it), fEngine.GetX(it), fEngine.GetXp(it),
+	      fEngine.GetY(it), fEngine.GetYp(it));
+
+    UInt_t last = fEngine.GetLast(it);
+    for (UInt_t ie=fEngine.GetFirst(it); ie<last; ie++) {
+      UInt_t nb = fEngine.GetChannel(ie);
+      Double_t adc_pos = fEngine.GetADC(ie);
+      Double_t adc_neg = 0.;
+      if (nb <= THcShTrack::fNnegs) adc_neg = fEngine.GetADC(++ie);
+      trk.AddHit(adc_pos, adc_neg, 0., 0., nb);
+    }
+
     trk.SetEs(falphaC);
     trk.Print(fout);
   }
@@ -168,6 +193,10 @@ void THcShowerCalib::Init() {
     falpha1[ipmt] = 1.;
   }
 
+  // Read in the tracks.
+
+  ReadShRawTracks();
+
 };
 
 //------------------------------------------------------------------------------
@@ -182,17 +211,11 @@ void THcShowerCalib::CalcThresholds() {
   // histogram, establish +/-3 * RMS thresholds.
 
   Int_t nev = 0;
-  THcShTrack trk;
-
-  for (UInt_t ientry=0; ientry<fNentries; ientry++) {
-
-    ReadShRawTrack(trk, ientry);
 
-    //    trk.Print(cout);
-    //    getchar();
+  for (UInt_t it=0; it<fEngine.GetNtracks(); it++) {
 
-    trk.SetEs(falpha0);             //Use initial gain constants here.
-    Double_t Enorm = trk.Enorm();
+    //Use initial gain constants here.
+    Double_t Enorm = fEngine.Enorm(it, falpha0);
 
     nev++;
     //    cout << "CalcThreshods: nev=" << nev << "  Enorm=" << Enorm << endl;
@@ -228,10 +251,11 @@ void THcShowerCalib::CalcThresholds() {
 
 //------------------------------------------------------------------------------
 
-void THcShowerCalib::ReadShRawTrack(THcShTrack &trk, UInt_t ientry) {
+void THcShowerCalib::ReadShRawTracks() {
 
   //
-  // Set a Shower track event from ntuple ientry.
+  // Read the Shower track events from the ntuple into the cache, in one
+  // pass over the tree.
   //
 
   // Declaration of leaves types
@@ -257,6 +281,7 @@ void THcShowerCalib::ReadShRawTrack(THcShTrack &trk, UInt_t ientry) {
   Double_t        H_tr_xp;
   Double_t        H_tr_y;   //Y FP
   Double_t        H_tr_yp;
+  Double_t        H_tr_tg_dp;
 
   // Set branch addresses.
 
@@ -277,140 +302,96 @@ void THcShowerCalib::ReadShRawTrack(THcShTrack &trk, UInt_t ientry) {
   fTree->SetBranchAddress("H.tr.th",&H_tr_xp);
   fTree->SetBranchAddress("H.tr.ph",&H_tr_yp);
   fTree->SetBranchAddress("H.tr.p",&H_tr_p);
+  fTree->SetBranchAddress("H.tr.tg_dp",&H_tr_tg_dp);
 
-  fTree->GetEntry(ientry);
-
-  trk.Reset(H_tr_p, H_tr_x+D_CALO_FP*H_tr_xp, H_tr_xp,
-	    H_tr_y+D_CALO_FP*H_tr_yp, H_tr_yp);
-
-  for (UInt_t j=0; j<THcShTrack::fNrows; j++) {
-    for (UInt_t k=0; k<THcShTrack::fNcols; k++) {
-
-      Double_t adc_pos, adc_neg;
-
-      switch (k) {
-      case 0 : 
-	adc_pos = H_cal_1pr_apos_p[j];
-	adc_neg = H_cal_1pr_aneg_p[j];
-	break;
-      case 1 : 
-	adc_pos = H_cal_2ta_apos_p[j];
-	adc_neg = H_cal_2ta_aneg_p[j];
-	break;
-      case 2 : 
-	adc_pos = H_cal_3ta_apos_p[j];
-	adc_neg = H_cal_3ta_aneg_p[j];
-	break;
-      case 3 : 
-	adc_pos = H_cal_4ta_apos_p[j];
-	adc_neg = H_cal_4ta_aneg_p[j];
-	break;
-      default:
-	cout << "*** ReadShRawTrack: column number k=" << k
-	     << " out of range! ***" << endl;
-      };
-
-      UInt_t nb = j+1 + k*THcShTrack::fNrows;
-
-      if (adc_pos>0. || adc_neg>0.) {
-	trk.AddHit(adc_pos, adc_neg, 0., 0., nb);
-      }
-
-    }
-  }
-
-}
-
-//------------------------------------------------------------------------------
-
-void THcShowerCalib::ComposeVMs() {
-
-  //
-  // Fill in vectors and matrixes for the gain constant calculations.
-  //
-
-  fNev = 0;
+  fEngine.Clear();
   THcShTrack trk;
 
-  // Loop over the shower track events in the ntuples.
-
   for (UInt_t ientry=0; ientry<fNentries; ientry++) {
 
-    ReadShRawTrack(trk, ientry);
-
-    // Set energy depositions with default gains.
-    // Calculate normalized to the track momentum total energy deposition,
-    // check it against the thresholds.
-
-    trk.SetEs(falpha0);
-    Double_t Enorm = trk.Enorm();
-    if (Enorm>fLoThr && Enorm<fHiThr) {
-
-      trk.SetEs(falpha1);   // Set energies with unit gains for now.
-      // trk.Print(cout);
-
-      fe0 += trk.GetP();    // Accumulate track momenta.
-
-      vector<pmt_hit> pmt_hit_list;     // Container to save PMT hits
-
-      // Loop over hits.
-
-      for (UInt_t i=0; i<trk.GetNhits(); i++) {
-
-	THcShHit* hit = trk.GetHit(i);
-	// hit->Print(cout);
-
-	UInt_t nb = hit->GetBlkNumber();
-
-	// Fill the qe and q0 vectors (for positive side PMT).
+    fTree->GetEntry(ientry);
+
+    trk.Reset(H_tr_p, H_tr_x+D_CALO_FP*H_tr_xp, H_tr_xp,
+	      H_tr_y+D_CALO_FP*H_tr_yp, H_tr_yp);
+
+    for (UInt_t j=0; j<THcShTrack::fNrows; j++) {
+      for (UInt_t k=0; k<THcShTrack::fNcols; k++) {
+
+	Double_t adc_pos, adc_neg;
+
+	switch (k) {
+	case 0 : 
+	  adc_pos = H_cal_1pr_apos_p[j];
+	  adc_neg = H_cal_1pr_aneg_p[j];
+	  break;
+	case 1 : 
+	  adc_pos = H_cal_2ta_apos_p[j];
+	  adc_neg = H_cal_2ta_aneg_p[j];
+	  break;
+	case 2 : 
+	  adc_pos = H_cal_3ta_apos_p[j];
+	  adc_neg = H_cal_3ta_aneg_p[j];
+	  break;
+	case 3 : 
+	  adc_pos = H_cal_4ta_apos_p[j];
+	  adc_neg = H_cal_4ta_aneg_p[j];
+	  break;
+	default:
+	  cout << "*** ReadShRawTracks: column number k=" << k
+	       << " out of range! ***" << endl;
+	};
 
-	fqe[nb-1] += hit->GetEpos() * trk.GetP();
-	fq0[nb-1] += hit->GetEpos();
+	UInt_t nb = j+1 + k*THcShTrack::fNrows;
 
-	// Save the PMT hit.
+	if (adc_pos>0. || adc_neg>0.) {
+	  trk.AddHit(adc_pos, adc_neg, 0., 0., nb);
+	}
 
-	pmt_hit_list.push_back( pmt_hit{hit->GetEpos(), nb} );
+      }
+    }
 
-	fHitCount[nb-1]++;   //Accrue the hit counter.
+    // Cache the track with the unit gain energy depositions of its PMTs,
+    // the negative side PMT of a block after the positive side one.
 
-	// Do same for the negative side PMTs.
+    trk.SetEs(falpha1);
 
-	if (nb <= THcShTrack::fNnegs) {
-	  fqe[THcShTrack::fNblks+nb-1] += hit->GetEneg() * trk.GetP();
-	  fq0[THcShTrack::fNblks+nb-1] += hit->GetEneg();
+    fEngine.AddTrack(H_tr_p, H_tr_x+D_CALO_FP*H_tr_xp, H_tr_xp,
+		     H_tr_y+D_CALO_FP*H_tr_yp, H_tr_yp, H_tr_tg_dp);
 
-	  pmt_hit_list.push_back(pmt_hit{hit->GetEneg(),
-		THcShTrack::fNblks+nb} );
+    for (UInt_t i=0; i<trk.GetNhits(); i++) {
 
-	  fHitCount[THcShTrack::fNblks+nb-1]++;
-	};
+      THcShHit* hit = trk.GetHit(i);
+      UInt_t nb = hit->GetBlkNumber();
 
-      }      //over hits
+      fEngine.AddPMT(nb, hit->GetADCpos(), hit->GetEpos());
 
-      // Fill in the correlation matrix Q by retrieving the PMT hits.
+      if (nb <= THcShTrack::fNnegs)
+	fEngine.AddPMT(THcShTrack::fNblks+nb, hit->GetADCneg(), hit->GetEneg());
+    }
 
-      for (vector<pmt_hit>::iterator i=pmt_hit_list.begin();
-	   i < pmt_hit_list.end(); i++) {
+  }
 
-	UInt_t ic = (*i).channel;
-	Double_t is = (*i).signal;
+  fTree->ResetBranchAddresses();
 
-	for (vector<pmt_hit>::iterator j=i;
-	     j < pmt_hit_list.end(); j++) {
+  cout << "ReadShRawTracks: " << fEngine.GetNtracks() << " tracks, "
+       << fEngine.GetNPMTs() << " PMT hits cached" << endl;
+}
 
-	  UInt_t jc = (*j).channel;
-	  Double_t js = (*j).signal;
+//------------------------------------------------------------------------------
 
-	  fQ[ic-1][jc-1] += is*js;
-	  if (jc != ic) fQ[jc-1][ic-1] += is*js;
-	}
-      }
+void THcShowerCalib::ComposeVMs() {
 
-      fNev++;
+  //
+  // Fill in vectors and matrixes for the gain constant calculations.
+  //
 
-    };   // if within the thresholds
+  // Loop over the cached shower tracks. Select tracks by the normalized
+  // to the track momentum total energy deposition with default gains,
+  // and accumulate the vectors and the correlation matrix of the unit
+  // gain energy depositions, in fNthreads threads.
 
-  };     // over entries
+  fNev = fEngine.Accumulate(falpha0, fLoThr, fHiThr,
+			    fe0, fqe, fq0, &fQ[0][0], fHitCount, fNthreads);
 
   // Take averages.
 
@@ -612,21 +593,15 @@ void THcShowerCalib::FillHEcal() {
 
   Int_t nev = 0;
 
-  THcShTrack trk;
-
-  for (UInt_t ientry=0; ientry<fNentries; ientry++) {
-
-    ReadShRawTrack(trk, ientry);
-    //    trk.Print(cout);
+  for (UInt_t it=0; it<fEngine.GetNtracks(); it++) {
 
-    trk.SetEs(falphaC);          // use the 'constrained' calibration constants
-    Double_t P = trk.GetP();
-    Double_t Enorm = trk.Enorm();
+    // use the 'constrained' calibration constants
+    Double_t P = fEngine.GetP(it)*1000.;
+    Double_t Enorm = fEngine.Enorm(it, falphaC);
 
     hEcal->Fill(Enorm);
 
-    Double_t delta;
-    fTree->SetBranchAddress("H.tr.tg_dp",&delta);
+    Double_t delta = fEngine.GetDelta(it);
     hDPvsEcal->Fill(Enorm,delta,1.);
 
     output << Enorm*P/1000. << " " << P/1000. << endl;
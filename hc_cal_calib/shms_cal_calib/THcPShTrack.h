@@ -95,6 +95,7 @@ void THcPShTrack::Reset(Double_t p,
   Xp = xp;
   Y = y;
   Yp =yp;
+  for (THcPShHitIt i = Hits.begin(); i != Hits.end(); ++i) delete *i;
   Hits.clear();
 };
 
@@ -2,6 +2,7 @@
 #define ROOT_THcPShowerCalib
 
 #include "THcPShTrack.h"
+#include "../THcCalCalibEngine.h"
 #include "TH1F.h"
 #include "TH2F.h"
 #include "TVectorD.h"
@@ -33,7 +34,7 @@ class THcPShowerCalib {
   ~THcPShowerCalib();
 
   void Init();
-  void ReadShRawTrack(THcPShTrack &trk, UInt_t ientry);
+  void ReadShRawTracks();
   void CalcThresholds();
   void ComposeVMs();
   void SolveAlphas();
@@ -41,6 +42,8 @@ class THcPShowerCalib {
   void SaveAlphas();
   void SaveRawData();
 
+  void SetNthreads(UInt_t n) {fNthreads = n;}   // 0: one per core
+
   TH1F* hEunc;
   TH1F* hEuncSel;
   TH1F* hEcal;
@@ -58,6 +61,9 @@ class THcPShowerCalib {
 
   TTree* fTree;
   UInt_t fNentries;
+  UInt_t fNthreads;    // Number of threads to compose the matrix with.
+
+  THcCalCalibEngine fEngine;   // Cached tracks.
 
   // Quantities for calculations of the calibration constants.
 
@@ -76,12 +82,16 @@ class THcPShowerCalib {
 
 //------------------------------------------------------------------------------
 
-THcPShowerCalib::THcPShowerCalib() {};
+THcPShowerCalib::THcPShowerCalib() : fEngine(THcPShTrack::fNpmts) {
+  fNthreads = 0;
+};
 
 //------------------------------------------------------------------------------
 
-THcPShowerCalib::THcPShowerCalib(Int_t RunNumber) {
+THcPShowerCalib::THcPShowerCalib(Int_t RunNumber) :
+  fEngine(THcPShTrack::fNpmts) {
   fRunNumber = RunNumber;
+  fNthreads = 0;
 };
 
 //------------------------------------------------------------------------------
@@ -103,8 +113,17 @@ void THcPShowerCalib::SaveRawData() {
 
   THcPShTrack trk;
 
-  for (UInt_t ientry=0; ientry<fNentries; ientry++) {
-    ReadShRawTrack(trk, ientry);
+  for (UInt_t it=0; it<fEngine.GetNtracks(); it++) {
+
+    // Rebuild the track from the cache.
+
+    trk.Reset(fEngine.GetP(it), fEngine.GetX(it), fEngine.GetXp(it),
+	      fEngine.GetY(it), fEngine.GetYp(it));
+
+    UInt_t last = fEngine.GetLast(it);
+    for (UInt_t ie=fEngine.GetFirst(it); ie<last; ie++)
+      trk.AddHit(fEngine.GetADC(ie), 0., fEngine.GetChannel(ie));
+
     trk.SetEs(falphaC);
     trk.Print(fout);
   }
@@ -165,6 +184,10 @@ void THcPShowerCalib::Init() {
     falpha1[ipmt] = 1.;
   }
 
+  // Read in the tracks.
+
+  ReadShRawTracks();
+
 };
 
 //------------------------------------------------------------------------------
@@ -179,17 +202,11 @@ void THcPShowerCalib::CalcThresholds() {
   // histogram, establish +/-3 * RMS thresholds.
 
   Int_t nev = 0;
-  THcPShTrack trk;
-
-  for (UInt_t ientry=0; ientry<fNentries; ientry++) {
 
-    ReadShRawTrack(trk, ientry);
+  for (UInt_t it=0; it<fEngine.GetNtracks(); it++) {
 
-    //    trk.Print(cout);
-    //    getchar();
-
-    trk.SetEs(falpha0);             //Use initial gain constants here.
-    Double_t Enorm = trk.Enorm();
+    //Use initial gain constants here.
+    Double_t Enorm = fEngine.Enorm(it, falpha0);
 
     nev++;
     //    cout << "CalcThreshods: nev=" << nev << "  Enorm=" << Enorm << endl;
@@ -227,10 +244,11 @@ void THcPShowerCalib::CalcThresholds() {
 
 //------------------------------------------------------------------------------
 
-void THcPShowerCalib::ReadShRawTrack(THcPShTrack &trk, UInt_t ientry) {
+void THcPShowerCalib::ReadShRawTracks() {
 
   //
-  // Set a Shower track event from ntuple ientry.
+  // Read the Shower track events from the ntuple into the cache, in one
+  // pass over the tree.
   //
 
   // Declaration of leaves types
@@ -247,6 +265,7 @@ void THcPShowerCalib::ReadShRawTrack(THcPShTrack &trk, UInt_t ientry) {
   Double_t        P_tr_xp;
   Double_t        P_tr_y;   //Y FP
   Double_t        P_tr_yp;
+  Double_t        P_tr_tg_dp;
 
   const Double_t adc_thr = 15.;   //Low threshold on the ADC signals.
 
@@ -260,124 +279,85 @@ void THcPShowerCalib::ReadShRawTrack(THcPShTrack &trk, UInt_t ientry) {
   fTree->SetBranchAddress("P.tr.th",&P_tr_xp);
   fTree->SetBranchAddress("P.tr.ph",&P_tr_yp);
   fTree->SetBranchAddress("P.tr.p", &P_tr_p);
+  fTree->SetBranchAddress("P.tr.tg_dp",&P_tr_tg_dp);
 
-  fTree->GetEntry(ientry);
-
-  // Set track coordinates and slopes at the face of Preshower.
-
-  trk.Reset(P_tr_p, P_tr_x+D_CALO_FP*P_tr_xp, P_tr_xp,
-  	    P_tr_y+D_CALO_FP*P_tr_yp, P_tr_yp);
-
-  // Set Preshower hits.
-
-  for (UInt_t k=0; k<THcPShTrack::fNcols_pr; k++) {
-    for (UInt_t j=0; j<THcPShTrack::fNrows_pr; j++) {
-
-      Double_t adc = P_pr_a_p[j][k];
-
-      if (adc > adc_thr) {
-	UInt_t nb = j+1 + k*THcPShTrack::fNrows_pr;
-	trk.AddHit(adc, 0., nb);
-      }
-
-    }
-  }
-
-  // Set Shower hits.
-
-  for (UInt_t k=0; k<THcPShTrack::fNcols_sh; k++) {
-    for (UInt_t j=0; j<THcPShTrack::fNrows_sh; j++) {
-
-      Double_t adc = P_sh_a_p[j][k];
-
-      if (adc > adc_thr) {
-	UInt_t nb = THcPShTrack::fNpmts_pr + j+1 + k*THcPShTrack::fNrows_sh;
-	trk.AddHit(adc, 0., nb);
-      }
-
-    }
-  }
-
-}
-
-//------------------------------------------------------------------------------
-
-void THcPShowerCalib::ComposeVMs() {
-
-  //
-  // Fill in vectors and matrixes for the gain constant calculations.
-  //
-
-  fNev = 0;
+  fEngine.Clear();
   THcPShTrack trk;
 
-  // Loop over the shower track events in the ntuples.
-
   for (UInt_t ientry=0; ientry<fNentries; ientry++) {
 
-    ReadShRawTrack(trk, ientry);
+    fTree->GetEntry(ientry);
 
-    // Set energy depositions with default gains.
-    // Calculate normalized to the track momentum total energy deposition,
-    // check it against the thresholds.
+    // Set track coordinates and slopes at the face of Preshower.
 
-    trk.SetEs(falpha0);
-    Double_t Enorm = trk.Enorm();
-    if (Enorm>fLoThr && Enorm<fHiThr) {
+    trk.Reset(P_tr_p, P_tr_x+D_CALO_FP*P_tr_xp, P_tr_xp,
+	      P_tr_y+D_CALO_FP*P_tr_yp, P_tr_yp);
 
-      trk.SetEs(falpha1);   // Set energies with unit gains for now.
-      // trk.Print(cout);
+    // Set Preshower hits.
 
-      fe0 += trk.GetP();    // Accumulate track momenta.
+    for (UInt_t k=0; k<THcPShTrack::fNcols_pr; k++) {
+      for (UInt_t j=0; j<THcPShTrack::fNrows_pr; j++) {
 
-      vector<pmt_hit> pmt_hit_list;     // Container to save PMT hits
+	Double_t adc = P_pr_a_p[j][k];
 
-      // Loop over hits.
+	if (adc > adc_thr) {
+	  UInt_t nb = j+1 + k*THcPShTrack::fNrows_pr;
+	  trk.AddHit(adc, 0., nb);
+	}
 
-      for (UInt_t i=0; i<trk.GetNhits(); i++) {
+      }
+    }
 
-	THcPShHit* hit = trk.GetHit(i);
-	// hit->Print(cout);
+    // Set Shower hits.
 
-	UInt_t nb = hit->GetBlkNumber();
+    for (UInt_t k=0; k<THcPShTrack::fNcols_sh; k++) {
+      for (UInt_t j=0; j<THcPShTrack::fNrows_sh; j++) {
 
-	// Fill the qe and q0 vectors.
+	Double_t adc = P_sh_a_p[j][k];
 
-	fqe[nb-1] += hit->GetEdep() * trk.GetP();
-	fq0[nb-1] += hit->GetEdep();
+	if (adc > adc_thr) {
+	  UInt_t nb = THcPShTrack::fNpmts_pr + j+1 + k*THcPShTrack::fNrows_sh;
+	  trk.AddHit(adc, 0., nb);
+	}
 
-	// Save the PMT hit.
+      }
+    }
 
-	pmt_hit_list.push_back( pmt_hit{hit->GetEdep(), nb} );
+    // Cache the track with the unit gain energy depositions of its PMTs.
 
-	fHitCount[nb-1]++;   //Accrue the hit counter.
+    trk.SetEs(falpha1);
 
-      }      //over hits
+    fEngine.AddTrack(P_tr_p, P_tr_x+D_CALO_FP*P_tr_xp, P_tr_xp,
+		     P_tr_y+D_CALO_FP*P_tr_yp, P_tr_yp, P_tr_tg_dp);
 
-      // Fill in the correlation matrix Q by retrieving the PMT hits.
+    for (UInt_t i=0; i<trk.GetNhits(); i++) {
+      THcPShHit* hit = trk.GetHit(i);
+      fEngine.AddPMT(hit->GetBlkNumber(), hit->GetADC(), hit->GetEdep());
+    }
 
-      for (vector<pmt_hit>::iterator i=pmt_hit_list.begin();
-	   i < pmt_hit_list.end(); i++) {
+  }
 
-	UInt_t ic = (*i).channel;
-	Double_t is = (*i).signal;
+  fTree->ResetBranchAddresses();
 
-	for (vector<pmt_hit>::iterator j=i;
-	     j < pmt_hit_list.end(); j++) {
+  cout << "ReadShRawTracks: " << fEngine.GetNtracks() << " tracks, "
+       << fEngine.GetNPMTs() << " PMT hits cached" << endl;
+}
 
-	  UInt_t jc = (*j).channel;
-	  Double_t js = (*j).signal;
+//------------------------------------------------------------------------------
 
-	  fQ[ic-1][jc-1] += is*js;
-	  if (jc != ic) fQ[jc-1][ic-1] += is*js;
-	}
-      }
+void THcPShowerCalib::ComposeVMs() {
 
-      fNev++;
+  //
+  // Fill in vectors and matrixes for the gain constant calculations.
+  //
 
-    };   // if within the thresholds
+  // Loop over the cached shower tracks. Select tracks by the normalized
+  // to the track momentum total energy deposition with default gains,
+  // and accumulate the vectors and the correlation matrix of the unit
+  // gain energy depositions, in fNthreads threads.
 
-  };     // over entries
+  fNev = fEngine.Accumulate(falpha0, fLoThr, fHiThr,
+			    fe0, fqe, fq0, &fQ[0][0], fHitCount, fNthreads);
 
   // Take averages.
 
@@ -576,25 +556,19 @@ void THcPShowerCalib::FillHEcal() {
 
   Int_t nev = 0;
 
-  THcPShTrack trk;
-
-  for (UInt_t ientry=0; ientry<fNentries; ientry++) {
-
-    ReadShRawTrack(trk, ientry);
-    //    trk.Print(cout);
+  for (UInt_t it=0; it<fEngine.GetNtracks(); it++) {
 
-    trk.SetEs(falphaC);          // use the 'constrained' calibration constants
-    Double_t P = trk.GetP();
-    Double_t Enorm = trk.Enorm();
+    // use the 'constrained' calibration constants
+    Double_t P = fEngine.GetP(it)*1000.;
+    Double_t Enorm = fEngine.Enorm(it, falphaC);
 
     hEcal->Fill(Enorm);
 
-    Double_t delta;
-    fTree->SetBranchAddress("P.tr.tg_dp",&delta);
+    Double_t delta = fEngine.GetDelta(it);
     hDPvsEcal->Fill(Enorm,delta,1.);
 
-    output << Enorm*P/1000. << " " << P/1000. << " " << trk.GetX() << " "
-	   << trk.GetY() << endl;
+    output << Enorm*P/1000. << " " << P/1000. << " " << fEngine.GetX(it) << " "
+	   << fEngine.GetY(it) << endl;
 
     nev++;
   };
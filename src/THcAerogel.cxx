@@ -9,6 +9,7 @@
 #include "THcHodoscope.h"
 #include "TClonesArray.h"
 #include "THcSignalHit.h"
+#include "THcSignalTable.h"
 #include "THaEvData.h"
 #include "THaDetMap.h"
 #include "THcDetectorMap.h"
@@ -39,13 +40,7 @@ THcAerogel::THcAerogel( const char* name, const char* description,
   THaNonTrackingDetector(name,description,apparatus), fPresentP(0),
   fAdcPosTimeWindowMin(0), fAdcPosTimeWindowMax(0), fAdcNegTimeWindowMin(0),
   fAdcNegTimeWindowMax(0), fRegionValue(0), fPosGain(0), fNegGain(0),
-  frPosAdcPedRaw(0), frPosAdcPulseIntRaw(0), frPosAdcPulseAmpRaw(0),
-  frPosAdcPulseTimeRaw(0), frPosAdcPed(0), frPosAdcPulseInt(0),
-  frPosAdcPulseAmp(0), frPosAdcPulseTime(0), frNegAdcPedRaw(0),
-  frNegAdcPulseIntRaw(0), frNegAdcPulseAmpRaw(0), frNegAdcPulseTimeRaw(0),
-  frNegAdcPed(0), frNegAdcPulseInt(0), frNegAdcPulseAmp(0),
-  frNegAdcPulseTime(0), fPosAdcErrorFlag(0),
-  fNegAdcErrorFlag(0), fPosPedSum(0), fPosPedSum2(0), fPosPedLimit(0),
+  frPosAdc(0), frNegAdc(0), fPosPedSum(0), fPosPedSum2(0), fPosPedLimit(0),
   fPosPedCount(0), fNegPedSum(0), fNegPedSum2(0), fNegPedLimit(0), fNegPedCount(0),
   fA_Pos(0), fA_Neg(0), fA_Pos_p(0), fA_Neg_p(0), fT_Pos(0), fT_Neg(0),
   fPosPed(0), fPosSig(0), fPosThresh(0), fNegPed(0), fNegSig(0),
@@ -59,13 +54,7 @@ THcAerogel::THcAerogel( ) :
   THaNonTrackingDetector(),
   fAdcPosTimeWindowMin(0), fAdcPosTimeWindowMax(0), fAdcNegTimeWindowMin(0),
   fAdcNegTimeWindowMax(0), fRegionValue(0), fPosGain(0), fNegGain(0),
-  frPosAdcPedRaw(0), frPosAdcPulseIntRaw(0), frPosAdcPulseAmpRaw(0),
-  frPosAdcPulseTimeRaw(0), frPosAdcPed(0), frPosAdcPulseInt(0),
-  frPosAdcPulseAmp(0), frPosAdcPulseTime(0), frNegAdcPedRaw(0),
-  frNegAdcPulseIntRaw(0), frNegAdcPulseAmpRaw(0), frNegAdcPulseTimeRaw(0),
-  frNegAdcPed(0), frNegAdcPulseInt(0), frNegAdcPulseAmp(0),
-  frNegAdcPulseTime(0), fPosAdcErrorFlag(0),
-  fNegAdcErrorFlag(0), fPosPedSum(0), fPosPedSum2(0), fPosPedLimit(0),
+  frPosAdc(0), frNegAdc(0), fPosPedSum(0), fPosPedSum2(0), fPosPedLimit(0),
   fPosPedCount(0), fNegPedSum(0), fNegPedSum2(0), fNegPedLimit(0), fNegPedCount(0),
   fA_Pos(0), fA_Neg(0), fA_Pos_p(0), fA_Neg_p(0), fT_Pos(0), fT_Neg(0),
   fPosPed(0), fPosSig(0), fPosThresh(0), fNegPed(0), fNegSig(0),
@@ -86,24 +75,8 @@ void THcAerogel::DeleteArrays()
 {
   // Delete all dynamically allocated memory
 
-  delete frPosAdcPedRaw;       frPosAdcPedRaw       = NULL;
-  delete frPosAdcPulseIntRaw;  frPosAdcPulseIntRaw  = NULL;
-  delete frPosAdcPulseAmpRaw;  frPosAdcPulseAmpRaw  = NULL;
-  delete frPosAdcPulseTimeRaw; frPosAdcPulseTimeRaw = NULL;
-  delete frPosAdcPed;          frPosAdcPed          = NULL;
-  delete frPosAdcPulseInt;     frPosAdcPulseInt     = NULL;
-  delete frPosAdcPulseAmp;     frPosAdcPulseAmp     = NULL;
-  delete frPosAdcPulseTime;    frPosAdcPulseTime    = NULL;
-  delete frNegAdcPedRaw;       frNegAdcPedRaw       = NULL;
-  delete frNegAdcPulseIntRaw;  frNegAdcPulseIntRaw  = NULL;
-  delete frNegAdcPulseAmpRaw;  frNegAdcPulseAmpRaw  = NULL;
-  delete frNegAdcPulseTimeRaw; frNegAdcPulseTimeRaw = NULL;
-  delete frNegAdcPed;          frNegAdcPed          = NULL;
-  delete frNegAdcPulseInt;     frNegAdcPulseInt     = NULL;
-  delete frNegAdcPulseAmp;     frNegAdcPulseAmp     = NULL;
-  delete frNegAdcPulseTime;    frNegAdcPulseTime    = NULL;
-  delete fPosAdcErrorFlag;     fPosAdcErrorFlag     = NULL;
-  delete fNegAdcErrorFlag;     fNegAdcErrorFlag     = NULL;
+  delete frPosAdc; frPosAdc = NULL;
+  delete frNegAdc; frNegAdc = NULL;
 
   delete [] fRegionValue;         fRegionValue = 0;
   delete [] fAdcPosTimeWindowMin; fAdcPosTimeWindowMin = 0;
@@ -235,24 +208,8 @@ Int_t THcAerogel::ReadDatabase( const TDatime& date )
   fT_Neg       = new Float_t[fNelem];
 
   // Normal constructor with name and description
-  frPosAdcPedRaw       = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frPosAdcPulseIntRaw  = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frPosAdcPulseAmpRaw  = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frPosAdcPulseTimeRaw = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frPosAdcPed          = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frPosAdcPulseInt     = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frPosAdcPulseAmp     = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frPosAdcPulseTime    = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frNegAdcPedRaw       = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frNegAdcPulseIntRaw  = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frNegAdcPulseAmpRaw  = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frNegAdcPulseTimeRaw = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frNegAdcPed          = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frNegAdcPulseInt     = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frNegAdcPulseAmp     = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frNegAdcPulseTime    = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  fPosAdcErrorFlag     = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  fNegAdcErrorFlag     = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
+  frPosAdc = new THcSignalTable(THcSignalTable::kAdcSignals, fNelem*MaxNumAdcPulse);
+  frNegAdc = new THcSignalTable(THcSignalTable::kAdcSignals, fNelem*MaxNumAdcPulse);
 
   fNumPosAdcHits.assign(fNelem, 0);
   fNumGoodPosAdcHits.assign(fNelem, 0);
@@ -394,27 +351,34 @@ Int_t THcAerogel::DefineVariables( EMode mode )
       {"numNegAdcHits",        "Number of Negative ADC Hits Per PMT",      "fNumNegAdcHits"},        // Aerogel occupancy
       {"totNumNegAdcHits",     "Total Number of Negative ADC Hits",        "fTotNumNegAdcHits"},     // Aerogel multiplicity
       {"totnumAdcHits",       "Total Number of ADC Hits Per PMT",          "fTotNumAdcHits"},        // Aerogel multiplicity
-
-      {"posAdcPedRaw",       "Positive Raw ADC pedestals",        "frPosAdcPedRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseIntRaw",  "Positive Raw ADC pulse integrals",  "frPosAdcPulseIntRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseAmpRaw",  "Positive Raw ADC pulse amplitudes", "frPosAdcPulseAmpRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseTimeRaw", "Positive Raw ADC pulse times",      "frPosAdcPulseTimeRaw.THcSignalHit.GetData()"},
-      {"posAdcPed",          "Positive ADC pedestals",            "frPosAdcPed.THcSignalHit.GetData()"},
-      {"posAdcPulseInt",     "Positive ADC pulse integrals",      "frPosAdcPulseInt.THcSignalHit.GetData()"},
-      {"posAdcPulseAmp",     "Positive ADC pulse amplitudes",     "frPosAdcPulseAmp.THcSignalHit.GetData()"},
-      {"posAdcPulseTime",    "Positive ADC pulse times",          "frPosAdcPulseTime.THcSignalHit.GetData()"},
-
-      {"negAdcPedRaw",       "Negative Raw ADC pedestals",        "frNegAdcPedRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseIntRaw",  "Negative Raw ADC pulse integrals",  "frNegAdcPulseIntRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseAmpRaw",  "Negative Raw ADC pulse amplitudes", "frNegAdcPulseAmpRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseTimeRaw", "Negative Raw ADC pulse times",      "frNegAdcPulseTimeRaw.THcSignalHit.GetData()"},
-      {"negAdcPed",          "Negative ADC pedestals",            "frNegAdcPed.THcSignalHit.GetData()"},
-      {"negAdcPulseInt",     "Negative ADC pulse integrals",      "frNegAdcPulseInt.THcSignalHit.GetData()"},
-      {"negAdcPulseAmp",     "Negative ADC pulse amplitudes",     "frNegAdcPulseAmp.THcSignalHit.GetData()"},
-      {"negAdcPulseTime",    "Negative ADC pulse times",          "frNegAdcPulseTime.THcSignalHit.GetData()"},
       { 0 }
     };
     DefineVarsFromList( vars, mode);
+
+    THcSignalTable::SignalVar_t posvars[] = {
+      {"posAdcPedRaw",       "Positive Raw ADC pedestals",        THcSignalTable::kPedRaw},
+      {"posAdcPulseIntRaw",  "Positive Raw ADC pulse integrals",  THcSignalTable::kPulseIntRaw},
+      {"posAdcPulseAmpRaw",  "Positive Raw ADC pulse amplitudes", THcSignalTable::kPulseAmpRaw},
+      {"posAdcPulseTimeRaw", "Positive Raw ADC pulse times",      THcSignalTable::kPulseTimeRaw},
+      {"posAdcPed",          "Positive ADC pedestals",            THcSignalTable::kPed},
+      {"posAdcPulseInt",     "Positive ADC pulse integrals",      THcSignalTable::kPulseInt},
+      {"posAdcPulseAmp",     "Positive ADC pulse amplitudes",     THcSignalTable::kPulseAmp},
+      {"posAdcPulseTime",    "Positive ADC pulse times",          THcSignalTable::kPulseTime},
+      { 0 }
+    };
+    frPosAdc->DefineVariables(mode, GetPrefix(), posvars);
+    THcSignalTable::SignalVar_t negvars[] = {
+      {"negAdcPedRaw",       "Negative Raw ADC pedestals",        THcSignalTable::kPedRaw},
+      {"negAdcPulseIntRaw",  "Negative Raw ADC pulse integrals",  THcSignalTable::kPulseIntRaw},
+      {"negAdcPulseAmpRaw",  "Negative Raw ADC pulse amplitudes", THcSignalTable::kPulseAmpRaw},
+      {"negAdcPulseTimeRaw", "Negative Raw ADC pulse times",      THcSignalTable::kPulseTimeRaw},
+      {"negAdcPed",          "Negative ADC pedestals",            THcSignalTable::kPed},
+      {"negAdcPulseInt",     "Negative ADC pulse integrals",      THcSignalTable::kPulseInt},
+      {"negAdcPulseAmp",     "Negative ADC pulse amplitudes",     THcSignalTable::kPulseAmp},
+      {"negAdcPulseTime",    "Negative ADC pulse times",          THcSignalTable::kPulseTime},
+      { 0 }
+    };
+    frNegAdc->DefineVariables(mode, GetPrefix(), negvars);
   } //end debug statement
 
   if (fSixGevData) {
@@ -442,12 +406,20 @@ Int_t THcAerogel::DefineVariables( EMode mode )
     DefineVarsFromList( vars, mode);
   } //end fSixGevData statement
 
-  RVarDef vars[] = {
-    {"posAdcCounter",   "Positive ADC counter numbers",   "frPosAdcPulseIntRaw.THcSignalHit.GetPaddleNumber()"},
-    {"negAdcCounter",   "Negative ADC counter numbers",   "frNegAdcPulseIntRaw.THcSignalHit.GetPaddleNumber()"},
-    {"posAdcErrorFlag", "Error Flag for When FPGA Fails", "fPosAdcErrorFlag.THcSignalHit.GetData()"},
-    {"negAdcErrorFlag", "Error Flag for When FPGA Fails", "fNegAdcErrorFlag.THcSignalHit.GetData()"},
+  THcSignalTable::SignalVar_t posvars[] = {
+    {"posAdcCounter",   "Positive ADC counter numbers",   THcSignalTable::kPaddle},
+    {"posAdcErrorFlag", "Error Flag for When FPGA Fails", THcSignalTable::kErrorFlag},
+    { 0 }
+  };
+  frPosAdc->DefineVariables(mode, GetPrefix(), posvars);
+  THcSignalTable::SignalVar_t negvars[] = {
+    {"negAdcCounter",   "Negative ADC counter numbers",   THcSignalTable::kPaddle},
+    {"negAdcErrorFlag", "Error Flag for When FPGA Fails", THcSignalTable::kErrorFlag},
+    { 0 }
+  };
+  frNegAdc->DefineVariables(mode, GetPrefix(), negvars);
 
+  RVarDef vars[] = {
     {"numGoodPosAdcHits",    "Number of Good Positive ADC Hits Per PMT", "fNumGoodPosAdcHits"},    // Aerogel occupancy
     {"numGoodNegAdcHits",    "Number of Good Negative ADC Hits Per PMT", "fNumGoodNegAdcHits"},    // Aerogel occupancy
     {"totNumGoodPosAdcHits", "Total Number of Good Positive ADC Hits",   "fTotNumGoodPosAdcHits"}, // Aerogel multiplicity
@@ -510,26 +482,8 @@ void THcAerogel::Clear(Option_t* opt)
   fPosNpeSum = 0.0;
   fNegNpeSum = 0.0;
 
-  frPosAdcPedRaw->Clear();
-  frPosAdcPulseIntRaw->Clear();
-  frPosAdcPulseAmpRaw->Clear();
-  frPosAdcPulseTimeRaw->Clear();
-  frPosAdcPed->Clear();
-  frPosAdcPulseInt->Clear();
-  frPosAdcPulseAmp->Clear();
-  frPosAdcPulseTime->Clear();
-
-  frNegAdcPedRaw->Clear();
-  frNegAdcPulseIntRaw->Clear();
-  frNegAdcPulseAmpRaw->Clear();
-  frNegAdcPulseTimeRaw->Clear();
-  frNegAdcPed->Clear();
-  frNegAdcPulseInt->Clear();
-  frNegAdcPulseAmp->Clear();
-  frNegAdcPulseTime->Clear();
-
-  fPosAdcErrorFlag->Clear();
-  fNegAdcErrorFlag->Clear();
+  frPosAdc->Clear();
+  frNegAdc->Clear();
 
   for (UInt_t ielem = 0; ielem < fNumPosAdcHits.size(); ielem++)
     fNumPosAdcHits.at(ielem) = 0;
@@ -619,8 +573,6 @@ Int_t THcAerogel::Decode( const THaEvData& evdata )
   }
 
   Int_t  ihit         = 0;
-  UInt_t nrPosAdcHits = 0;
-  UInt_t nrNegAdcHits = 0;
 
   while(ihit < fNhits) {
     THcAerogelHit* hit          = (THcAerogelHit*) fRawHitList->At(ihit);
@@ -630,44 +582,18 @@ Int_t THcAerogel::Decode( const THaEvData& evdata )
 
     for (UInt_t thit=0; thit<rawPosAdcHit.GetNPulses(); ++thit) {
 
-      ((THcSignalHit*) frPosAdcPedRaw->ConstructedAt(nrPosAdcHits))->Set(npmt, rawPosAdcHit.GetPedRaw());
-      ((THcSignalHit*) frPosAdcPed->ConstructedAt(nrPosAdcHits))->Set(npmt, rawPosAdcHit.GetPed());
-
-      ((THcSignalHit*) frPosAdcPulseIntRaw->ConstructedAt(nrPosAdcHits))->Set(npmt, rawPosAdcHit.GetPulseIntRaw(thit));
-      ((THcSignalHit*) frPosAdcPulseInt->ConstructedAt(nrPosAdcHits))->Set(npmt, rawPosAdcHit.GetPulseInt(thit));
-
-      ((THcSignalHit*) frPosAdcPulseAmpRaw->ConstructedAt(nrPosAdcHits))->Set(npmt, rawPosAdcHit.GetPulseAmpRaw(thit));
-      ((THcSignalHit*) frPosAdcPulseAmp->ConstructedAt(nrPosAdcHits))->Set(npmt, rawPosAdcHit.GetPulseAmp(thit));
-
-      ((THcSignalHit*) frPosAdcPulseTimeRaw->ConstructedAt(nrPosAdcHits))->Set(npmt, rawPosAdcHit.GetPulseTimeRaw(thit));
-      ((THcSignalHit*) frPosAdcPulseTime->ConstructedAt(nrPosAdcHits))->Set(npmt, rawPosAdcHit.GetPulseTime(thit)+fAdcTdcOffset);
+      Int_t row = frPosAdc->AddAdcPulse(npmt, rawPosAdcHit, thit, fAdcTdcOffset);
+      frPosAdc->Set(row, THcSignalTable::kErrorFlag, (rawPosAdcHit.GetPulseAmpRaw(thit) <= 0) ? 1 : 0);
 
-      if (rawPosAdcHit.GetPulseAmpRaw(thit) > 0)  ((THcSignalHit*) fPosAdcErrorFlag->ConstructedAt(nrPosAdcHits))->Set(npmt, 0);
-      if (rawPosAdcHit.GetPulseAmpRaw(thit) <= 0) ((THcSignalHit*) fPosAdcErrorFlag->ConstructedAt(nrPosAdcHits))->Set(npmt, 1);
-
-      ++nrPosAdcHits;
       fTotNumAdcHits++;
       fTotNumPosAdcHits++;
       fNumPosAdcHits.at(npmt-1) = npmt;
     }
 
     for (UInt_t thit=0; thit<rawNegAdcHit.GetNPulses(); ++thit) {
-      ((THcSignalHit*) frNegAdcPedRaw->ConstructedAt(nrNegAdcHits))->Set(npmt, rawNegAdcHit.GetPedRaw());
-      ((THcSignalHit*) frNegAdcPed->ConstructedAt(nrNegAdcHits))->Set(npmt, rawNegAdcHit.GetPed());
-
-      ((THcSignalHit*) frNegAdcPulseIntRaw->ConstructedAt(nrNegAdcHits))->Set(npmt, rawNegAdcHit.GetPulseIntRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseInt->ConstructedAt(nrNegAdcHits))->Set(npmt, rawNegAdcHit.GetPulseInt(thit));
-
-      ((THcSignalHit*) frNegAdcPulseAmpRaw->ConstructedAt(nrNegAdcHits))->Set(npmt, rawNegAdcHit.GetPulseAmpRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseAmp->ConstructedAt(nrNegAdcHits))->Set(npmt, rawNegAdcHit.GetPulseAmp(thit));
-
-      ((THcSignalHit*) frNegAdcPulseTimeRaw->ConstructedAt(nrNegAdcHits))->Set(npmt, rawNegAdcHit.GetPulseTimeRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseTime->ConstructedAt(nrNegAdcHits))->Set(npmt, rawNegAdcHit.GetPulseTime(thit));
-
-      if (rawNegAdcHit.GetPulseAmpRaw(thit) > 0)  ((THcSignalHit*) fNegAdcErrorFlag->ConstructedAt(nrNegAdcHits))->Set(npmt, 0);
-      if (rawNegAdcHit.GetPulseAmpRaw(thit) <= 0) ((THcSignalHit*) fNegAdcErrorFlag->ConstructedAt(nrNegAdcHits))->Set(npmt, 1);
+      Int_t row = frNegAdc->AddAdcPulse(npmt, rawNegAdcHit, thit);
+      frNegAdc->Set(row, THcSignalTable::kErrorFlag, (rawNegAdcHit.GetPulseAmpRaw(thit) <= 0) ? 1 : 0);
 
-      ++nrNegAdcHits;
       fTotNumAdcHits++;
       fTotNumNegAdcHits++;
       fNumNegAdcHits.at(npmt-1) = npmt;
@@ -690,16 +616,16 @@ Int_t THcAerogel::CoarseProcess( TClonesArray&  ) //tracks
   if( fglHod ) StartTime = fglHod->GetStartTime();
   //cout << " starttime = " << StartTime << endl;
     // Loop over the elements in the TClonesArray
-    for(Int_t ielem = 0; ielem < frPosAdcPulseInt->GetEntries(); ielem++) {
-
-      Int_t    npmt         = ((THcSignalHit*) frPosAdcPulseInt->ConstructedAt(ielem))->GetPaddleNumber() - 1;
-      Double_t pulsePed     = ((THcSignalHit*) frPosAdcPed->ConstructedAt(ielem))->GetData();
-      Double_t pulseInt     = ((THcSignalHit*) frPosAdcPulseInt->ConstructedAt(ielem))->GetData();
-      Double_t pulseIntRaw  = ((THcSignalHit*) frPosAdcPulseIntRaw->ConstructedAt(ielem))->GetData();
-      Double_t pulseAmp     = ((THcSignalHit*) frPosAdcPulseAmp->ConstructedAt(ielem))->GetData();
-      Double_t pulseTime    = ((THcSignalHit*) frPosAdcPulseTime->ConstructedAt(ielem))->GetData();
+    for(Int_t ielem = 0; ielem < frPosAdc->GetNRows(); ielem++) {
+
+      Int_t    npmt         = frPosAdc->GetPaddle(ielem) - 1;
+      Double_t pulsePed     = frPosAdc->Get(ielem, THcSignalTable::kPed);
+      Double_t pulseInt     = frPosAdc->Get(ielem, THcSignalTable::kPulseInt);
+      Double_t pulseIntRaw  = frPosAdc->Get(ielem, THcSignalTable::kPulseIntRaw);
+      Double_t pulseAmp     = frPosAdc->Get(ielem, THcSignalTable::kPulseAmp);
+      Double_t pulseTime    = frPosAdc->Get(ielem, THcSignalTable::kPulseTime);
       Double_t adctdcdiffTime = StartTime-pulseTime;
-      Bool_t   errorFlag    = ((THcSignalHit*) fPosAdcErrorFlag->ConstructedAt(ielem))->GetData();
+      Bool_t   errorFlag    = frPosAdc->Get(ielem, THcSignalTable::kErrorFlag);
       ////      Bool_t   pulseTimeCut = adctdcdiffTime > fAdcTimeWindowMin && adctdcdiffTime < fAdcTimeWindowMax;
       Bool_t   pulseTimeCut = adctdcdiffTime > fAdcPosTimeWindowMin[npmt] && adctdcdiffTime < fAdcPosTimeWindowMax[npmt];
 
@@ -711,7 +637,7 @@ Int_t THcAerogel::CoarseProcess( TClonesArray&  ) //tracks
 
      if (!errorFlag && pulseTimeCut) {
     	fGoodPosAdcPed.at(npmt)         = pulsePed;
- 	//	cout << " out = " << npmt << " " <<   frPosAdcPulseInt->GetEntries() << " " <<fGoodPosAdcMult.at(npmt); 
+ 	//	cout << " out = " << npmt << " " <<   frPosAdc->GetNRows() << " " <<fGoodPosAdcMult.at(npmt); 
     	fGoodPosAdcPulseInt.at(npmt)    = pulseInt;
     	fGoodPosAdcPulseIntRaw.at(npmt) = pulseIntRaw;
     	fGoodPosAdcPulseAmp.at(npmt)    = pulseAmp;
@@ -728,16 +654,16 @@ Int_t THcAerogel::CoarseProcess( TClonesArray&  ) //tracks
     }
 
     // Loop over the elements in the TClonesArray
-    for(Int_t ielem = 0; ielem < frNegAdcPulseInt->GetEntries(); ielem++) {
-
-      Int_t    npmt         = ((THcSignalHit*) frNegAdcPulseInt->ConstructedAt(ielem))->GetPaddleNumber() - 1;
-      Double_t pulsePed     = ((THcSignalHit*) frNegAdcPed->ConstructedAt(ielem))->GetData();
-      Double_t pulseInt     = ((THcSignalHit*) frNegAdcPulseInt->ConstructedAt(ielem))->GetData();
-      Double_t pulseIntRaw  = ((THcSignalHit*) frNegAdcPulseIntRaw->ConstructedAt(ielem))->GetData();
-      Double_t pulseAmp     = ((THcSignalHit*) frNegAdcPulseAmp->ConstructedAt(ielem))->GetData();
-      Double_t pulseTime    = ((THcSignalHit*) frNegAdcPulseTime->ConstructedAt(ielem))->GetData();
+    for(Int_t ielem = 0; ielem < frNegAdc->GetNRows(); ielem++) {
+
+      Int_t    npmt         = frNegAdc->GetPaddle(ielem) - 1;
+      Double_t pulsePed     = frNegAdc->Get(ielem, THcSignalTable::kPed);
+      Double_t pulseInt     = frNegAdc->Get(ielem, THcSignalTable::kPulseInt);
+      Double_t pulseIntRaw  = frNegAdc->Get(ielem, THcSignalTable::kPulseIntRaw);
+      Double_t pulseAmp     = frNegAdc->Get(ielem, THcSignalTable::kPulseAmp);
+      Double_t pulseTime    = frNegAdc->Get(ielem, THcSignalTable::kPulseTime);
       Double_t adctdcdiffTime = StartTime-pulseTime;
-      Bool_t   errorFlag    = ((THcSignalHit*) fNegAdcErrorFlag->ConstructedAt(ielem))->GetData();
+      Bool_t   errorFlag    = frNegAdc->Get(ielem, THcSignalTable::kErrorFlag);
       ////      Bool_t   pulseTimeCut = adctdcdiffTime > fAdcTimeWindowMin && adctdcdiffTime < fAdcTimeWindowMax;
       Bool_t   pulseTimeCut = adctdcdiffTime > fAdcNegTimeWindowMin[npmt] && adctdcdiffTime < fAdcNegTimeWindowMax[npmt];
       if (!errorFlag)
@@ -12,6 +12,7 @@
 #include "THcHitList.h"
 #include "THcAerogelHit.h"
 class THcHodoscope;
+class THcSignalTable;
 
 class THcAerogel : public THaNonTrackingDetector, public THcHitList {
 
@@ -89,24 +90,8 @@ class THcAerogel : public THaNonTrackingDetector, public THcHitList {
   Double_t  *fPosGain;
   Double_t  *fNegGain;
   // FADC data objects
-  TClonesArray* frPosAdcPedRaw;
-  TClonesArray* frPosAdcPulseIntRaw;
-  TClonesArray* frPosAdcPulseAmpRaw;
-  TClonesArray* frPosAdcPulseTimeRaw;
-  TClonesArray* frPosAdcPed;
-  TClonesArray* frPosAdcPulseInt;
-  TClonesArray* frPosAdcPulseAmp;
-  TClonesArray* frPosAdcPulseTime;
-  TClonesArray* frNegAdcPedRaw;
-  TClonesArray* frNegAdcPulseIntRaw;
-  TClonesArray* frNegAdcPulseAmpRaw;
-  TClonesArray* frNegAdcPulseTimeRaw;
-  TClonesArray* frNegAdcPed;
-  TClonesArray* frNegAdcPulseInt;
-  TClonesArray* frNegAdcPulseAmp;
-  TClonesArray* frNegAdcPulseTime;
-  TClonesArray* fPosAdcErrorFlag;
-  TClonesArray* fNegAdcErrorFlag;
+  THcSignalTable* frPosAdc;
+  THcSignalTable* frNegAdc;
   // Individual PMT data objects
   vector<Int_t>    fNumPosAdcHits;
   vector<Int_t>    fNumNegAdcHits;
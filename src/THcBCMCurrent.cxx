@@ -21,6 +21,9 @@
 
 #include "THcBCMCurrent.h"
 
+#include <algorithm>
+#include <utility>
+
 using namespace std;
 
 THcBCMCurrent::THcBCMCurrent(const char* name,
@@ -28,6 +31,8 @@ THcBCMCurrent::THcBCMCurrent(const char* name,
   THaPhysicsModule(name, description)
 {
 
+  fNscaler = 0;
+  fCursor  = 0;
   fBCMflag = 0;
 
   fBCM1avg  = 0;
@@ -44,13 +49,6 @@ THcBCMCurrent::~THcBCMCurrent()
 
   DefineVariables (kDelete);
 
-  delete [] fiBCM1;  fiBCM1 = NULL;
-  delete [] fiBCM2;  fiBCM2 = NULL;
-  delete [] fiBCM4a; fiBCM4a = NULL;
-  delete [] fiBCM4b; fiBCM4b = NULL;
-  delete [] fiBCM4c; fiBCM4c = NULL;
-  delete [] fEvtNum; fEvtNum = NULL;
-
 }
 
 //__________________________________________________
@@ -71,44 +69,64 @@ Int_t THcBCMCurrent::ReadDatabase( const TDatime& date )
 {
   
   DBRequest list1[] = {
-    {"num_scal_reads",               &fNscaler,   kInt},
     {"gBCM_Current_threshold",       &fThreshold, kDouble}, 
     {"gBCM_Current_threshold_index", &fBCMIndex,  kInt}, 
     {0}
   };
 
   gHcParms->LoadParmValues((DBRequest*)&list1);
-  
-  fiBCM1     = new Double_t[fNscaler];
-  fiBCM2     = new Double_t[fNscaler];
-  fiBCM4a    = new Double_t[fNscaler];
-  fiBCM4b    = new Double_t[fNscaler];
-  fiBCM4c    = new Double_t[fNscaler];
 
-  fEvtNum    = new Int_t[fNscaler];
+  fCursor = 0;
 
   DBRequest list2[] = {
-    {"scal_read_bcm1_current",  fiBCM1,     kDouble, (UInt_t) fNscaler},
-    {"scal_read_bcm2_current",  fiBCM2,     kDouble, (UInt_t) fNscaler},
-    {"scal_read_bcm4a_current", fiBCM4a,    kDouble, (UInt_t) fNscaler},
-    {"scal_read_bcm4b_current", fiBCM4b,    kDouble, (UInt_t) fNscaler},
-    {"scal_read_bcm4c_current", fiBCM4c,    kDouble, (UInt_t) fNscaler},
-    {"scal_read_event",         fEvtNum,    kInt,    (UInt_t) fNscaler},
+    {"num_scal_reads",               &fNscaler,   kInt},
     {0}
   };
 
   gHcParms->LoadParmValues((DBRequest*)&list2);
 
-  BCMInfo binfo;
+  fEvtNum.clear();
+  fiBCM1.clear();
+  fiBCM2.clear();
+  fiBCM4a.clear();
+  fiBCM4b.clear();
+  fiBCM4c.clear();
+  if( fNscaler <= 0 )
+    return kOK;
+
+  vector<Double_t> bcm1(fNscaler), bcm2(fNscaler);
+  vector<Double_t> bcm4a(fNscaler), bcm4b(fNscaler), bcm4c(fNscaler);
+  vector<Int_t> evtnum(fNscaler);
+
+  DBRequest list3[] = {
+    {"scal_read_bcm1_current",  &bcm1[0],   kDouble, (UInt_t) fNscaler},
+    {"scal_read_bcm2_current",  &bcm2[0],   kDouble, (UInt_t) fNscaler},
+    {"scal_read_bcm4a_current", &bcm4a[0],  kDouble, (UInt_t) fNscaler},
+    {"scal_read_bcm4b_current", &bcm4b[0],  kDouble, (UInt_t) fNscaler},
+    {"scal_read_bcm4c_current", &bcm4c[0],  kDouble, (UInt_t) fNscaler},
+    {"scal_read_event",         &evtnum[0], kInt,    (UInt_t) fNscaler},
+    {0}
+  };
+
+  gHcParms->LoadParmValues((DBRequest*)&list3);
+
+  // Sort the reads by event number.  If an event number is repeated,
+  // the first read in the parameter file is used.
+  vector< pair<Int_t,Int_t> > order(fNscaler);
   for(int i=0; i<fNscaler; i++)
-    {
-      binfo.bcm1_current  = fiBCM1[i];
-      binfo.bcm2_current  = fiBCM2[i];
-      binfo.bcm4a_current = fiBCM4a[i];
-      binfo.bcm4b_current = fiBCM4b[i];
-      binfo.bcm4c_current = fiBCM4c[i];
+    order[i] = make_pair(evtnum[i], i);
+  sort(order.begin(), order.end());
 
-      BCMInfoMap.insert( std::make_pair(fEvtNum[i], binfo) );
+  for(int k=0; k<fNscaler; k++)
+    {
+      if( k>0 && order[k].first == order[k-1].first ) continue;
+      Int_t i = order[k].second;
+      fEvtNum.push_back(evtnum[i]);
+      fiBCM1.push_back(bcm1[i]);
+      fiBCM2.push_back(bcm2[i]);
+      fiBCM4a.push_back(bcm4a[i]);
+      fiBCM4b.push_back(bcm4b[i]);
+      fiBCM4c.push_back(bcm4c[i]);
     }
 
   return kOK;
@@ -197,34 +215,29 @@ Int_t THcBCMCurrent::Process( const THaEvData& evdata )
 Int_t THcBCMCurrent::GetAvgCurrent( Int_t fevn, BCMInfo &bcminfo )
 {
 
-  map<int, BCMInfo>::iterator it, next;
-  it = BCMInfoMap.find(fevn);
-  if( it != BCMInfoMap.end() )
+  // Use the first scaler read at or after this event.  Events come in
+  // increasing order, so start from the read used for the last event.
+  UInt_t n = fEvtNum.size();
+  UInt_t i = fCursor;
+  if( i > n || (i > 0 && fEvtNum[i-1] >= fevn) )
     {
-      bcminfo.bcm1_current  = it->second.bcm1_current;
-      bcminfo.bcm2_current  = it->second.bcm2_current;
-      bcminfo.bcm4a_current = it->second.bcm4a_current;
-      bcminfo.bcm4b_current = it->second.bcm4b_current;
-      bcminfo.bcm4c_current = it->second.bcm4c_current;
-
-      return kOK;
+      i = lower_bound(fEvtNum.begin(), fEvtNum.end(), fevn) - fEvtNum.begin();
     }
   else
     {
-      next = BCMInfoMap.upper_bound(fevn);
-      if( next != BCMInfoMap.end() )
-	{
-	  bcminfo.bcm1_current  = next->second.bcm1_current;
-	  bcminfo.bcm2_current  = next->second.bcm2_current;
-	  bcminfo.bcm4a_current = next->second.bcm4a_current;
-	  bcminfo.bcm4b_current = next->second.bcm4b_current;
-	  bcminfo.bcm4c_current = next->second.bcm4c_current;
-	  return kOK;
-	}
-      return kOK+1;
+      while( i < n && fEvtNum[i] < fevn ) i++;
     }
+  fCursor = i;
+
+  if( i == n ) return kOK+1;
 
-  return kOK+1;
+  bcminfo.bcm1_current  = fiBCM1[i];
+  bcminfo.bcm2_current  = fiBCM2[i];
+  bcminfo.bcm4a_current = fiBCM4a[i];
+  bcminfo.bcm4b_current = fiBCM4b[i];
+  bcminfo.bcm4c_current = fiBCM4c[i];
+
+  return kOK;
 
 }
 
@@ -7,7 +7,7 @@
 #include "VarType.h"
 
 #include <iostream>
-#include <map>
+#include <vector>
 
 class THcBCMCurrent : public THaPhysicsModule {
     
@@ -26,12 +26,15 @@ class THcBCMCurrent : public THaPhysicsModule {
   Int_t     fNscaler;
   Double_t  fThreshold;
   Int_t     fBCMIndex;
-  Double_t* fiBCM1;
-  Double_t* fiBCM2;
-  Double_t* fiBCM4a;
-  Double_t* fiBCM4b;
-  Double_t* fiBCM4c;
-  Int_t*    fEvtNum;
+
+  // Scaler read table, sorted by event number.  One array per BCM.
+  std::vector<Int_t>    fEvtNum;
+  std::vector<Double_t> fiBCM1;
+  std::vector<Double_t> fiBCM2;
+  std::vector<Double_t> fiBCM4a;
+  std::vector<Double_t> fiBCM4b;
+  std::vector<Double_t> fiBCM4c;
+  UInt_t    fCursor;		// Table entry used for the last event
 
   Int_t    fBCMflag;
 
@@ -49,8 +52,6 @@ class THcBCMCurrent : public THaPhysicsModule {
     Double_t bcm4c_current;
   };
 
-  std::map<Int_t, BCMInfo> BCMInfoMap;
-
   Int_t GetAvgCurrent( Int_t fevn, BCMInfo &bcminfo );
   virtual Int_t ReadDatabase( const TDatime& date);
   virtual Int_t DefineVariables( EMode mode = kDefine );
@@ -8,7 +8,7 @@
 #include "THcCherenkov.h"
 #include "THcHodoscope.h"
 #include "TClonesArray.h"
-#include "THcSignalHit.h"
+#include "THcSignalTable.h"
 #include "THaEvData.h"
 #include "THaDetMap.h"
 #include "THcDetectorMap.h"
@@ -48,15 +48,7 @@ THcCherenkov::THcCherenkov( const char* name, const char* description,
   THaNonTrackingDetector(name,description,apparatus)
 {
   // Normal constructor with name and description
-  frAdcPedRaw       = new TClonesArray("THcSignalHit", MaxNumCerPmt*MaxNumAdcPulse);
-  frAdcPulseIntRaw  = new TClonesArray("THcSignalHit", MaxNumCerPmt*MaxNumAdcPulse);
-  frAdcPulseAmpRaw  = new TClonesArray("THcSignalHit", MaxNumCerPmt*MaxNumAdcPulse);
-  frAdcPulseTimeRaw = new TClonesArray("THcSignalHit", MaxNumCerPmt*MaxNumAdcPulse);
-  frAdcPed          = new TClonesArray("THcSignalHit", MaxNumCerPmt*MaxNumAdcPulse);
-  frAdcPulseInt     = new TClonesArray("THcSignalHit", MaxNumCerPmt*MaxNumAdcPulse);
-  frAdcPulseAmp     = new TClonesArray("THcSignalHit", MaxNumCerPmt*MaxNumAdcPulse);
-  frAdcPulseTime    = new TClonesArray("THcSignalHit", MaxNumCerPmt*MaxNumAdcPulse);
-  fAdcErrorFlag     = new TClonesArray("THcSignalHit", MaxNumCerPmt*MaxNumAdcPulse);
+  frAdc = new THcSignalTable(THcSignalTable::kAdcSignals, MaxNumCerPmt*MaxNumAdcPulse);
 
   fNumAdcHits         = vector<Int_t>    (MaxNumCerPmt, 0.0);
   fNumGoodAdcHits     = vector<Int_t>    (MaxNumCerPmt, 0.0);
@@ -80,15 +72,7 @@ THcCherenkov::THcCherenkov( ) :
   THaNonTrackingDetector()
 {
   // Constructor
-  frAdcPedRaw       = NULL;
-  frAdcPulseIntRaw  = NULL;
-  frAdcPulseAmpRaw  = NULL;
-  frAdcPulseTimeRaw = NULL;
-  frAdcPed          = NULL;
-  frAdcPulseInt     = NULL;
-  frAdcPulseAmp     = NULL;
-  frAdcPulseTime    = NULL;
-  fAdcErrorFlag     = NULL;
+  frAdc = NULL;
 
   InitArrays();
 }
@@ -97,15 +81,7 @@ THcCherenkov::THcCherenkov( ) :
 THcCherenkov::~THcCherenkov()
 {
   // Destructor
-  delete frAdcPedRaw;       frAdcPedRaw       = NULL;
-  delete frAdcPulseIntRaw;  frAdcPulseIntRaw  = NULL;
-  delete frAdcPulseAmpRaw;  frAdcPulseAmpRaw  = NULL;
-  delete frAdcPulseTimeRaw; frAdcPulseTimeRaw = NULL;
-  delete frAdcPed;          frAdcPed          = NULL;
-  delete frAdcPulseInt;     frAdcPulseInt     = NULL;
-  delete frAdcPulseAmp;     frAdcPulseAmp     = NULL;
-  delete frAdcPulseTime;    frAdcPulseTime    = NULL;
-  delete fAdcErrorFlag;     fAdcErrorFlag     = NULL;
+  delete frAdc; frAdc = NULL;
 
   DeleteArrays();
 }
@@ -282,23 +258,31 @@ Int_t THcCherenkov::DefineVariables( EMode mode )
     RVarDef vars[] = {
       {"numAdcHits",      "Number of ADC Hits Per PMT", "fNumAdcHits"},        // Cherenkov occupancy
       {"totNumAdcHits",   "Total Number of ADC Hits",   "fTotNumAdcHits"},     // Cherenkov multiplicity
-      {"adcPedRaw",       "Raw ADC pedestals",          "frAdcPedRaw.THcSignalHit.GetData()"},
-      {"adcPulseIntRaw",  "Raw ADC pulse integrals",    "frAdcPulseIntRaw.THcSignalHit.GetData()"},
-      {"adcPulseAmpRaw",  "Raw ADC pulse amplitudes",   "frAdcPulseAmpRaw.THcSignalHit.GetData()"},
-      {"adcPulseTimeRaw", "Raw ADC pulse times",        "frAdcPulseTimeRaw.THcSignalHit.GetData()"},
-      {"adcPed",          "ADC pedestals",              "frAdcPed.THcSignalHit.GetData()"},
-      {"adcPulseInt",     "ADC pulse integrals",        "frAdcPulseInt.THcSignalHit.GetData()"},
-      {"adcPulseAmp",     "ADC pulse amplitudes",       "frAdcPulseAmp.THcSignalHit.GetData()"},
-      {"adcPulseTime",    "ADC pulse times",            "frAdcPulseTime.THcSignalHit.GetData()"},
       { 0 }
     };
     DefineVarsFromList( vars, mode);
+    THcSignalTable::SignalVar_t adcvars[] = {
+      {"adcPedRaw",       "Raw ADC pedestals",          THcSignalTable::kPedRaw},
+      {"adcPulseIntRaw",  "Raw ADC pulse integrals",    THcSignalTable::kPulseIntRaw},
+      {"adcPulseAmpRaw",  "Raw ADC pulse amplitudes",   THcSignalTable::kPulseAmpRaw},
+      {"adcPulseTimeRaw", "Raw ADC pulse times",        THcSignalTable::kPulseTimeRaw},
+      {"adcPed",          "ADC pedestals",              THcSignalTable::kPed},
+      {"adcPulseInt",     "ADC pulse integrals",        THcSignalTable::kPulseInt},
+      {"adcPulseAmp",     "ADC pulse amplitudes",       THcSignalTable::kPulseAmp},
+      {"adcPulseTime",    "ADC pulse times",            THcSignalTable::kPulseTime},
+      { 0 }
+    };
+    frAdc->DefineVariables(mode, GetPrefix(), adcvars);
   } //end debug statement
 
-  RVarDef vars[] = {
-    {"adcCounter",   "ADC counter numbers",            "frAdcPulseIntRaw.THcSignalHit.GetPaddleNumber()"},
-    {"adcErrorFlag", "Error Flag for When FPGA Fails", "fAdcErrorFlag.THcSignalHit.GetData()"},
+  THcSignalTable::SignalVar_t adcvars[] = {
+    {"adcCounter",   "ADC counter numbers",            THcSignalTable::kPaddle},
+    {"adcErrorFlag", "Error Flag for When FPGA Fails", THcSignalTable::kErrorFlag},
+    { 0 }
+  };
+  frAdc->DefineVariables(mode, GetPrefix(), adcvars);
 
+  RVarDef vars[] = {
     {"numGoodAdcHits",    "Number of Good ADC Hits Per PMT", "fNumGoodAdcHits"},    // Cherenkov occupancy
     {"totNumGoodAdcHits", "Total Number of Good ADC Hits",   "fTotNumGoodAdcHits"}, // Cherenkov multiplicity
 
@@ -342,16 +326,7 @@ void THcCherenkov::Clear(Option_t* opt)
 
   fNpeSum = 0.0;
 
-  frAdcPedRaw->Clear();
-  frAdcPulseIntRaw->Clear();
-  frAdcPulseAmpRaw->Clear();
-  frAdcPulseTimeRaw->Clear();
-
-  frAdcPed->Clear();
-  frAdcPulseInt->Clear();
-  frAdcPulseAmp->Clear();
-  frAdcPulseTime->Clear();
-  fAdcErrorFlag->Clear();
+  frAdc->Clear();
 
   for (UInt_t ielem = 0; ielem < fNumAdcHits.size(); ielem++)
     fNumAdcHits.at(ielem) = 0;
@@ -397,7 +372,6 @@ Int_t THcCherenkov::Decode( const THaEvData& evdata )
   }
 
   Int_t  ihit      = 0;
-  UInt_t nrAdcHits = 0;
 
   while(ihit < fNhits) {
 
@@ -407,22 +381,9 @@ Int_t THcCherenkov::Decode( const THaEvData& evdata )
 
     for (UInt_t thit = 0; thit < rawAdcHit.GetNPulses(); thit++) {
 
-      ((THcSignalHit*) frAdcPedRaw->ConstructedAt(nrAdcHits))->Set(npmt, rawAdcHit.GetPedRaw());
-      ((THcSignalHit*) frAdcPed->ConstructedAt(nrAdcHits))->Set(npmt, rawAdcHit.GetPed());
-
-      ((THcSignalHit*) frAdcPulseIntRaw->ConstructedAt(nrAdcHits))->Set(npmt, rawAdcHit.GetPulseIntRaw(thit));
-      ((THcSignalHit*) frAdcPulseInt->ConstructedAt(nrAdcHits))->Set(npmt, rawAdcHit.GetPulseInt(thit));
-
-      ((THcSignalHit*) frAdcPulseAmpRaw->ConstructedAt(nrAdcHits))->Set(npmt, rawAdcHit.GetPulseAmpRaw(thit));
-      ((THcSignalHit*) frAdcPulseAmp->ConstructedAt(nrAdcHits))->Set(npmt, rawAdcHit.GetPulseAmp(thit));
-
-      ((THcSignalHit*) frAdcPulseTimeRaw->ConstructedAt(nrAdcHits))->Set(npmt, rawAdcHit.GetPulseTimeRaw(thit));
-      ((THcSignalHit*) frAdcPulseTime->ConstructedAt(nrAdcHits))->Set(npmt, rawAdcHit.GetPulseTime(thit)+fAdcTdcOffset);
-
-      if (rawAdcHit.GetPulseAmpRaw(thit) > 0)  ((THcSignalHit*) fAdcErrorFlag->ConstructedAt(nrAdcHits))->Set(npmt, 0);
-      if (rawAdcHit.GetPulseAmpRaw(thit) <= 0) ((THcSignalHit*) fAdcErrorFlag->ConstructedAt(nrAdcHits))->Set(npmt, 1);
+      Int_t row = frAdc->AddAdcPulse(npmt, rawAdcHit, thit, fAdcTdcOffset);
+      frAdc->Set(row, THcSignalTable::kErrorFlag, (rawAdcHit.GetPulseAmpRaw(thit) <= 0) ? 1 : 0);
 
-      ++nrAdcHits;
       fTotNumAdcHits++;
       fNumAdcHits.at(npmt-1) = npmt;
     }
@@ -447,12 +408,12 @@ Int_t THcCherenkov::CoarseProcess( TClonesArray&  )
     fAdcGoodElem[ipmt]=-1;
    }
    //
-  for(Int_t ielem = 0; ielem < frAdcPulseInt->GetEntries(); ielem++) {
-    Int_t    npmt         = ((THcSignalHit*) frAdcPulseInt->ConstructedAt(ielem))->GetPaddleNumber() - 1;
-    Double_t pulseTime    = ((THcSignalHit*) frAdcPulseTime->ConstructedAt(ielem))->GetData();
-    Double_t pulseAmp     = ((THcSignalHit*) frAdcPulseAmp->ConstructedAt(ielem))->GetData();
+  for(Int_t ielem = 0; ielem < frAdc->GetNRows(); ielem++) {
+    Int_t    npmt         = frAdc->GetPaddle(ielem) - 1;
+    Double_t pulseTime    = frAdc->Get(ielem, THcSignalTable::kPulseTime);
+    Double_t pulseAmp     = frAdc->Get(ielem, THcSignalTable::kPulseAmp);
    Double_t adctdcdiffTime = StartTime-pulseTime;
-     Bool_t   errorFlag    = ((THcSignalHit*) fAdcErrorFlag->ConstructedAt(ielem))->GetData();
+     Bool_t   errorFlag    = frAdc->Get(ielem, THcSignalTable::kErrorFlag);
     Bool_t   pulseTimeCut = adctdcdiffTime > fAdcTimeWindowMin[npmt] && adctdcdiffTime < fAdcTimeWindowMax[npmt];
     if (!errorFlag)
       {
@@ -467,11 +428,11 @@ Int_t THcCherenkov::CoarseProcess( TClonesArray&  )
   for(Int_t npmt = 0; npmt < fNelem; npmt++) {
     Int_t ielem = fAdcGoodElem[npmt];
     if (ielem != -1) {
-    Double_t pulsePed     = ((THcSignalHit*) frAdcPed->ConstructedAt(ielem))->GetData();
-    Double_t pulseInt     = ((THcSignalHit*) frAdcPulseInt->ConstructedAt(ielem))->GetData();
-    Double_t pulseIntRaw  = ((THcSignalHit*) frAdcPulseIntRaw->ConstructedAt(ielem))->GetData();
-    Double_t pulseAmp     = ((THcSignalHit*) frAdcPulseAmp->ConstructedAt(ielem))->GetData();
-    Double_t pulseTime    = ((THcSignalHit*) frAdcPulseTime->ConstructedAt(ielem))->GetData();
+    Double_t pulsePed     = frAdc->Get(ielem, THcSignalTable::kPed);
+    Double_t pulseInt     = frAdc->Get(ielem, THcSignalTable::kPulseInt);
+    Double_t pulseIntRaw  = frAdc->Get(ielem, THcSignalTable::kPulseIntRaw);
+    Double_t pulseAmp     = frAdc->Get(ielem, THcSignalTable::kPulseAmp);
+    Double_t pulseTime    = frAdc->Get(ielem, THcSignalTable::kPulseTime);
    Double_t adctdcdiffTime = StartTime-pulseTime;
     // By default, the last hit within the timing cut will be considered "good"
       fGoodAdcPed.at(npmt)         = pulsePed;
@@ -12,6 +12,7 @@
 #include "THcHitList.h"
 #include "THcCherenkovHit.h"
 class THcHodoscope;
+class THcSignalTable;
 
 class THcCherenkov : public THaNonTrackingDetector, public THcHitList {
 
@@ -108,15 +109,7 @@ class THcCherenkov : public THaNonTrackingDetector, public THcHitList {
   Int_t*    fAdcGoodElem;
 
   // 12 Gev FADC variables
-  TClonesArray* frAdcPedRaw;
-  TClonesArray* frAdcPulseIntRaw;
-  TClonesArray* frAdcPulseAmpRaw;
-  TClonesArray* frAdcPulseTimeRaw;
-  TClonesArray* frAdcPed;
-  TClonesArray* frAdcPulseInt;
-  TClonesArray* frAdcPulseAmp;
-  TClonesArray* frAdcPulseTime;
-  TClonesArray* fAdcErrorFlag;
+  THcSignalTable* frAdc;   // Raw ADC pulses
 
   void Setup(const char* name, const char* description);
   virtual void  InitializePedestals( );
@@ -85,10 +85,11 @@ Int_t THcConfigEvtHandler::Analyze(THaEvData *evdata)
   if (ldebug) cout << "------------------\n  Event type 125"<<endl;
 
   Int_t evlen = evdata->GetEvLength();
-  Int_t ip = 0;
-  ip++;
-  UInt_t thisword = evdata->GetRawData(ip);
-  Int_t roc = thisword & 0xff;
+  // The configuration data is a single bank whose num is the ROC
+  if(evlen < 2) return -1;
+  Int_t roc = evdata->GetRawData(1) & 0xff;
+  Int_t ip = 1;
+  UInt_t thisword;
   cout << "THcConfigEvtHandler: " << roc << endl;
   // Should check if this roc has already been seen
   CrateInfo_t *cinfo = new CrateInfo_t;
@@ -370,6 +371,26 @@ Int_t THcConfigEvtHandler::GetNPED(Int_t crate) {
   }
   return(-1);
 }
+Int_t THcConfigEvtHandler::GetNP(Int_t crate) {
+  if(CrateInfoMap.find(crate)!=CrateInfoMap.end()) {
+    CrateInfo_t *cinfo = CrateInfoMap[crate];
+    if(cinfo->FADC250.present > 0) return(cinfo->FADC250.np);
+  }
+  return(-1);
+}
+Int_t THcConfigEvtHandler::GetThreshold(Int_t crate, Int_t slot, Int_t chan) {
+  // Threshold of a channel if thresholds by slot were sent, otherwise
+  // the crate threshold.  -1 if not known.
+  if(CrateInfoMap.find(crate)!=CrateInfoMap.end()) {
+    CrateInfo_t *cinfo = CrateInfoMap[crate];
+    std::map<Int_t, Int_t *>::iterator itt = cinfo->FADC250.thresholds.find(slot);
+    if(itt != cinfo->FADC250.thresholds.end() && chan >= 0 && chan < 16) {
+      return(itt->second[chan]);
+    }
+    if(cinfo->FADC250.present > 0) return(cinfo->FADC250.threshold);
+  }
+  return(-1);
+}
 void THcConfigEvtHandler::AddEventType(Int_t evtype)
 {
   eventtypes.push_back(evtype);
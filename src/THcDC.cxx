@@ -25,10 +25,10 @@ the number of parameters per plane.
 #include "THaTrack.h"
 #include "TClonesArray.h"
 #include "TMath.h"
-#include "TVectorD.h"
 #include "THaApparatus.h"
 #include "THcHallCSpectrometer.h"
 
+#include <algorithm>
 #include <cstring>
 #include <cstdio>
 #include <cstdlib>
@@ -73,6 +73,9 @@ THcDC::THcDC(
   fCentralWire = NULL;
   fPlaneTimeZero = NULL;
   fSigma = NULL;
+  fPlaneCoeffs = NULL;
+  fPlaneRayCoefs = NULL;
+  fPlaneRayProducts = NULL;
 
   // These should be set to zero (in a parameter file) in order to
   // replicate historical ENGINE behavior
@@ -241,6 +244,24 @@ THaAnalysisObject::EStatus THcDC::Init( const TDatime& date )
   for(Int_t ip=0; ip<fNPlanes;ip++) {
     fPlaneCoeffs[ip] = fPlanes[ip]->GetPlaneCoef();
   }
+  // The coefficients of the ray parameters (x, y, x', y') in each plane
+  // and their products, as needed to set up the track fit
+  const Int_t raycoeffmap[]={4,5,2,3};
+  fPlaneRayCoefs = new Double_t [fNPlanes*NUM_FPRAY];
+  fPlaneRayProducts = new Double_t [fNPlanes*NUM_FPRAY*(NUM_FPRAY+1)/2];
+  for(Int_t ip=0; ip<fNPlanes;ip++) {
+    Double_t* raycoefs = &fPlaneRayCoefs[NUM_FPRAY*ip];
+    Double_t* products = &fPlaneRayProducts[NUM_FPRAY*(NUM_FPRAY+1)/2*ip];
+    for(Int_t ir=0;ir<NUM_FPRAY;ir++) {
+      raycoefs[ir] = fPlaneCoeffs[ip][raycoeffmap[ir]];
+    }
+    Int_t k=0;
+    for(Int_t ir=0;ir<NUM_FPRAY;ir++) {
+      for(Int_t jr=ir;jr<NUM_FPRAY;jr++) {
+	products[k++] = raycoefs[ir]*raycoefs[jr];
+      }
+    }
+  }
 
   fResiduals = new Double_t [fNPlanes];
   fResidualsExclPlane = new Double_t [fNPlanes];
@@ -488,6 +509,8 @@ void THcDC::DeleteArrays()
   delete [] fPlaneNames;
 
   delete [] fPlaneCoeffs; fPlaneCoeffs = 0;
+  delete [] fPlaneRayCoefs; fPlaneRayCoefs = 0;
+  delete [] fPlaneRayProducts; fPlaneRayProducts = 0;
   delete [] fResiduals; fResiduals = 0;
   delete [] fResidualsExclPlane; fResidualsExclPlane = 0;
   delete [] fWire_hit_did; fWire_hit_did = 0;
@@ -728,7 +751,8 @@ void THcDC::LinkStubs()
                     0) Put all space points in a single list
                     1) loop over all space points as seeds  isp1
                     2) Check if this space point is all ready in a track
-                    3) loop over all succeeding space pointss   isp2
+                    3) loop over all succeeding space points isp2 whose
+                       stub x is within fXtTrCriterion of the seed
                     4)  check if there is a track-criterion match
                          either add to existing track
                          or if there is another point in same chamber
@@ -754,36 +778,52 @@ void THcDC::LinkStubs()
       fSp.push_back(static_cast<THcSpacePoint*>(spacepointarray->At(isp)));
       fSp[fNSp]->fNChamber = nchamber;
       fSp[fNSp]->fNChamber_spnum = isp;
+      fSp[fNSp]->SetUsedInTrack(kFALSE);
       fNSp++;
-      if (ich==0 && fNSp>50) break;
-      if (fNSp>100) break;
     }
   }
-  Double_t stubminx = 999999;
-  Double_t stubminy = 999999;
-  Double_t stubminxp = 999999;
-  Double_t stubminyp = 999999;
   Int_t stub_tracks[MAXTRACKS];
   if(fSingleStub==0) {
+    // Space points with a stub, ordered by stub x.  A seed can only be
+    // linked to points inside its fXtTrCriterion window, so only those
+    // need to be looked at.  (Points with a non-finite x never pass the
+    // criterion.)
+    std::vector<std::pair<Double_t,Int_t> > xorder;
+    xorder.reserve(fNSp);
+    for(Int_t isp=0;isp<fNSp;isp++) {
+      if(fSp[isp]->GetSetStubFlag() && TMath::Finite(fSp[isp]->GetStubX())) {
+	xorder.push_back(std::make_pair(fSp[isp]->GetStubX(), isp));
+      }
+    }
+    std::sort(xorder.begin(), xorder.end());
+    std::vector<Int_t> candidates;
     for(Int_t isp1=0;isp1<fNSp-1;isp1++) { // isp1 is index/id in total list of space points
       THcSpacePoint* sp1 = fSp[isp1];
       Int_t sptracks=0;
-      // Now make sure this sp is not already used in a sp.
-      // Could this be done by having a sp point to the track it is in?
-      Int_t tryflag=1;
-      for(UInt_t itrack=0;itrack<fNDCTracks;itrack++) {
-	THcDCTrack *theDCTrack = static_cast<THcDCTrack*>( fDCTracks->At(itrack));
-	for(Int_t isp=0;isp<theDCTrack->GetNSpacePoints();isp++) {
-	  // isp is index into list of space points attached to theDCTrack
-	  if(theDCTrack->GetSpacePoint(isp) == sp1) {
-	    tryflag=0;
-	  }
+      // Now make sure this sp is not already used in a track.
+      Int_t tryflag=!sp1->IsUsedInTrack();
+      if(tryflag && sp1->GetSetStubFlag() && TMath::Finite(sp1->GetStubX())) {
+	// Succeeding space points inside the x window, in their original
+	// order.  The window is widened slightly so that rounding can not
+	// drop a point that passes the criterion below.
+	Double_t x1 = sp1->GetStubX();
+	Double_t halfwidth = fXtTrCriterion
+	  + 1.0e-9*(TMath::Abs(x1)+TMath::Abs(fXtTrCriterion));
+	std::vector<std::pair<Double_t,Int_t> >::const_iterator first =
+	  std::lower_bound(xorder.begin(), xorder.end(),
+			   std::make_pair(x1-halfwidth, -1));
+	std::vector<std::pair<Double_t,Int_t> >::const_iterator last =
+	  std::upper_bound(xorder.begin(), xorder.end(),
+			   std::make_pair(x1+halfwidth, fNSp));
+	candidates.clear();
+	for(;first!=last;++first) {
+	  if(first->second > isp1) candidates.push_back(first->second);
 	}
-      }
-      if(tryflag) { // SP not already part of a track
+	std::sort(candidates.begin(), candidates.end());
+
 	Int_t newtrack=1;
-	for(Int_t isp2=isp1+1;isp2<fNSp;isp2++) {
-	  THcSpacePoint* sp2=fSp[isp2];
+	for(UInt_t icand=0;icand<candidates.size();icand++) {
+	  THcSpacePoint* sp2=fSp[candidates[icand]];
 	  if(sp1->fNChamber!=sp2->fNChamber&&sp1->GetSetStubFlag()&&sp2->GetSetStubFlag()) {
 	    Double_t *spstub1=sp1->GetStubP();
 	    Double_t *spstub2=sp2->GetStubP();
@@ -803,17 +843,6 @@ void THcDC::LinkStubs()
 	    Double_t dposxp = spstub1[2] - spstub2[2];
 	    Double_t dposyp = spstub1[3] - spstub2[3];
 
-	    // What is the point of saving these stubmin values.  They
-	    // Don't seem to be used anywhere except that they can be
-	    // printed out if hbypass_track_eff_files is zero.
-	    if(TMath::Abs(dposx)<TMath::Abs(stubminx)) stubminx = dposx;
-	    if(TMath::Abs(dposy)<TMath::Abs(stubminy)) stubminy = dposy;
-	    if(TMath::Abs(dposxp)<TMath::Abs(stubminxp)) stubminxp = dposxp;
-	    if(TMath::Abs(dposyp)<TMath::Abs(stubminyp)) stubminyp = dposyp;
-
-	    // if hbypass_track_eff_files == 0 then
-	    // Print out each stubminX that is less that its criterion
-
 	    if((TMath::Abs(dposx) < fXtTrCriterion)
 	       && (TMath::Abs(dposy) < fYtTrCriterion)
 	       && (TMath::Abs(dposxp) < fXptTrCriterion)
@@ -896,7 +925,7 @@ void THcDC::LinkStubs()
 	      } // else newtrack
 	    } // criterion
 	  } // end test on same chamber
-	} // end isp2 loop over new space points
+	} // end loop over succeeding space points in the x window
       } // end test on tryflag
     } // end isp1 outer loop over space points
     //
@@ -940,20 +969,20 @@ void THcDC::TrackFit()
      Primary track fitting routine
   */
 
-  // Number of ray parameters in focal plane.
-  const Int_t raycoeffmap[]={4,5,2,3};
-
   Double_t dummychi2 = 1.0E4;
   for(UInt_t itrack=0;itrack<fNDCTracks;itrack++) {
     //    Double_t chi2 = dummychi2;
     //    Int_t htrack_fit_num = itrack;
     THcDCTrack *theDCTrack = static_cast<THcDCTrack*>( fDCTracks->At(itrack));
 
-    Double_t coords[theDCTrack->GetNHits()];
-    Int_t planes[theDCTrack->GetNHits()];
-    for(Int_t ihit=0;ihit < theDCTrack->GetNHits();ihit++) {
+    Int_t nhits = theDCTrack->GetNHits();
+    Double_t coords[nhits];
+    Double_t weights[nhits];	// 1/sigma**2 of each hit
+    Int_t planes[nhits];
+    for(Int_t ihit=0;ihit < nhits;ihit++) {
       THcDCHit* hit=theDCTrack->GetHit(ihit);
       planes[ihit]=hit->GetPlaneNum()-1;
+      weights[ihit]=1.0/pow(hit->GetWireSigma(),2);
       if(fFixLR) {
 	if(fFixPropagationCorrection) {
 	  coords[ihit] = hit->GetPos()
@@ -975,145 +1004,49 @@ void THcDC::TrackFit()
 
     } //end loop over hits
 
-    theDCTrack->SetNFree(theDCTrack->GetNHits() - NUM_FPRAY);
+    theDCTrack->SetNFree(nhits - NUM_FPRAY);
     Double_t chi2 = dummychi2;
+    Bool_t fitok = kFALSE;
     if(theDCTrack->GetNFree() > 0) {
-      TVectorD TT(NUM_FPRAY);
-      TMatrixD AA(NUM_FPRAY,NUM_FPRAY);
-      for(Int_t irayp=0;irayp<NUM_FPRAY;irayp++) {
-	TT[irayp] = 0.0;
-	for(Int_t ihit=0;ihit < theDCTrack->GetNHits();ihit++) {	
-
-	  THcDCHit* hit=theDCTrack->GetHit(ihit);
-	    
-	  TT[irayp] += (coords[ihit]*fPlaneCoeffs[planes[ihit]][raycoeffmap[irayp]])/pow(hit->GetWireSigma(),2);
-	  //	  if (hit->GetPlaneNum()==5)
-	  //	    {
-	  //	      //	cout << "Plane: " << hit->GetPlaneNum() << endl;
-	  //	      //cout << "Wire: " <<hit->GetWireNum() << endl;
-	  //	      //cout << "Sigma: " << hit->GetWireSigma() << endl;
-	  //	    }
-
-	} //end hit loop
-      }
-      for(Int_t irayp=0;irayp<NUM_FPRAY;irayp++) {
-	for(Int_t jrayp=0;jrayp<NUM_FPRAY;jrayp++) {
-	  AA[irayp][jrayp] = 0.0;
-	  if(jrayp<irayp) { // Symmetric
-	    AA[irayp][jrayp] = AA[jrayp][irayp];
-	  } else {
-	    for(Int_t ihit=0;ihit < theDCTrack->GetNHits();ihit++) {
-
-	      THcDCHit* hit=theDCTrack->GetHit(ihit);
-        
-		      
-	      AA[irayp][jrayp] += fPlaneCoeffs[planes[ihit]][raycoeffmap[irayp]]*
-		fPlaneCoeffs[planes[ihit]][raycoeffmap[jrayp]]/
-		pow(hit->GetWireSigma(),2);
-
-	    } //end ihit loop
-	  }
+      Double_t dray[NUM_FPRAY];
+      if(FitRay(nhits, planes, coords, weights, -1, dray)) {
+	fitok = kTRUE;
+	// Calculate hit coordinate for each plane for chi2 and efficiency
+	// calculations
+	for(Int_t iplane=0;iplane < fNPlanes; iplane++) {
+	  theDCTrack->SetCoord(iplane,PlaneRayCoord(iplane,dray));
 	}
-      }
-
-      // Solve 4x4 equations
-      TVectorD dray(NUM_FPRAY);
-      // Should check that it is invertable
-      AA.Invert();
-      dray = AA*TT;
-      //      cout << "DRAY: " << dray[0] << " "<< dray[1] << " "<< dray[2] << " "<< dray[3] << " "  << endl;
-      //      if(bad_determinant) {
-      //	dray[0] = dray[1] = 10000.; dray[2] = dray[3] = 2.0;
-      //      }
-      // Calculate hit coordinate for each plane for chi2 and efficiency
-      // calculations
-
-      // Make sure fCoords, fResiduals, and fDoubleResiduals are clear
-      for(Int_t iplane=0;iplane < fNPlanes; iplane++) {
-	Double_t coord=0.0;
-	for(Int_t ir=0;ir<NUM_FPRAY;ir++) {
-	  coord += fPlaneCoeffs[iplane][raycoeffmap[ir]]*dray[ir];
-	  // cout << "ir = " << ir << ", dray[ir] = " << dray[ir] << endl;
+	// Compute Chi2 and residuals
+	chi2 = 0.0;
+	for(Int_t ihit=0;ihit < nhits;ihit++) {
+	  Double_t residual = coords[ihit] - PlaneRayCoord(planes[ihit],dray);
+	  theDCTrack->SetResidual(planes[ihit], residual);
+	  chi2 += residual*residual*weights[ihit];
 	}
-	theDCTrack->SetCoord(iplane,coord);
+	theDCTrack->SetVector(dray[0], dray[1], 0.0, dray[2], dray[3]);
       }
-      // Compute Chi2 and residuals
-      chi2 = 0.0;
-      for(Int_t ihit=0;ihit < theDCTrack->GetNHits();ihit++) {
-
-	THcDCHit* hit=theDCTrack->GetHit(ihit);
-
-
-	Double_t residual = coords[ihit] - theDCTrack->GetCoord(planes[ihit]);
-	theDCTrack->SetResidual(planes[ihit], residual);
-
-  //  	  double track_coord = theDCTrack->GetCoord(planes[ihit]);
-//cout<<planes[ihit]<<"\t"<<track_coord<<"\t"<<coords[ihit]<<"\t"<<residual<<endl;
-	chi2 += pow(residual/hit->GetWireSigma(),2);
-
+    }
+    if(!fitok) {
+      // No ray: do not leave values from an earlier fit in the track
+      theDCTrack->SetVector(kBig, kBig, kBig, kBig, kBig);
+      for(Int_t iplane=0;iplane < fNPlanes; iplane++) {
+	theDCTrack->SetCoord(iplane, kBig);
+	theDCTrack->SetResidual(iplane, kBig);
+	theDCTrack->SetResidualExclPlane(iplane, kBig);
       }
-
-      theDCTrack->SetVector(dray[0], dray[1], 0.0, dray[2], dray[3]);
     }
     theDCTrack->SetChisq(chi2);
 
     // calculate ray without a plane in track
-    for(Int_t ipl_hit=0;ipl_hit < theDCTrack->GetNHits();ipl_hit++) {    
- 
-
-      if(theDCTrack->GetNFree() > 0) {
-	TVectorD TT(NUM_FPRAY);
-	TMatrixD AA(NUM_FPRAY,NUM_FPRAY);
-	for(Int_t irayp=0;irayp<NUM_FPRAY;irayp++) {
-	  TT[irayp] = 0.0;
-	  for(Int_t ihit=0;ihit < theDCTrack->GetNHits();ihit++) {
-	  
-
-	    THcDCHit* hit=theDCTrack->GetHit(ihit);
-
-	    if (ihit != ipl_hit) {
-	      TT[irayp] += (coords[ihit]*
-			    fPlaneCoeffs[planes[ihit]][raycoeffmap[irayp]])
-		/pow(hit->GetWireSigma(),2);
-
-	    }
-	  }
-	}
-	for(Int_t irayp=0;irayp<NUM_FPRAY;irayp++) {
-	  for(Int_t jrayp=0;jrayp<NUM_FPRAY;jrayp++) {
-	    AA[irayp][jrayp] = 0.0;
-	    if(jrayp<irayp) { // Symmetric
-	      AA[irayp][jrayp] = AA[jrayp][irayp];
-	    } else {
-
-	      for(Int_t ihit=0;ihit < theDCTrack->GetNHits();ihit++) {
-	      
-		THcDCHit* hit=theDCTrack->GetHit(ihit);
-
-
-		if (ihit != ipl_hit) {
-		  AA[irayp][jrayp] += fPlaneCoeffs[planes[ihit]][raycoeffmap[irayp]]*
-		    fPlaneCoeffs[planes[ihit]][raycoeffmap[jrayp]]/
-		    pow(hit->GetWireSigma(),2);
-
-		}
-	      }
-	    }
-	  }
-	}
-	//
-	// Solve 4x4 equations
-	// Should check that it is invertable
-	TVectorD dray(NUM_FPRAY);
-	AA.Invert();
-	dray = AA*TT;
-	Double_t coord=0.0;
-	for(Int_t ir=0;ir<NUM_FPRAY;ir++) {
-	  coord += fPlaneCoeffs[planes[ipl_hit]][raycoeffmap[ir]]*dray[ir];
-	  // cout << "ir = " << ir << ", dray[ir] = " << dray[ir] << endl;
+    if(fitok) {
+      for(Int_t ipl_hit=0;ipl_hit < nhits;ipl_hit++) {
+	Double_t dray[NUM_FPRAY];
+	if(FitRay(nhits, planes, coords, weights, ipl_hit, dray)) {
+	  Double_t residual = coords[ipl_hit] - PlaneRayCoord(planes[ipl_hit],dray);
+	  theDCTrack->SetResidualExclPlane(planes[ipl_hit], residual);
+	} else {
+	  theDCTrack->SetResidualExclPlane(planes[ipl_hit], kBig);
 	}
-	Double_t residual = coords[ipl_hit] - coord;
-	theDCTrack->SetResidualExclPlane(planes[ipl_hit], residual);
       }
     }
   }
@@ -1239,8 +1172,87 @@ void THcDC::TrackFit()
 
   //
 }
-//
-//
+
+//_____________________________________________________________________________
+Bool_t THcDC::FitRay(Int_t nhits, const Int_t* planes, const Double_t* coords,
+		     const Double_t* weights, Int_t exclude, Double_t* ray)
+{
+  /**
+     Weighted linear least squares fit of the focal plane ray
+     (x, y, x', y') to the hit coordinates.  The hit with index exclude
+     is left out of the fit (-1 to use all hits).
+
+     The normal equations are built from the per plane coefficient
+     products set up in Init and solved with a Cholesky decomposition.
+     Returns kFALSE, leaving ray untouched, if the normal matrix is not
+     positive definite.
+  */
+  const Int_t npacked = NUM_FPRAY*(NUM_FPRAY+1)/2;
+  Double_t aa[npacked];
+  Double_t tt[NUM_FPRAY];
+  for(Int_t k=0;k<npacked;k++) aa[k] = 0.0;
+  for(Int_t ir=0;ir<NUM_FPRAY;ir++) tt[ir] = 0.0;
+  for(Int_t ihit=0;ihit<nhits;ihit++) {
+    if(ihit == exclude) continue;
+    const Double_t* raycoefs = &fPlaneRayCoefs[NUM_FPRAY*planes[ihit]];
+    const Double_t* products = &fPlaneRayProducts[npacked*planes[ihit]];
+    Double_t w = weights[ihit];
+    Double_t wcoord = w*coords[ihit];
+    for(Int_t ir=0;ir<NUM_FPRAY;ir++) {
+      tt[ir] += wcoord*raycoefs[ir];
+    }
+    for(Int_t k=0;k<npacked;k++) {
+      aa[k] += w*products[k];
+    }
+  }
+
+  // Cholesky decomposition aa = L*L^T
+  Double_t ll[NUM_FPRAY][NUM_FPRAY];
+  Int_t k=0;
+  for(Int_t i=0;i<NUM_FPRAY;i++) {
+    for(Int_t j=i;j<NUM_FPRAY;j++) {
+      ll[j][i] = aa[k++];	// Lower triangle of the (symmetric) matrix
+    }
+  }
+  for(Int_t j=0;j<NUM_FPRAY;j++) {
+    Double_t diag = ll[j][j];
+    for(Int_t m=0;m<j;m++) diag -= ll[j][m]*ll[j][m];
+    if(!(diag > 0.0)) return kFALSE;
+    ll[j][j] = TMath::Sqrt(diag);
+    for(Int_t i=j+1;i<NUM_FPRAY;i++) {
+      Double_t sum = ll[i][j];
+      for(Int_t m=0;m<j;m++) sum -= ll[i][m]*ll[j][m];
+      ll[i][j] = sum/ll[j][j];
+    }
+  }
+  // Solve L*y = tt, then L^T*ray = y
+  Double_t yy[NUM_FPRAY];
+  for(Int_t i=0;i<NUM_FPRAY;i++) {
+    Double_t sum = tt[i];
+    for(Int_t m=0;m<i;m++) sum -= ll[i][m]*yy[m];
+    yy[i] = sum/ll[i][i];
+  }
+  for(Int_t i=NUM_FPRAY-1;i>=0;i--) {
+    Double_t sum = yy[i];
+    for(Int_t m=i+1;m<NUM_FPRAY;m++) sum -= ll[m][i]*ray[m];
+    ray[i] = sum/ll[i][i];
+  }
+  return kTRUE;
+}
+
+//_____________________________________________________________________________
+Double_t THcDC::PlaneRayCoord(Int_t plane, const Double_t* ray) const
+{
+  // Wire coordinate in the given plane of the fitted focal plane ray
+  const Double_t* raycoefs = &fPlaneRayCoefs[NUM_FPRAY*plane];
+  Double_t coord=0.0;
+  for(Int_t ir=0;ir<NUM_FPRAY;ir++) {
+    coord += raycoefs[ir]*ray[ir];
+  }
+  return coord;
+}
+
+//_____________________________________________________________________________
 Double_t THcDC::DpsiFun(Double_t ray[4], Int_t plane)
 {
   /**
@@ -168,6 +168,8 @@ protected:
   Double_t* fPlaneTimeZero;
   Double_t* fSigma;
   Double_t** fPlaneCoeffs;
+  Double_t* fPlaneRayCoefs;     // [fNPlanes*NUM_FPRAY] Coefficients of x, y, x', y'
+  Double_t* fPlaneRayProducts;  // Packed products of the above, per plane
   //
   Double_t fX_fp_best;
   Double_t fY_fp_best;
@@ -203,6 +205,9 @@ protected:
   virtual Int_t  DefineVariables( EMode mode = kDefine );
   void           LinkStubs();
   void           TrackFit();
+  Bool_t         FitRay(Int_t nhits, const Int_t* planes, const Double_t* coords,
+			const Double_t* weights, Int_t exclude, Double_t* ray);
+  Double_t       PlaneRayCoord(Int_t plane, const Double_t* ray) const;
   Double_t       DpsiFun(Double_t ray[4], Int_t plane);
   void           EffInit();
   void           Eff();
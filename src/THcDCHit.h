@@ -45,6 +45,13 @@ public:
 
   THcDriftChamberPlane* GetWirePlane() const { return fWirePlane; }
 
+  void     Set( THcDCWire* wire, Int_t rawnorefcorrtime, Int_t rawtime, Double_t time,
+		THcDriftChamberPlane* wp ) {
+    // Reinitialize a pooled hit.  The drift distance is not converted.
+    fWire = wire; fRawNoRefCorrTime = rawnorefcorrtime; fRawTime = rawtime;
+    fTime = time; fWirePlane = wp; fDist = 0.0; fLR = 0; ftrDist = kBig;
+    fCorrected = 0;
+  }
   void     SetWire(THcDCWire * wire) { fWire = wire; ConvertTimeToDist(); }
   void     SetRawTime(Int_t time)     { fRawTime = time; }
   void     SetTime(Double_t time)     { fTime = time; }
@@ -19,6 +19,8 @@ public:
   virtual ~THcDCLookupTTDConv();
 
   virtual Double_t ConvertTimeToDist(Double_t time);
+  virtual void     ConvertTimeToDist(const Double_t* times, Double_t* dists,
+				     UInt_t n);
 
 
 protected:
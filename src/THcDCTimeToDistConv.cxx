@@ -17,5 +17,18 @@ THcDCTimeToDistConv::~THcDCTimeToDistConv()
 
 }
 
+//______________________________________________________________________________
+void THcDCTimeToDistConv::ConvertTimeToDist(const Double_t* times,
+					    Double_t* dists, UInt_t n)
+{
+  /**
+     Convert n drift times into distances.  This default just calls the
+     single time conversion for each time.  Derived classes can override
+     it with a faster batch conversion giving the same results.
+  */
+  for(UInt_t i=0; i<n; i++) {
+    dists[i] = ConvertTimeToDist(times[i]);
+  }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -18,6 +18,8 @@ public:
   virtual ~THcDCTimeToDistConv();
 
   virtual Double_t ConvertTimeToDist(Double_t time) = 0;
+  virtual void     ConvertTimeToDist(const Double_t* times, Double_t* dists,
+				     UInt_t n);
 
 private:
 
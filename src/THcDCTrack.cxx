@@ -38,6 +38,7 @@ void THcDCTrack::AddSpacePoint( THcSpacePoint* sp )
 
   if (fnSP <10) {
     fSp[fnSP++] = sp;
+    sp->SetUsedInTrack();
     // Copy all the hits from the space point into the track
     // Will need to also copy the corrected distance and lr information
     for(Int_t ihit=0;ihit<sp->GetNHits();ihit++) {
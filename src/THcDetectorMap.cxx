@@ -12,10 +12,16 @@ FillMap method builds a map for a specific detector
 
 #include "TObjArray.h"
 #include "TObjString.h"
+#include "TSystem.h"
+#include "TMD5.h"
 
 #include <iostream>
 #include <fstream>
+#include <iterator>
 #include <cstdlib>
+#include <algorithm>
+#include <map>
+#include <utility>
 
 using namespace std;
 
@@ -28,7 +34,7 @@ inline static bool IsComment( const string& s, string::size_type pos )
 }
 
 //_____________________________________________________________________________
-THcDetectorMap::THcDetectorMap() : fNchans(0), fNIDs(0)
+THcDetectorMap::THcDetectorMap() : fNchans(0), fNIDs(0), fUseCache(kTRUE)
 {
 }
 
@@ -37,16 +43,60 @@ THcDetectorMap::~THcDetectorMap()
 {
 }
 
-bool THcDetectorMap::compare(const ChaninMod *first, const ChaninMod *second) {
-  // This one not used, but we get a link error if we don't include
-  // a compare method
-      return((first->channel < second->channel)? true: false);
+// Sort key for BuildIndex
+struct ChannelOrder {
+  Int_t did, module, channel, index;
+  bool operator<(const ChannelOrder& rhs) const {
+    if(did != rhs.did) return did < rhs.did;
+    if(module != rhs.module) return module < rhs.module;
+    if(channel != rhs.channel) return channel < rhs.channel;
+    return index < rhs.index;
+  }
+};
+static bool DidBefore(const THcDetectorMap::Channel& chan, Int_t did)
+{
+  return chan.did < did;
 }
-struct Functor
+static bool DidAfter(Int_t did, const THcDetectorMap::Channel& chan)
 {
-  bool operator() (const THcDetectorMap::ChaninMod &first, const THcDetectorMap::ChaninMod &second)
-  { return((first.channel < second.channel)? true: false);}
-};
+  return did < chan.did;
+}
+
+//_____________________________________________________________________________
+void THcDetectorMap::BuildIndex()
+{
+  // Sort the channels into fSorted once, for all FillMap calls
+
+  // Number the modules (roc, slot) of each detector in order of first
+  // appearance and remember the model of their first channel
+  map<pair<Int_t,pair<Int_t,Int_t> >, pair<Int_t,Int_t> > modules;
+  map<Int_t,Int_t> nmodules;
+  vector<ChannelOrder> order(fNchans);
+  vector<Int_t> modmodel(fNchans);
+  for(Int_t ich=0;ich<fNchans;ich++) {
+    const Channel& chan = fTable[ich];
+    pair<Int_t,pair<Int_t,Int_t> > key(chan.did, make_pair(chan.roc, chan.slot));
+    map<pair<Int_t,pair<Int_t,Int_t> >, pair<Int_t,Int_t> >::iterator im
+      = modules.find(key);
+    if(im == modules.end()) {
+      im = modules.insert(make_pair(key, make_pair(nmodules[chan.did]++,
+						   chan.model))).first;
+    }
+    order[ich].did = chan.did;
+    order[ich].module = im->second.first;
+    order[ich].channel = chan.channel;
+    order[ich].index = ich;
+    modmodel[ich] = im->second.second;
+  }
+  sort(order.begin(), order.end());
+
+  fSorted.resize(fNchans);
+  for(Int_t i=0;i<fNchans;i++) {
+    fSorted[i] = fTable[order[i].index];
+    fSorted[i].model = modmodel[order[i].index];
+  }
+}
+
 //_____________________________________________________________________________
 Int_t THcDetectorMap::FillMap(THaDetMap *detmap, const char *detectorname)
 {
@@ -58,11 +108,6 @@ Int_t THcDetectorMap::FillMap(THaDetMap *detmap, const char *detectorname)
   element map for the detector.
 */
 
-  list<ModChanList>::iterator imod;
-  list<ChaninMod>::iterator ichan;
-  ChaninMod Achan;
-  ModChanList Amod;
-
   // Translate detector name into and ID
   // For now just long if then else.  Could get it from the comments
   // at the beginning of the map file.
@@ -79,60 +124,25 @@ Int_t THcDetectorMap::FillMap(THaDetMap *detmap, const char *detectorname)
     did = 0;
   }
 
-  mlist.clear();
-  //  cout << "fNchans=" << fNchans << endl;
-  for(Int_t ich=0;ich<fNchans;ich++) {
-    if(fTable[ich].did == did) {
-      Int_t roc=fTable[ich].roc;
-      Int_t slot=fTable[ich].slot;
-      Int_t model=fTable[ich].model;
-      //      cout << "ROC=" << fTable[ich].roc << "  SLOT=" << fTable[ich].slot
-      //	   << " CHANNEL=" << fTable[ich].channel << endl;
-      Achan.channel = fTable[ich].channel;
-      Achan.plane = fTable[ich].plane;
-      Achan.counter = fTable[ich].counter;
-      Achan.signal = fTable[ich].signal;
-      Achan.refchan = fTable[ich].refchan;
-      Achan.refindex = fTable[ich].refindex;
-      for(imod=mlist.begin(); imod!= mlist.end(); ++imod) {
-	if((*imod).roc == roc && (*imod).slot == slot) {
-	  //	  cout << "Pushing chan " << Achan.channel << " to " << roc
-	  //	       << " " << slot << endl;
-	  (*imod).clist.push_back(Achan);
-	  break;
-	}
-      }
-      if(imod == mlist.end()) {
-	Amod.roc = roc;
-	Amod.slot = slot;
-	Amod.model = model;
-	Amod.clist.clear();
-	Amod.clist.push_back(Achan);
-	mlist.push_back(Amod);
-	// 	cout << "New module  " << Achan.channel << " to " << roc
-	//	     << " " << slot << endl;
-      }
-    }
-  }
-//  if(mlist.size() <= 0) {
-  if(mlist.empty()) {
+  // Channels of this detector, grouped by module and sorted by channel
+  const vector<Channel>& sorted = fSorted;
+  vector<Channel>::const_iterator ibegin =
+    lower_bound(sorted.begin(), sorted.end(), did, DidBefore);
+  vector<Channel>::const_iterator iend =
+    upper_bound(ibegin, sorted.end(), did, DidAfter);
+  if(ibegin == iend) {
     return(-1);
   }
-  Functor f;
-  for(imod=mlist.begin(); imod!= mlist.end(); ++imod) {
-    //    cout << "Slot " << (*imod).slot << endl;
-    list<ChaninMod> *clistp = &((*imod).clist);
-    clistp->sort(f);//Sort by channel
-  }
+
   // Copy the information to the Hall A style detector map
   // grouping consecutive channels that are all the same plane
   // and signal type
-  for(imod=mlist.begin(); imod!= mlist.end(); ++imod) {
+  vector<Channel>::const_iterator imod, ichan;
+  for(imod=ibegin; imod!=iend; imod=ichan) {
     UShort_t roc = (*imod).roc;
     UShort_t slot = (*imod).slot;
     UInt_t model=(*imod).model;
     //    cout << "Slot " << slot << endl;
-    list<ChaninMod> *clistp = &((*imod).clist);
     Int_t first_chan = -1;
     Int_t last_chan = -1;
     Int_t last_plane = -1;
@@ -141,7 +151,8 @@ Int_t THcDetectorMap::FillMap(THaDetMap *detmap, const char *detectorname)
     Int_t last_counter = -1;
     Int_t last_refchan = -1;
     Int_t last_refindex = -1;
-    for(ichan=clistp->begin(); ichan!=clistp->end(); ++ichan) {
+    for(ichan=imod; ichan!=iend && (*ichan).roc == (*imod).roc
+	  && (*ichan).slot == (*imod).slot; ++ichan) {
       Int_t this_chan = (*ichan).channel;
       Int_t this_counter = (*ichan).counter;
       Int_t this_signal = (*ichan).signal;
@@ -152,7 +163,7 @@ Int_t THcDetectorMap::FillMap(THaDetMap *detmap, const char *detectorname)
 	 || last_plane != this_plane || last_signal!=this_signal
 	 || last_refchan != this_refchan || last_refindex != this_refindex) {
 	if(last_chan >= 0) {
-	  if(ichan != clistp->begin()) {
+	  if(ichan != imod) {
 	    //	    cout << "AddModule " << slot << " " << first_chan <<
 	    //  " " << last_chan << " " << first_counter << endl;
 	    detmap->AddModule((UShort_t)roc, (UShort_t)slot,
@@ -242,8 +253,43 @@ void THcDetectorMap::Load(const char *fname)
  same ROC.  If a reference time is used by several different detectors, this
  mapping line must be duplicated for each detector.  More than one reference
  time may be specified per ROC by mulitple values for index.
+
+ Unless disabled with SetCacheEnabled(kFALSE), the parsed map is saved
+ in fname.cache and loaded from there as long as the MD5 checksum of the
+ map file is unchanged.
 */
 
+
+  string cachefile = string(fname) + ".cache";
+  string sum;
+  if(fUseCache) {
+    TMD5* md5 = TMD5::FileChecksum(fname);
+    if(md5) {
+      sum = md5->AsString();
+      delete md5;
+    }
+  }
+  if(sum.empty() || !ReadCache(cachefile.c_str(), sum)) {
+    Int_t firstid = fNIDs;
+    if(!LoadText(fname)) return;
+    if(!sum.empty()) WriteCache(cachefile.c_str(), sum, firstid);
+  }
+  BuildIndex();
+
+  cout << endl << " Detector ID Map" << endl << endl;
+  for(Int_t i=0; i < fNIDs; i++) {
+    cout << "   ";
+    cout << fIDMap[i].name << " " << fIDMap[i].id << endl;
+  }
+  cout << endl;
+
+}
+
+//_____________________________________________________________________________
+Bool_t THcDetectorMap::LoadText(const char *fname)
+{
+  // Parse the map file.  See Load.
+
   static const char* const whtspc = " \t";
 
   ifstream ifile;
@@ -252,7 +298,7 @@ void THcDetectorMap::Load(const char *fname)
   if(!ifile.is_open()) {
     static const char* const here = "THcDetectorMap::Load";
     Error(here, "error opening detector map file %s",fname);
-    return;			// Need a success/failure argument?
+    return kFALSE;
   }
   string line;
 
@@ -267,6 +313,7 @@ void THcDetectorMap::Load(const char *fname)
   Int_t model=0;
 
   fNchans = 0;
+  fTable.clear();
 
   string::size_type start, pos=0;
 
@@ -391,25 +438,125 @@ void THcDetectorMap::Load(const char *fname)
       }
       delete vararr;		// Discard result of Tokenize
 
-      fTable[fNchans].roc=roc;
-      fTable[fNchans].slot=slot;
-      fTable[fNchans].refchan=refchan;
-      fTable[fNchans].refindex=refindex;
-      fTable[fNchans].channel=channel;
-      fTable[fNchans].did=detector;
-      fTable[fNchans].plane=plane;
-      fTable[fNchans].counter=counter;
-      fTable[fNchans].signal=signal;
-      fTable[fNchans].model=model;
+      Channel chan;
+      chan.roc=roc;
+      chan.slot=slot;
+      chan.refchan=refchan;
+      chan.refindex=refindex;
+      chan.channel=channel;
+      chan.did=detector;
+      chan.plane=plane;
+      chan.counter=counter;
+      chan.signal=signal;
+      chan.model=model;
+      fTable.push_back(chan);
 
       fNchans++;
     }
   }
-  cout << endl << " Detector ID Map" << endl << endl;
-  for(Int_t i=0; i < fNIDs; i++) {
-    cout << "   ";
-    cout << fIDMap[i].name << " " << fIDMap[i].id << endl;
+  return kTRUE;
+}
+
+/*
+  Map cache format (native byte order): UInt_t magic and version, the
+  MD5 checksum of the map file (32 hex characters), UInt_t number of
+  detector IDs defined by the map file, then for each the name (UInt_t
+  length and characters) and the Int_t ID, UInt_t number of channels,
+  then the Channel structs.
+*/
+static const UInt_t kMapCacheMagic   = 0x4d444348; // "HCDM"
+static const UInt_t kMapCacheVersion = 2;
+static const UInt_t kMapSumLength    = 32;
+
+//_____________________________________________________________________________
+Bool_t THcDetectorMap::ReadCache(const char* cachefile, const string& sum)
+{
+  // Load the map from cachefile if it was written for a map file with
+  // MD5 checksum sum
+
+  ifstream ifile(cachefile, ios::in | ios::binary);
+  if(!ifile.is_open()) return kFALSE;
+  string buf((istreambuf_iterator<char>(ifile)), istreambuf_iterator<char>());
+
+  const char* p = buf.data();
+  const char* end = p + buf.length();
+#define GET(var,n) \
+  if((size_t)(end-p) < (n)) return kFALSE; \
+  memcpy((var), p, (n)); p += (n)
+  UInt_t head[2];
+  GET(head, sizeof(head));
+  if(head[0] != kMapCacheMagic || head[1] != kMapCacheVersion) return kFALSE;
+  if((size_t)(end-p) < kMapSumLength
+     || sum.compare(0, string::npos, p, kMapSumLength) != 0) return kFALSE;
+  p += kMapSumLength;
+
+  UInt_t nids, len;
+  GET(&nids, sizeof(nids));
+  if(fNIDs + nids > sizeof(fIDMap)/sizeof(fIDMap[0])) return kFALSE;
+  vector<pair<string,Int_t> > ids(nids);
+  for(UInt_t i=0;i<nids;i++) {
+    GET(&len, sizeof(len));
+    if((size_t)(end-p) < len) return kFALSE;
+    ids[i].first.assign(p, len);
+    p += len;
+    GET(&ids[i].second, sizeof(Int_t));
   }
-  cout << endl;
+  UInt_t nchans;
+  GET(&nchans, sizeof(nchans));
+  if((size_t)(end-p) != nchans*sizeof(Channel)) return kFALSE;
+  fTable.resize(nchans);
+  if(nchans > 0) {
+    GET(&fTable[0], nchans*sizeof(Channel));
+  }
+#undef GET
+  fNchans = nchans;
 
+  for(UInt_t i=0;i<nids;i++) {
+    fIDMap[fNIDs].name = new char [ids[i].first.length()+1];
+    strcpy(fIDMap[fNIDs].name, ids[i].first.c_str());
+    fIDMap[fNIDs++].id = ids[i].second;
+  }
+  cout << "Detector map loaded from " << cachefile << endl;
+  return kTRUE;
+}
+
+//_____________________________________________________________________________
+void THcDetectorMap::WriteCache(const char* cachefile, const string& sum,
+				Int_t firstid) const
+{
+  // Save the map just read from a file with MD5 checksum sum.  Only the
+  // detector IDs from firstid on were defined by that file; earlier ones
+  // come from previous Loads.  Failure to write is not an error; the map
+  // directory may well be read only.
+
+  string buf;
+#define PUT(var,n) buf.append((const char*)(var), (n))
+  UInt_t head[2] = { kMapCacheMagic, kMapCacheVersion };
+  string filesum(sum);
+  filesum.resize(kMapSumLength, ' ');
+  PUT(head, sizeof(head));
+  PUT(filesum.data(), kMapSumLength);
+  UInt_t nids = fNIDs - firstid;
+  PUT(&nids, sizeof(nids));
+  for(Int_t i=firstid;i<fNIDs;i++) {
+    UInt_t len = strlen(fIDMap[i].name);
+    PUT(&len, sizeof(len));
+    PUT(fIDMap[i].name, len);
+    PUT(&fIDMap[i].id, sizeof(Int_t));
+  }
+  UInt_t nchans = fTable.size();
+  PUT(&nchans, sizeof(nchans));
+  if(nchans > 0) {
+    PUT(&fTable[0], nchans*sizeof(Channel));
+  }
+#undef PUT
+
+  string tmpfile = string(cachefile) + Form(".%d", gSystem->GetPid());
+  ofstream ofile(tmpfile.c_str(), ios::out | ios::binary);
+  if(!ofile.is_open()) return;
+  ofile.write(buf.data(), buf.length());
+  ofile.close();
+  if(!ofile || gSystem->Rename(tmpfile.c_str(), cachefile)) {
+    gSystem->Unlink(tmpfile.c_str());
+  }
 }
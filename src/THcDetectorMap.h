@@ -9,7 +9,8 @@
 
 #include "TObject.h"
 #include "THaDetMap.h"
-#include <list>
+#include <vector>
+#include <string>
 
 class THcDetectorMap : public TObject {
 
@@ -20,6 +21,9 @@ class THcDetectorMap : public TObject {
   virtual void Load(const char *fname);
   virtual Int_t FillMap(THaDetMap* detmap, const char* detectorname);
 
+  // Keep a binary copy of each map file next to it (fname.cache)
+  void SetCacheEnabled(Bool_t enable) { fUseCache = enable; }
+
   Int_t fNchans;  // Number of hardware channels
 
   struct Channel { // Mapping for one hardware channel
@@ -34,24 +38,7 @@ class THcDetectorMap : public TObject {
     Int_t signal;
     Int_t model;
   };
-  Channel fTable[10000]; // Big ugly cache of the map file
-
-  struct ChaninMod {
-    Int_t channel;
-    Int_t plane;
-    Int_t counter;
-    Int_t signal;
-    Int_t refchan;
-    Int_t refindex;
-  };
-  struct ModChanList {
-    Int_t roc;
-    Int_t slot;
-    Int_t model;
-    std::list<ChaninMod> clist;
-
-  };
-  std::list<ModChanList> mlist;
+  std::vector<Channel> fTable; // Channels in map file order
 
   struct IDMap {
     char* name;
@@ -60,10 +47,20 @@ class THcDetectorMap : public TObject {
   IDMap fIDMap[50];
   Int_t fNIDs;			/* Number of detector IDs */
 
-  bool compare(const ChaninMod *first, const ChaninMod *second);
-
  protected:
 
+  // fTable ordered the way FillMap groups it: by detector ID, then by
+  // module in order of first appearance, then by channel.  The model of
+  // each entry is that of the first channel of its module.
+  std::vector<Channel> fSorted; //!
+  Bool_t fUseCache;		// Read and write fname.cache
+
+  Bool_t LoadText(const char* fname);
+  void   BuildIndex();
+  Bool_t ReadCache(const char* cachefile, const std::string& sum);
+  void   WriteCache(const char* cachefile, const std::string& sum,
+		    Int_t firstid) const;
+
   ClassDef(THcDetectorMap,0); // Map electronics channels to Detector, Plane, Counter, Signal
 };
 #endif
@@ -26,6 +26,7 @@
 
 #include "THaTrackProj.h"
 
+#include <algorithm>
 #include <cstring>
 #include <cstdio>
 #include <cstdlib>
@@ -49,6 +50,8 @@ THcDriftChamber::THcDriftChamber(
   fChamberNum = chambernum;
 
   fSpacePoints = new TClonesArray("THcSpacePoint",10);
+  fNSpacePointsLost = 0;
+  fWarnedSpacePointCap = kFALSE;
 
   fHMSStyleChambers = 0;	// Default
 }
@@ -60,6 +63,8 @@ THcDriftChamber::THcDriftChamber() :
   // Constructor
   fTrackProj = NULL;
   fSpacePoints = NULL;
+  fNSpacePointsLost = 0;
+  fWarnedSpacePointCap = kFALSE;
   fIsInit = 0;
 
 }
@@ -235,6 +240,7 @@ Int_t THcDriftChamber::DefineVariables( EMode mode )
     { "spacepoints", "Space points of DC",      "fNSpacePoints" },
     { "nhit", "Number of DC hits",  "fNhits" },
     { "trawhit", "Number of True Raw hits", "fN_True_RawHits" },
+    { "sp_lost", "Space points dropped over the limit", "fNSpacePointsLost" },
     { "stub_x", "", "fSpacePoints.THcSpacePoint.GetStubX()" },
     { "stub_xp", "", "fSpacePoints.THcSpacePoint.GetStubXP()" },
     { "stub_y", "", "fSpacePoints.THcSpacePoint.GetStubY()" },
@@ -252,11 +258,17 @@ void THcDriftChamber::ProcessHits( void)
   fNhits = 0;
   fHits.clear();
   fHits.reserve(40);
+  fHitPos.clear();
+  fHitPos.reserve(40);
 
   for(Int_t ip=0;ip<fNPlanes;ip++) {
     TClonesArray* hitsarray = fPlanes[ip]->GetHits();
-    for(Int_t ihit=0;ihit<fPlanes[ip]->GetNHits();ihit++) {
-      fHits.push_back(static_cast<THcDCHit*>(hitsarray->At(ihit)));
+    Int_t nhits = fPlanes[ip]->GetNHits();
+    if(nhits == 0) continue;
+    const Double_t* pos = fPlanes[ip]->GetHitPositions();
+    for(Int_t ihit=0;ihit<nhits;ihit++) {
+      fHits.push_back(static_cast<THcDCHit*>(hitsarray->UncheckedAt(ihit)));
+      fHitPos.push_back(pos[ihit]);
       fNhits++;
     }
   }
@@ -294,7 +306,9 @@ Int_t THcDriftChamber::FindSpacePoints( void )
 3. if not  EasySpacePoint calls FindHardSpacePoints
   1. loops though hits and determines pairs of hits in planes with angles grerater then 17.5 degs
       between them. These are test pairs and stores the x and y position of pair
-  1. Double loops through the test pairs to determine number of pair combinations.
+  1. Bins the test pairs in a grid with cells of size sqrt(fSpacePointCriterion)
+     and compares each test pair with the pairs in the neighbouring cells
+     to determine the pair combinations.
      1. Calculates d2 = (xi -xj)^2 + (yi-yj)^2 from the two pairs (i,j).
      2. If d2 <  fSpacePointCriterion then fills combos structure with pair info
          and increments ncombos.
@@ -324,6 +338,7 @@ Int_t THcDriftChamber::FindSpacePoints( void )
 
 
   fNSpacePoints=0;
+  fNSpacePointsLost=0;
   fEasySpacePoint = 0;
   if(fNhits >= fMinHits && fNhits < fMaxHits) {
     for(Int_t ihit=0;ihit<fNhits;ihit++) {
@@ -343,7 +358,7 @@ Int_t THcDriftChamber::FindSpacePoints( void )
       PlanePInd=XPlanePInd;
     }
     if(fPlanes[PlaneInd]->GetNHits() == 1 && fPlanes[PlanePInd]->GetNHits() == 1
-       && pow( (fHits[plane_hitind]->GetPos() - fHits[planep_hitind]->GetPos()),2)
+       && pow( (fHitPos[plane_hitind] - fHitPos[planep_hitind]),2)
        < fSpacePointCriterion
        && fNhits <= 6) {	// An easy case, probably one hit per plane
       if(fHMSStyleChambers) fEasySpacePoint = FindEasySpacePoint_HMS(plane_hitind, planep_hitind);
@@ -388,7 +403,7 @@ Int_t THcDriftChamber::FindEasySpacePoint_HMS(Int_t yplane_hitind,Int_t yplanep_
   */
 
   Int_t easy_space_point=0;
-  Double_t yt = (fHits[yplane_hitind]->GetPos() + fHits[yplanep_hitind]->GetPos())/2.0;
+  Double_t yt = (fHitPos[yplane_hitind] + fHitPos[yplanep_hitind])/2.0;
   Double_t xt = 0.0;
   Int_t num_xhits = 0;
   Double_t x_pos[MAX_HITS_PER_POINT];
@@ -397,7 +412,7 @@ Int_t THcDriftChamber::FindEasySpacePoint_HMS(Int_t yplane_hitind,Int_t yplanep_
     THcDCHit* thishit = fHits[ihit];
     if(ihit!=yplane_hitind && ihit!=yplanep_hitind) { // x-like hit
       // ysp and xsp are from h_generate_geometry
-      x_pos[ihit] = (thishit->GetPos()
+      x_pos[ihit] = (fHitPos[ihit]
 		     -yt*thishit->GetWirePlane()->GetYsp())
 	/thishit->GetWirePlane()->GetXsp();
       xt += x_pos[ihit];
@@ -439,7 +454,7 @@ Int_t THcDriftChamber::FindEasySpacePoint_SOS(Int_t xplane_hitind,Int_t xplanep_
   */
 
   Int_t easy_space_point=0;
-  Double_t xt = (fHits[xplane_hitind]->GetPos() + fHits[xplanep_hitind]->GetPos())/2.0;
+  Double_t xt = (fHitPos[xplane_hitind] + fHitPos[xplanep_hitind])/2.0;
   Double_t yt = 0.0;
   Int_t num_yhits = 0;
   Double_t y_pos[MAX_HITS_PER_POINT];
@@ -448,7 +463,7 @@ Int_t THcDriftChamber::FindEasySpacePoint_SOS(Int_t xplane_hitind,Int_t xplanep_
     THcDCHit* thishit = fHits[ihit];
     if(ihit!=xplane_hitind && ihit!=xplanep_hitind) { // y-like hit
       // ysp and xsp are from h_generate_geometry
-      y_pos[ihit] = (thishit->GetPos()
+      y_pos[ihit] = (fHitPos[ihit]
 		     -xt*thishit->GetWirePlane()->GetXsp())
 	/thishit->GetWirePlane()->GetYsp();
       yt += y_pos[ihit];
@@ -482,68 +497,141 @@ Int_t THcDriftChamber::FindEasySpacePoint_SOS(Int_t xplane_hitind,Int_t xplanep_
 // Generic
 Int_t THcDriftChamber::FindHardSpacePoints()
 {
-  Int_t MAX_NUMBER_PAIRS=1000; // Where does this get set?
-  struct Pair {
-    THcDCHit* hit1;
-    THcDCHit* hit2;
-    Double_t x, y;
-  };
-  Pair pairs[MAX_NUMBER_PAIRS];
-  //
-  Int_t ntest_points=0;
+  // Intersections of all pairs of hits in planes with sufficiently
+  // different wire angles
+  fHitPairs.clear();
   for(Int_t ihit1=0;ihit1<fNhits-1;ihit1++) {
     THcDCHit* hit1=fHits[ihit1];
     THcDriftChamberPlane* plane1 = hit1->GetWirePlane();
     for(Int_t ihit2=ihit1+1;ihit2<fNhits;ihit2++) {
-      if(ntest_points < MAX_NUMBER_PAIRS) {
-	THcDCHit* hit2=fHits[ihit2];
-	THcDriftChamberPlane* plane2 = hit2->GetWirePlane();
-	Double_t determinate = plane1->GetXsp()*plane2->GetYsp()
-	  -plane1->GetYsp()*plane2->GetXsp();
-	if(TMath::Abs(determinate) > 0.3) { // 0.3 is sin(alpha1-alpha2)=sin(17.5)
-	  pairs[ntest_points].hit1 = hit1;
-	  pairs[ntest_points].hit2 = hit2;
-	  pairs[ntest_points].x = (hit1->GetPos()*plane2->GetYsp()
-				   - hit2->GetPos()*plane1->GetYsp())
-	    /determinate;
-	  pairs[ntest_points].y = (hit2->GetPos()*plane1->GetXsp()
-				   - hit1->GetPos()*plane2->GetXsp())
-	    /determinate;
-	  ntest_points++;
-	}
+      THcDCHit* hit2=fHits[ihit2];
+      THcDriftChamberPlane* plane2 = hit2->GetWirePlane();
+      Double_t determinate = plane1->GetXsp()*plane2->GetYsp()
+	-plane1->GetYsp()*plane2->GetXsp();
+      if(TMath::Abs(determinate) > 0.3) { // 0.3 is sin(alpha1-alpha2)=sin(17.5)
+	HitPair pair;
+	pair.hit1 = hit1;
+	pair.hit2 = hit2;
+	pair.x = (fHitPos[ihit1]*plane2->GetYsp()
+		  - fHitPos[ihit2]*plane1->GetYsp())
+	  /determinate;
+	pair.y = (fHitPos[ihit2]*plane1->GetXsp()
+		  - fHitPos[ihit1]*plane2->GetXsp())
+	  /determinate;
+	fHitPairs.push_back(pair);
       }
     }
   }
-  Int_t ncombos=0;
-  struct Combo {
-    Pair* pair1;
-    Pair* pair2;
-  };
-  Combo combos[10*MAX_NUMBER_PAIRS];
+  Int_t ntest_points = fHitPairs.size();
+
+  // Two intersections make a combo if they are within
+  // sqrt(fSpacePointCriterion) of each other.  Bucket the intersections
+  // in a grid with cells at least that large so that each intersection
+  // only needs to be compared with those in the neighbouring cells.
+  // (The small margin keeps rounding in the cell index from pushing two
+  // close intersections into non-adjacent cells.)
+  Double_t cellsize = TMath::Sqrt(fSpacePointCriterion)*(1.0+1.0e-6);
+  if(!(cellsize > 0.0)) cellsize = 1.0;
+  Double_t xmin=0.0, xmax=0.0, ymin=0.0, ymax=0.0;
+  Bool_t first = kTRUE;
+  for(Int_t ipair=0;ipair<ntest_points;ipair++) {
+    const HitPair& pair = fHitPairs[ipair];
+    // Non-finite intersections can never pass the distance cut
+    if(!TMath::Finite(pair.x) || !TMath::Finite(pair.y)) continue;
+    if(first) {
+      xmin = xmax = pair.x;
+      ymin = ymax = pair.y;
+      first = kFALSE;
+    } else {
+      if(pair.x < xmin) xmin = pair.x;
+      if(pair.x > xmax) xmax = pair.x;
+      if(pair.y < ymin) ymin = pair.y;
+      if(pair.y > ymax) ymax = pair.y;
+    }
+  }
+  // Larger cells only cost extra comparisons, so keep the number of
+  // cells in proportion to the number of intersections.
+  Double_t maxcells = 4.0*ntest_points + 16.0;
+  Int_t nxcells, nycells;
+  while(kTRUE) {
+    Double_t nx = TMath::Floor(xmax/cellsize - xmin/cellsize) + 1.0;
+    Double_t ny = TMath::Floor(ymax/cellsize - ymin/cellsize) + 1.0;
+    if(nx*ny <= maxcells) {
+      nxcells = static_cast<Int_t>(nx);
+      nycells = static_cast<Int_t>(ny);
+      break;
+    }
+    cellsize *= 2.0;
+  }
+  Int_t ncells = nxcells*nycells;
+  fPairCell.assign(ntest_points, -1);
+  fCellStart.assign(ncells+1, 0);
+  for(Int_t ipair=0;ipair<ntest_points;ipair++) {
+    const HitPair& pair = fHitPairs[ipair];
+    if(!TMath::Finite(pair.x) || !TMath::Finite(pair.y)) continue;
+    Int_t ix = TMath::Min(static_cast<Int_t>(pair.x/cellsize - xmin/cellsize),
+			  nxcells-1);
+    Int_t iy = TMath::Min(static_cast<Int_t>(pair.y/cellsize - ymin/cellsize),
+			  nycells-1);
+    fPairCell[ipair] = ix*nycells + iy;
+    fCellStart[fPairCell[ipair]+1]++;
+  }
+  for(Int_t icell=0;icell<ncells;icell++) {
+    fCellStart[icell+1] += fCellStart[icell];
+  }
+  // Pairs within a cell stay in increasing index order
+  fCellPairs.resize(fCellStart[ncells]);
+  fCellFill.assign(fCellStart.begin(), fCellStart.end()-1);
+  for(Int_t ipair=0;ipair<ntest_points;ipair++) {
+    if(fPairCell[ipair] >= 0) {
+      fCellPairs[fCellFill[fPairCell[ipair]]++] = ipair;
+    }
+  }
+
+  // Combos are listed in the same (ipair1, ipair2) order as a full
+  // comparison of all pairs would give, so the space points built from
+  // them do not depend on the grid.
+  fPairCombos.clear();
   for(Int_t ipair1=0;ipair1<ntest_points-1;ipair1++) {
-    for(Int_t ipair2=ipair1+1;ipair2<ntest_points;ipair2++) {
-      if(ncombos < 10*MAX_NUMBER_PAIRS) {
-	Double_t dist2 = pow(pairs[ipair1].x - pairs[ipair2].x,2)
-	  + pow(pairs[ipair1].y - pairs[ipair2].y,2);
-	if(dist2 <= fSpacePointCriterion) {
-	  combos[ncombos].pair1 = &pairs[ipair1];
-	  combos[ncombos].pair2 = &pairs[ipair2];
-	  ncombos++;
+    Int_t cell = fPairCell[ipair1];
+    if(cell < 0) continue;
+    Int_t ix = cell/nycells;
+    Int_t iy = cell%nycells;
+    fNeighbours.clear();
+    for(Int_t jx=TMath::Max(ix-1,0);jx<=TMath::Min(ix+1,nxcells-1);jx++) {
+      for(Int_t jy=TMath::Max(iy-1,0);jy<=TMath::Min(iy+1,nycells-1);jy++) {
+	Int_t jcell = jx*nycells + jy;
+	for(Int_t k=fCellStart[jcell];k<fCellStart[jcell+1];k++) {
+	  if(fCellPairs[k] > ipair1) fNeighbours.push_back(fCellPairs[k]);
 	}
       }
     }
+    std::sort(fNeighbours.begin(), fNeighbours.end());
+    const HitPair& pair1 = fHitPairs[ipair1];
+    for(UInt_t ineighbour=0;ineighbour<fNeighbours.size();ineighbour++) {
+      Int_t ipair2 = fNeighbours[ineighbour];
+      const HitPair& pair2 = fHitPairs[ipair2];
+      Double_t dist2 = pow(pair1.x - pair2.x,2)
+	+ pow(pair1.y - pair2.y,2);
+      if(dist2 <= fSpacePointCriterion) {
+	fPairCombos.push_back(std::make_pair(ipair1, ipair2));
+      }
+    }
   }
+  Int_t ncombos = fPairCombos.size();
   // Loop over all valid combinations and build space points
   //if (fhdebugflagpr) cout << "looking for hard Space Point combos = " << ncombos << endl;
   for(Int_t icombo=0;icombo<ncombos;icombo++) {
+    const HitPair& pair1 = fHitPairs[fPairCombos[icombo].first];
+    const HitPair& pair2 = fHitPairs[fPairCombos[icombo].second];
     THcDCHit* hits[4];
-    hits[0]=combos[icombo].pair1->hit1;
-    hits[1]=combos[icombo].pair1->hit2;
-    hits[2]=combos[icombo].pair2->hit1;
-    hits[3]=combos[icombo].pair2->hit2;
+    hits[0]=pair1.hit1;
+    hits[1]=pair1.hit2;
+    hits[2]=pair2.hit1;
+    hits[3]=pair2.hit2;
     // Get Average Space point xt, yt
-    Double_t xt = (combos[icombo].pair1->x + combos[icombo].pair2->x)/2.0;
-    Double_t yt = (combos[icombo].pair1->y + combos[icombo].pair2->y)/2.0;
+    Double_t xt = (pair1.x + pair2.x)/2.0;
+    Double_t yt = (pair1.y + pair2.y)/2.0;
     // Loop over space points
     
     if(fNSpacePoints > 0) {
@@ -595,6 +683,15 @@ Int_t THcDriftChamber::FindHardSpacePoints()
 	}
       }// End of loop over existing space points
       // Create a new space point if more than 2*space_point_criteria
+      if(add_flag && fNSpacePoints >= MAX_SPACE_POINTS) {
+	fNSpacePointsLost++;
+	if(!fWarnedSpacePointCap) {
+	  static const char* const here = "FindHardSpacePoints";
+	  Warning(Here(here), "More than %d space points, dropping the "
+		  "rest (counted in sp_lost)", MAX_SPACE_POINTS);
+	  fWarnedSpacePointCap = kTRUE;
+	}
+      }
       if(fNSpacePoints < MAX_SPACE_POINTS) {
 	if(add_flag) {
           //if (fhdebugflagpr) cout << " add glag = " << add_flag << " space pts =  " << fNSpacePoints << endl ;
@@ -1177,6 +1274,45 @@ void THcDriftChamber::LeftRight()
     }
     Int_t nplaneshit = Count1Bits(bitpat);
     //if (fhdebugflagpr) cout << " num of pm = " << nplusminus << " num of hits =" << nhits << endl;
+
+    // Everything in the stub fit that does not depend on the left/right
+    // combination is computed once per space point: the fit contributions
+    // of each hit for both signs, the weighted stub coefficients and the
+    // inverted normal matrix for this plane pattern.  FindStub then only
+    // has to add up the terms of the chosen signs.
+    Double_t hitterms[8*nhits+1];	// [ihit][sign][TT0,TT1,TT2,dpos/sigma]
+    Double_t hitcoefs[3*nhits+1];
+    Double_t aa3inv[9];
+    Bool_t havefit = kFALSE;
+    if (nplaneshit >= fNPlanes-2) {
+      std::map<int,TMatrixD>::const_iterator it = fAA3Inv.find(bitpat);
+      if(it != fAA3Inv.end()) {
+	const Double_t* m = it->second.GetMatrixArray();
+	for(Int_t i=0;i<9;i++) aa3inv[i] = m[i];
+	havefit = kTRUE;
+      }
+      for(Int_t ihit=0;ihit<nhits;ihit++) {
+	Int_t pindex = plane_list[ihit];
+	Double_t pos = sp->GetHit(ihit)->GetPos();
+	Double_t dist = sp->GetHitDist(ihit);
+	for(Int_t isign=0;isign<2;isign++) {
+	  Int_t pm = (isign==0) ? -1 : 1;
+	  Double_t dpos = pos + pm*dist - fPsi0[pindex];
+	  Double_t* terms = &hitterms[8*ihit+4*isign];
+	  for(Int_t index=0;index<3;index++) {
+	    terms[index] = dpos*fStubCoefs[pindex][index]/fSigma[pindex];
+	  }
+	  terms[3] = dpos/fSigma[pindex];
+	}
+	for(Int_t index=0;index<3;index++) {
+	  hitcoefs[3*ihit+index] = fStubCoefs[pindex][index];
+	}
+      }
+    }
+    if(!havefit && nplaneshit >= fNPlanes-2) {
+      if (fhdebugflagpr) cout << "THcDriftChamber::LeftRight() no stub matrix for plane pattern " << bitpat << endl;
+      nplusminus = 0;
+    }
     // Use bit value of integer word to set + or -
     // Loop over all combinations of left right.
     for(Int_t pmloop=0;pmloop<nplusminus;pmloop++) {
@@ -1195,8 +1331,11 @@ void THcDriftChamber::LeftRight()
 	}
       }
       if ( (nplaneshit >= fNPlanes-1) || (nplaneshit >= fNPlanes-2 && !fHMSStyleChambers)) {
+	// A combination whose chi2 can no longer beat minchi2 is never
+	// selected, so its chi2 sum may be abandoned early.
 	Double_t chi2;
-	chi2 = FindStub(nhits, sp,plane_list, bitpat, plusminus, stub);
+	chi2 = FindStub(nhits, hitterms, hitcoefs, aa3inv, plusminus, stub,
+			fdebugstubchisq ? -1.0 : minchi2);
 	if (fdebugstubchisq) cout << " pmloop = " << pmloop << " chi2 = " << chi2 << endl;
 	if(chi2 < minchi2) {
 	  if (fStubMaxXPDiff<100. ) {
@@ -1238,7 +1377,7 @@ void THcDriftChamber::LeftRight()
 	}
 	///////////////
       } else if (nplaneshit >= fNPlanes-2 && fHMSStyleChambers) { // Two planes missing
-	Double_t chi2 = FindStub(nhits, sp,plane_list, bitpat, plusminus, stub);
+	Double_t chi2 = FindStub(nhits, hitterms, hitcoefs, aa3inv, plusminus, stub);
 	//if(debugging)
 	//if (fhdebugflagpr) cout << "pmloop=" << pmloop << " Chi2=" << chi2 << endl;
 	// Isn't this a bad idea, doing == with reals
@@ -1305,47 +1444,52 @@ void THcDriftChamber::LeftRight()
   // Option to print stubs
 }
 //_____________________________________________________________________________
-Double_t THcDriftChamber::FindStub(Int_t nhits, THcSpacePoint *sp,
-				       Int_t* plane_list, UInt_t bitpat,
-				       Int_t* plusminus, Double_t* stub)
+Double_t THcDriftChamber::FindStub(Int_t nhits, const Double_t* hitterms,
+				   const Double_t* hitcoefs,
+				   const Double_t* aa3inv,
+				   const Int_t* plusminus, Double_t* stub,
+				   Double_t chi2max)
 {
   // For a given combination of L/R, fit a stub to the space point
   // This method does a linear least squares fit of a line to the
   // hits in an individual chamber.  It assumes that the y slope is 0
   // The wire coordinate is calculated by
   //          wire center + plusminus*(drift distance).
-  // Method is called in a loop over all combinations of plusminus
-  Double_t zeros[] = {0.0,0.0,0.0};
-  TVectorD TT; TT.Use(3, zeros); // X, X', Y
-  Double_t dpos[nhits];
+  // Method is called in a loop over all combinations of plusminus.
+  // hitterms holds, per hit and for the -1 and +1 sign, the contributions
+  // dpos*coef/sigma to the fit vector followed by dpos/sigma.  hitcoefs
+  // are the stub coefficients of each hit's plane and aa3inv the (row
+  // major) inverted normal matrix of the plane pattern, all set up once
+  // per space point in LeftRight.
+  // If chi2max >= 0, the chi2 sum is abandoned as soon as it reaches
+  // chi2max and the partial (>= chi2max) value is returned.
+  Double_t TT[3] = {0.0,0.0,0.0}; // X, X', Y
   for(Int_t ihit=0;ihit<nhits; ihit++) {
-    dpos[ihit] = sp->GetHit(ihit)->GetPos()
-      + plusminus[ihit]*sp->GetHitDist(ihit)
-      - fPsi0[plane_list[ihit]];
-    for(Int_t index=0;index<3;index++) {
-      TT[index]+= dpos[ihit]*fStubCoefs[plane_list[ihit]][index]
-	/fSigma[plane_list[ihit]];
-    }
+    const Double_t* terms = &hitterms[8*ihit + (plusminus[ihit]>0 ? 4 : 0)];
+    TT[0] += terms[0];
+    TT[1] += terms[1];
+    TT[2] += terms[2];
   }
-  //  fAA3Inv[bitpat].Print();
-  //  if (fhdebugflagpr) cout << TT[0] << " " << TT[1] << " " << TT[2] << endl;
-  //  TT.Print();
-
-  TT *= fAA3Inv[bitpat];
-  // if (fhdebugflagpr) cout << TT[0] << " " << TT[1] << " " << TT[2] << endl;
 
   // Calculate Chi2.  Remember one power of sigma is in fStubCoefs
-  stub[0] = TT[0];
-  stub[1] = TT[1];
-  stub[2] = TT[2];
+  for(Int_t i=0;i<3;i++) {
+    Double_t sum = 0.0;
+    for(Int_t j=0;j<3;j++) {
+      sum += aa3inv[3*i+j]*TT[j];
+    }
+    stub[i] = sum;
+  }
   stub[3] = 0.0;
   Double_t chi2=0.0;
   for(Int_t ihit=0;ihit<nhits; ihit++) {
-    chi2 += pow( dpos[ihit]/fSigma[plane_list[ihit]]
-		 - fStubCoefs[plane_list[ihit]][0]*stub[0]
-		 - fStubCoefs[plane_list[ihit]][1]*stub[1]
-		 - fStubCoefs[plane_list[ihit]][2]*stub[2]
-		 , 2);
+    const Double_t* terms = &hitterms[8*ihit + (plusminus[ihit]>0 ? 4 : 0)];
+    const Double_t* coefs = &hitcoefs[3*ihit];
+    Double_t resid = terms[3]
+      - coefs[0]*stub[0]
+      - coefs[1]*stub[1]
+      - coefs[2]*stub[2];
+    chi2 += pow(resid, 2);
+    if(chi2max >= 0.0 && chi2 >= chi2max) break;
   }
   return(chi2);
 }
@@ -13,6 +13,7 @@
 #include "TMatrixD.h"
 
 #include <map>
+#include <utility>
 #include <vector>
 
 #define MAX_SPACE_POINTS 100
@@ -125,14 +126,32 @@ protected:
   void       ChooseSingleHit(void);
   void       SelectSpacePoints(void);
   UInt_t     Count1Bits(UInt_t x);
-  Double_t   FindStub(Int_t nhits, THcSpacePoint *sp,
-		      Int_t* plane_list, UInt_t bitpat,
-		      Int_t* plusminus, Double_t* stub);
+  static Double_t FindStub(Int_t nhits, const Double_t* hitterms,
+			   const Double_t* hitcoefs, const Double_t* aa3inv,
+			   const Int_t* plusminus, Double_t* stub,
+			   Double_t chi2max=-1.0);
 
   std::vector<THcDCHit*> fHits;	/* All hits for this chamber */
+  std::vector<Double_t> fHitPos;	/* Wire positions of fHits */
   TClonesArray *fSpacePoints;
   Int_t fNSpacePoints;
   Int_t fEasySpacePoint;	/* This event is an easy space point */
+  Int_t fNSpacePointsLost;	/* Space points dropped at MAX_SPACE_POINTS */
+  Bool_t fWarnedSpacePointCap;
+
+  // Work space of FindHardSpacePoints, kept between events
+  struct HitPair {
+    THcDCHit* hit1;
+    THcDCHit* hit2;
+    Double_t x, y;		/* Intersection of the two wires */
+  };
+  std::vector<HitPair> fHitPairs;	//!
+  std::vector<Int_t> fPairCell;		//! Grid cell of each pair (-1 if none)
+  std::vector<Int_t> fCellStart;	//! Start of each cell in fCellPairs
+  std::vector<Int_t> fCellPairs;	//! Pair indices ordered by cell
+  std::vector<Int_t> fCellFill;		//! Fill position of each cell
+  std::vector<Int_t> fNeighbours;	//! Pairs near the current pair
+  std::vector<std::pair<Int_t,Int_t> > fPairCombos; //! Pairs of close pairs
 
   Double_t* stubcoef[4];
   std::map<int,TMatrixD> fAA3Inv;
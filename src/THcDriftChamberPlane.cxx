@@ -312,6 +312,9 @@ void THcDriftChamberPlane::Clear( Option_t* )
   // Clears the hit lists
   fHits->Clear();
   fRawHits->Clear();
+  fHitTime.clear();
+  fHitDist.clear();
+  fHitPos.clear();
 }
 
 //_____________________________________________________________________________
@@ -348,10 +351,17 @@ Int_t THcDriftChamberPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
      Extract the data for this plane from hit list
      Assumes that the hit list is sorted by plane, so we stop when the
      plane doesn't agree and return the index for the next hit.
+
+     The THcDCHit objects in fHits and fRawHits are constructed once and
+     reused in later events.  Drift distances are only computed for the
+     hits in the TDC window, in SubtractStartTime.
   */
 
   fHits->Clear();
   fRawHits->Clear();
+  fHitTime.clear();
+  fHitDist.clear();
+  fHitPos.clear();
 
   Int_t nrawhits = rawhits->GetLast()+1;
   fNRawhits=0;
@@ -372,15 +382,20 @@ Int_t THcDriftChamberPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
       Int_t rawnorefcorrtdc = hit->GetRawTdcHit().GetTimeRaw(mhit); // Get the ref time subtracted time
       Int_t rawtdc = hit->GetRawTdcHit().GetTime(mhit); // Get the ref time subtracted time
       Double_t time = - rawtdc*fNSperChan + fPlaneTimeZero - wire->GetTOffset(); // fNSperChan > 0 for 1877
-      new( (*fRawHits)[nextRawHit++] ) THcDCHit(wire, rawnorefcorrtdc,rawtdc, time, this);	
+      static_cast<THcDCHit*>(fRawHits->ConstructedAt(nextRawHit++))
+	->Set(wire, rawnorefcorrtdc, rawtdc, time, this);
      if(rawtdc < fTdcWinMin) {
 	// Increment early counter  (Actually late because TDC is backward)
       } else if (rawtdc > fTdcWinMax) {
 	// Increment late count
       } else {
 	if (First_Hit_In_Window) {
-	new( (*fHits)[nextHit++] ) THcDCHit(wire, rawnorefcorrtdc,rawtdc, time, this);
-	First_Hit_In_Window = kFALSE;
+	  static_cast<THcDCHit*>(fHits->ConstructedAt(nextHit++))
+	    ->Set(wire, rawnorefcorrtdc, rawtdc, time, this);
+	  fHitTime.push_back(time);
+	  fHitDist.push_back(0.0);
+	  fHitPos.push_back(wire->GetPos());
+	  First_Hit_In_Window = kFALSE;
 	}
       }
     }
@@ -392,11 +407,18 @@ Int_t THcDriftChamberPlane::SubtractStartTime()
 {
   Double_t StartTime = 0.0;
   if( fglHod ) StartTime = fglHod->GetStartTime();
-  for(Int_t ihit=0;ihit<GetNHits();ihit++) { 
-    THcDCHit *thishit = (THcDCHit*) fHits->At(ihit);
-    Double_t temptime= thishit->GetTime()-StartTime;
-    thishit->SetTime(temptime);
-    thishit->ConvertTimeToDist();
+  Int_t nhits = GetNHits();
+  for(Int_t ihit=0;ihit<nhits;ihit++) {
+    fHitTime[ihit] -= StartTime;
+  }
+  // All wires of the plane share fTTDConv, so convert the whole plane at once
+  if(fTTDConv && nhits > 0) {
+    fTTDConv->ConvertTimeToDist(&fHitTime[0], &fHitDist[0], nhits);
+  }
+  for(Int_t ihit=0;ihit<nhits;ihit++) {
+    THcDCHit *thishit = (THcDCHit*) fHits->UncheckedAt(ihit);
+    thishit->SetTime(fHitTime[ihit]);
+    thishit->SetDist(fHitDist[ihit]);
   }
   return 0;
 }
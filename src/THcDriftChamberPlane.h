@@ -15,6 +15,7 @@
 #include "THaSubDetector.h"
 #include "TClonesArray.h"
 #include <cassert>
+#include <vector>
 
 class THaEvData;
 class THcDCWire;
@@ -56,6 +57,9 @@ public:
   Int_t         GetNRawhits() const {return fNRawhits; }
   TClonesArray* GetHits()  const { return fHits; }
 
+  // Wire positions of the hits, in the same order as GetHits()
+  const Double_t* GetHitPositions() const { return fHitPos.empty() ? 0 : &fHitPos[0]; }
+
   Int_t        GetPlaneNum() const { return fPlaneNum; }
   Int_t        GetChamberNum() const { return fChamberNum; }
   void         SetPlaneIndex(Int_t index) { fPlaneIndex = index; }
@@ -81,10 +85,15 @@ protected:
 
   TClonesArray* fParentHitList;
 
-  TClonesArray* fHits;
+  TClonesArray* fHits;		// Pooled THcDCHit objects, reused each event
   TClonesArray* fRawHits;
   TClonesArray* fWires;
 
+  // Per hit columns for the hits in fHits.  Capacity is kept between events.
+  std::vector<Double_t> fHitPos;	// Wire positions
+  std::vector<Double_t> fHitTime;	// Drift times, input to the batch
+  std::vector<Double_t> fHitDist;	// time to distance conversion only
+
   Int_t fVersion;
   Int_t fWireOrder;
   Int_t fPlaneNum;
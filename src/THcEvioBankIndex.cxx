@@ -0,0 +1,93 @@
+/** \class THcEvioBankIndex
+    \ingroup Base
+
+    \brief Single-pass index of the banks in a raw EVIO event buffer
+
+    Build() walks the event once, the same way the Hall C event handlers
+    used to walk it by hand: a bank of banks (header type 0x10) is
+    entered, a bank of 32 bit integers (type 0x01, excluding the 0xC0000100
+    filler header) is recorded and skipped, and any other bank is skipped.
+    Every bank visited becomes an entry {offset, length, header, tag, num,
+    kind, roc, parent} pointing into the caller's buffer, so nothing is
+    copied.
+
+    Banks of banks other than the event bank itself are ROC banks; the
+    banks that follow them carry their tag as roc and their entry index
+    as parent.
+
+    Handlers then loop over the entries, or use Find() to get the integer
+    banks with a given tag (and optionally ROC).
+*/
+
+#include "THcEvioBankIndex.h"
+
+//_____________________________________________________________________________
+THcEvioBankIndex::THcEvioBankIndex() : fBuffer(0)
+{
+  fBanks.reserve(64);
+}
+
+//_____________________________________________________________________________
+Int_t THcEvioBankIndex::Build( UInt_t* buffer )
+{
+  /// Index all banks in buffer.  Returns the number of banks found.
+
+  fBuffer = buffer;
+  fBanks.clear();
+  if(!buffer) return 0;
+
+  UInt_t evlen = buffer[0];
+  UInt_t ip = 0;
+  Int_t roc = -1;
+  Int_t parent = -1;
+  while(ip < evlen) {
+    Bank bank;
+    bank.offset = ip;
+    bank.length = buffer[ip];
+    // A bank must fit in what is left of the event (ip+length <= evlen).
+    // Stop on a corrupt length instead of stepping past the buffer.
+    if(bank.length == 0 || bank.length > evlen-ip) break;
+    bank.header = buffer[ip+1];
+    bank.tag = (bank.header>>16) & 0xffff;
+    bank.num = bank.header & 0xff;
+    if((bank.header & 0xff00) == 0x1000) {
+      bank.kind = kBankOfBanks;
+      if(bank.length < evlen) {	// Don't treat the event bank as a ROC
+	roc = bank.tag;
+	parent = fBanks.size();
+      }
+    } else if(((bank.header & 0xff00) == 0x100) && (bank.header != 0xC0000100)) {
+      bank.kind = kUInt32;
+    } else {
+      bank.kind = kOther;
+    }
+    bank.roc = roc;
+    bank.parent = parent;
+    fBanks.push_back(bank);
+
+    if(bank.kind == kBankOfBanks) {
+      ip += 2;			// Step into the first contained bank
+    } else {
+      ip += bank.length+1;	// Cannot wrap: length <= evlen-ip
+    }
+  }
+  return fBanks.size();
+}
+
+//_____________________________________________________________________________
+Int_t THcEvioBankIndex::Find( UInt_t tag, Int_t roc, Int_t start ) const
+{
+  /**
+     Return the index of the first integer bank at or after start with the
+     given tag (and ROC tag, if roc >= 0), or -1 if there is none.
+  */
+  for(Int_t i=start;i<(Int_t)fBanks.size();i++) {
+    const Bank& bank = fBanks[i];
+    if(bank.kind == kUInt32 && bank.tag == tag && (roc < 0 || bank.roc == roc)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+ClassImp(THcEvioBankIndex)
@@ -0,0 +1,56 @@
+#ifndef ROOT_THcEvioBankIndex
+#define ROOT_THcEvioBankIndex
+
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// THcEvioBankIndex                                                          //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+#include <vector>
+
+class THcEvioBankIndex {
+
+public:
+
+  enum EKind { kBankOfBanks, kUInt32, kOther };
+
+  struct Bank {
+    UInt_t offset;   // Word index of the bank length word in the buffer
+    UInt_t length;   // Bank length word (header plus data words)
+    UInt_t header;   // Raw bank header word
+    UInt_t tag;
+    UInt_t num;
+    Int_t  kind;     // EKind
+    Int_t  roc;      // Tag of the enclosing ROC bank (-1 if none)
+    Int_t  parent;   // Index of the enclosing ROC bank entry (-1 if none)
+  };
+
+  THcEvioBankIndex();
+  virtual ~THcEvioBankIndex() {}
+
+  Int_t  Build( UInt_t* buffer );
+  void   Clear() { fBuffer = 0; fBanks.clear(); }
+
+  Int_t       GetNBanks() const { return fBanks.size(); }
+  const Bank& GetBank( Int_t i ) const { return fBanks[i]; }
+  UInt_t*     GetBuffer() const { return fBuffer; }
+
+  // First data word, one past the last data word, and data word count
+  UInt_t* GetData( Int_t i ) const { return fBuffer+fBanks[i].offset+2; }
+  UInt_t* GetEnd( Int_t i ) const
+  { return fBuffer+fBanks[i].offset+1+fBanks[i].length; }
+  UInt_t  GetDataLength( Int_t i ) const { return fBanks[i].length-1; }
+
+  Int_t Find( UInt_t tag, Int_t roc=-1, Int_t start=0 ) const;
+
+protected:
+
+  UInt_t* fBuffer;             //! Buffer indexed by the last Build()
+  std::vector<Bank> fBanks;    //! Banks in buffer order
+
+  ClassDef(THcEvioBankIndex,0)  // Index of the banks in an EVIO event
+};
+
+#endif
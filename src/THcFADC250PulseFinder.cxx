@@ -0,0 +1,118 @@
+/** \class THcFADC250PulseFinder
+    \ingroup DetSupport
+
+ Software emulation of the pulse processing of the JLab FADC250 firmware
+ (modes 9 and 10) on the raw window samples.
+
+ The pedestal is the sum of the first NPED samples.  A pulse starts at the
+ first sample more than the threshold (TET) above the pedestal average.
+ The integral is the sum of the NSB samples before and the NSA samples
+ from the crossing on, truncated at the ends of the window.  The peak is
+ the first local maximum at or after the crossing, and the time is where
+ the leading edge crosses halfway between pedestal and peak, interpolated
+ between samples in units of 1/64 sample as in the firmware data.  After a
+ pulse the search resumes at the end of its integration window, and the
+ signal has to fall back below threshold before the next crossing.  Up to
+ NP pulses are reported.
+
+ The results have the same units as the firmware pulse data, so they can
+ be stored with THcRawHit::SetDataTimePedestalPeak.  All arithmetic is
+ on integers in units of 1/NPED so the pedestal average is not rounded,
+ and nothing is allocated per call.
+*/
+
+#include "THcFADC250PulseFinder.h"
+
+//_____________________________________________________________________________
+THcFADC250PulseFinder::THcFADC250PulseFinder(Int_t nsa, Int_t nsb, Int_t nped,
+					     UInt_t maxpulses) :
+  fPedestal(0), fNPulses(0)
+{
+  SetParams(nsa, nsb, nped, maxpulses);
+}
+
+//_____________________________________________________________________________
+THcFADC250PulseFinder::~THcFADC250PulseFinder()
+{
+}
+
+//_____________________________________________________________________________
+void THcFADC250PulseFinder::SetParams(Int_t nsa, Int_t nsb, Int_t nped,
+				      UInt_t maxpulses)
+{
+  // Set the firmware parameters.  Negative values are treated as zero and
+  // maxpulses is limited to kMaxPulses.
+
+  fNSA = (nsa > 0) ? nsa : 0;
+  fNSB = (nsb > 0) ? nsb : 0;
+  fNPED = (nped > 0) ? nped : 0;
+  fMaxPulses = (maxpulses < kMaxPulses) ? maxpulses : kMaxPulses;
+}
+
+//_____________________________________________________________________________
+UInt_t THcFADC250PulseFinder::FindPulses(const Int_t* samples, UInt_t nsamples,
+					 Int_t threshold)
+{
+  // Find the pulses in nsamples window samples.  threshold is in ADC
+  // channels above the pedestal average.  Returns the number of pulses.
+
+  fNPulses = 0;
+  fPedestal = 0;
+  const Int_t n = nsamples;
+  const Int_t nped = (fNPED < n) ? fNPED : n;
+  if(nped <= 0) return 0;
+
+  for(Int_t i=0;i<nped;i++) {
+    fPedestal += samples[i];
+  }
+  // A sample s is above threshold if s*nped > tsum
+  const Int_t tsum = fPedestal + threshold*nped;
+
+  Bool_t armed = kTRUE;
+  Int_t i = 0;
+  while(i < n && fNPulses < fMaxPulses) {
+    if(samples[i]*nped <= tsum) {
+      armed = kTRUE;
+      i++;
+      continue;
+    }
+    if(!armed) {
+      i++;
+      continue;
+    }
+
+    Pulse_t& pulse = fPulses[fNPulses++];
+    pulse.crossing = i;
+
+    Int_t first = (i > fNSB) ? i-fNSB : 0;
+    Int_t last = (i+fNSA < n) ? i+fNSA : n;
+    Int_t integral = 0;
+    for(Int_t k=first;k<last;k++) {
+      integral += samples[k];
+    }
+    pulse.integral = integral;
+
+    Int_t ipeak = i;
+    while(ipeak+1 < n && samples[ipeak+1] > samples[ipeak]) ipeak++;
+    pulse.peak = samples[ipeak];
+
+    // Half height in units of 1/(2*nped).  Walk back from the peak to the
+    // first sample above it on the leading edge.
+    const Int_t vmid = fPedestal + pulse.peak*nped;
+    Int_t k = ipeak;
+    while(k > 0 && samples[k-1]*2*nped > vmid) k--;
+    if(k == 0 || samples[k]*2*nped <= vmid) {
+      pulse.time = 64*k;
+    } else {
+      Int_t lo = samples[k-1]*2*nped;
+      Int_t hi = samples[k]*2*nped;
+      pulse.time = 64*(k-1) + (64*(vmid-lo))/(hi-lo);
+    }
+
+    i += (fNSA > 0) ? fNSA : 1;
+    armed = kFALSE;
+  }
+  return fNPulses;
+}
+
+ClassImp(THcFADC250PulseFinder)
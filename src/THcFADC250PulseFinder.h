@@ -0,0 +1,50 @@
+#ifndef ROOT_THcFADC250PulseFinder
+#define ROOT_THcFADC250PulseFinder
+
+/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+// THcFADC250PulseFinder                                                   //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+
+class THcFADC250PulseFinder {
+
+ public:
+  static const UInt_t kMaxPulses = 4;
+
+  // One pulse in the units of the firmware pulse data
+  struct Pulse_t {
+    Int_t integral;		// Raw sum of NSB+NSA samples
+    Int_t time;			// Leading edge time, 1/64 samples
+    Int_t peak;			// Raw peak sample
+    Int_t crossing;		// Sample that crossed the threshold
+  };
+
+  THcFADC250PulseFinder(Int_t nsa=6, Int_t nsb=3, Int_t nped=4,
+			UInt_t maxpulses=kMaxPulses);
+  virtual ~THcFADC250PulseFinder();
+
+  void SetParams(Int_t nsa, Int_t nsb, Int_t nped, UInt_t maxpulses=kMaxPulses);
+
+  UInt_t FindPulses(const Int_t* samples, UInt_t nsamples, Int_t threshold);
+
+  Int_t          GetPedestal() const { return fPedestal; }
+  UInt_t         GetNPulses() const { return fNPulses; }
+  const Pulse_t& GetPulse(UInt_t i) const { return fPulses[i]; }
+
+ protected:
+  Int_t   fNSA;			// Samples summed from the crossing on
+  Int_t   fNSB;			// Samples summed before the crossing
+  Int_t   fNPED;		// Samples at start of window for pedestal
+  UInt_t  fMaxPulses;		// Pulses reported per channel (NP)
+
+  Int_t   fPedestal;		// Raw sum of first NPED samples
+  UInt_t  fNPulses;
+  Pulse_t fPulses[kMaxPulses];
+
+  ClassDef(THcFADC250PulseFinder,0); // FADC250 mode 9/10 pulse emulation
+};
+/////////////////////////////////////////////////////////////////
+#endif
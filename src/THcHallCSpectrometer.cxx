@@ -98,6 +98,7 @@
 
 #include <vector>
 #include <cstring>
+#include <sstream>
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
@@ -108,7 +109,7 @@ using namespace std;
 
 //_____________________________________________________________________________
 THcHallCSpectrometer::THcHallCSpectrometer( const char* name, const char* description ) :
-  THaSpectrometer( name, description ), fPresent(kTRUE)
+  THaSpectrometer( name, description ), fPruneVarUsed(0), fPresent(kTRUE)
 {
   // Constructor. Defines the standard detectors for the HRS.
   //  AddDetector( new THaTriggerTime("trg","Trigger-based time offset"));
@@ -166,8 +167,7 @@ Bool_t THcHallCSpectrometer::GetTrSorting() const
 //_____________________________________________________________________________
 void THcHallCSpectrometer::InitializeReconstruction()
 {
-  fNReconTerms = 0;
-  fReconTerms.clear();
+  fReconMatrix.Clear();
   fAngSlope_x = 0.0;
   fAngSlope_y = 0.0;
   fAngOffset_x = 0.0;
@@ -276,6 +276,7 @@ Int_t THcHallCSpectrometer::ReadDatabase( const TDatime& date )
     {"prune_npmt",            &fPruneNPMT,           kDouble,         0,  1},
     {"prune_fptime",          &fPruneFpTime,             kDouble,         0,  1},
     {"prune_DipoleExit",          &fPruneDipoleExit,             kDouble,         0,  1},
+    {"prune_user_cuts",       &fPruneUserCuts,         kString,         0,  1},
     {0}
   };
 
@@ -292,6 +293,7 @@ Int_t THcHallCSpectrometer::ReadDatabase( const TDatime& date )
   fPruneChiBeta= 100.;
   fPruneNPMT= 6;
   fPruneFpTime= 1000.;
+  fPruneUserCuts = "";
   fPhi_lab = 0.;
   fSatCorr=0.;
   fMispointing_x=999.;
@@ -358,6 +360,7 @@ Int_t THcHallCSpectrometer::ReadDatabase( const TDatime& date )
   
   
   //EnforcePruneLimits();
+  BuildPruneCuts();
 
 #ifdef WITH_DEBUG
   cout <<  "\n\n\nhodo planes = " <<  fNPlanes << endl;
@@ -420,24 +423,14 @@ Int_t THcHallCSpectrometer::ReadDatabase( const TDatime& date )
   line=" ";
   good = getline(ifile,line).good();
   //  cout << line << endl;
-  fNReconTerms = 0;
-  fReconTerms.clear();
-  fReconTerms.reserve(500);
+  fReconMatrix.Clear();
   //cout << "Reading matrix elements" << endl;
   while(good && line.compare(0,4," ---")!=0) {
-    fReconTerms.push_back(reconTerm());
-    sscanf(line.c_str()," %le %le %le %le %1d%1d%1d%1d%1d"
-	   ,&fReconTerms[fNReconTerms].Coeff[0],&fReconTerms[fNReconTerms].Coeff[1]
-	   ,&fReconTerms[fNReconTerms].Coeff[2],&fReconTerms[fNReconTerms].Coeff[3]
-	   ,&fReconTerms[fNReconTerms].Exp[0]
-	   ,&fReconTerms[fNReconTerms].Exp[1]
-	   ,&fReconTerms[fNReconTerms].Exp[2]
-	   ,&fReconTerms[fNReconTerms].Exp[3]
-	   ,&fReconTerms[fNReconTerms].Exp[4]);
-    fNReconTerms++;
+    fReconMatrix.ReadTerm(line.c_str());
     good = getline(ifile,line).good();
   }
-  cout << "Read " << fNReconTerms << " matrix element terms"  << endl;
+  fReconMatrix.Compile();
+  cout << "Read " << fReconMatrix.GetNTerms() << " matrix element terms"  << endl;
   if(!good) {
     Error(here, "Error processing reconstruction coefficient file %s",reconCoeffFilename.c_str());
     return kInitError; // Is this the right return code?
@@ -458,6 +451,7 @@ void THcHallCSpectrometer::EnforcePruneLimits()
   fPruneChiBeta = TMath::Max( 2.0,  fPruneChiBeta);
   fPruneFpTime  = TMath::Max( 5.0,  fPruneFpTime);
   fPruneNPMT    = TMath::Max( 6.0,  fPruneNPMT);
+  BuildPruneCuts();
 }
 
 //_____________________________________________________________________________
@@ -540,20 +534,7 @@ void THcHallCSpectrometer::CalculateTargetQuantities(THaTrack* track,Double_t& x
 
   // Compute COSY sums
   Double_t sum[4];
-  for(Int_t k=0;k<4;k++) {
-    sum[k] = 0.0;
-  }
-  for(Int_t iterm=0;iterm<fNReconTerms;iterm++) {
-    Double_t term=1.0;
-    for(Int_t j=0;j<5;j++) {
-      if(fReconTerms[iterm].Exp[j]!=0) {
-	term *= pow(hut_rot[j],fReconTerms[iterm].Exp[j]);
-      }
-    }
-    for(Int_t k=0;k<4;k++) {
-      sum[k] += term*fReconTerms[iterm].Coeff[k];
-    }
-  }
+  fReconMatrix.Eval(hut_rot, sum);
   xptar=sum[0] + fPhiOffset;
   ytar=sum[1];
   yptar=sum[2] + fThetaOffset;
@@ -766,281 +747,269 @@ Int_t THcHallCSpectrometer::BestTrackUsingScin()
 }
 
 //_____________________________________________________________________________
-Int_t THcHallCSpectrometer::BestTrackUsingPrune()
+static const char* const kPruneVarNames[] = {
+  "xptar", "yptar", "ytar", "delta", "dipole_exit", "beta", "ndof", "npmt",
+  "chibeta", "fptime", "goodplane4", "goodplane3", "x_fp", "y_fp", "xp_fp",
+  "yp_fp", "p", "chi2ndof"
+};
+
+//_____________________________________________________________________________
+void THcHallCSpectrometer::AddPruneCut( Int_t var, Int_t op, Bool_t useabs,
+					Double_t limit, Int_t code,
+					Double_t low, Bool_t active )
+{
+  PruneCut cut;
+  cut.fVar = var;
+  cut.fOp = op;
+  cut.fAbs = useabs;
+  cut.fLimit = limit;
+  cut.fLow = low;
+  cut.fCode = code;
+  cut.fActive = active;
+  fPruneCuts.push_back(cut);
+  if(active) fPruneVarUsed |= (1U << var);
+}
+
+//_____________________________________________________________________________
+void THcHallCSpectrometer::BuildPruneCuts()
 {
   /**
-     Select as best track the track with the lowest Chisq after pruning
-     tracks that don't meet various criteria such as xptar, yptar, ytar
-     delta, beta, degrees of freedom (of track fit), difference between
-     measured beta and beta from p, chisq of beta fit, focal plane time
-     and number of PMT hit.
+     Fill the prune cut table.  The order and reject codes of the built-in
+     cuts are those of the original cascade, so fPruneSelect keeps its
+     meaning.  Cuts from the prune_user_cuts parameter are appended.
   */
+  fPruneCuts.clear();
+  fPruneVarUsed = 0;
+  AddPruneCut(kPruneXptar,      kPruneLess,      kTRUE,  fPruneXp,      1);
+  AddPruneCut(kPruneYptar,      kPruneLess,      kTRUE,  fPruneYp,      2);
+  AddPruneCut(kPruneYtar,       kPruneLess,      kTRUE,  fPruneYtar,    10);
+  AddPruneCut(kPruneDelta,      kPruneLess,      kTRUE,  fPruneDelta,   20);
+  AddPruneCut(kPruneDipoleExit, kPruneEqual,     kFALSE, 1.0,           30,
+	      0.0, fPruneDipoleExit==1);
+  AddPruneCut(kPruneBeta,       kPruneLess,      kTRUE,  fPruneBeta,    100);
+  AddPruneCut(kPruneNDoF,       kPruneGreaterEq, kFALSE, fPruneDf,      200);
+  AddPruneCut(kPruneNPMT,       kPruneGreaterEq, kFALSE, fPruneNPMT,    100000);
+  AddPruneCut(kPruneChiBeta,    kPruneInside,    kFALSE, fPruneChiBeta, 1000, 0.01);
+  AddPruneCut(kPruneFpTime,     kPruneLess,      kTRUE,  fPruneFpTime,  2000);
+  AddPruneCut(kPruneGoodPlane4, kPruneEqual,     kFALSE, 1.0,           10000);
+  AddPruneCut(kPruneGoodPlane3, kPruneEqual,     kFALSE, 1.0,           20000);
+  ParsePruneCuts(fPruneUserCuts);
+}
 
-  Int_t nGood;
-  Double_t chi2Min;
-
-  if ( fNtracks > 0 ) {
-    chi2Min   = 10000000000.0;
-    fGoodTrack = 0;
-    vector<bool> keep(fNtracks);
-    vector<Int_t> reject(fNtracks);
-
-    THaTrack *testTracks[fNtracks];
-
-    // ! Initialize all tracks to be good
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      keep[ptrack] = kTRUE;
-      reject[ptrack] = 0;
-      testTracks[ptrack] = static_cast<THaTrack*>( fTracks->At(ptrack) );
-      if (!testTracks[ptrack]) return -1;
+//_____________________________________________________________________________
+Int_t THcHallCSpectrometer::ParsePruneCuts( const std::string& spec )
+{
+  /**
+     Append cuts given as "var op limit [code]" separated by ';', e.g.
+     "y_fp abs< 30 ; npmt >= 8 200000".  var is one of the names in
+     kPruneVarNames, op is one of < <= > >= == != optionally prefixed
+     with "abs".  Returns the number of cuts added.
+
+     Reject codes of the cuts a track fails are summed.  A cut without
+     an explicit code gets its own bit, starting above the sum of all
+     built-in codes (bit 18), so the sum still tells which cuts failed.
+     Only bits up to 30 fit in the Int_t reject code; further cuts need
+     an explicit code.
+  */
+  static const char* const opnames[] = { "<", "<=", ">", ">=", "==", "!=" };
+  const Int_t firstbit = 18, lastbit = 30;
+  Int_t nadded = 0;
+  Int_t nextbit = firstbit;
+  std::istringstream specstream(spec);
+  std::string entry;
+  while(getline(specstream, entry, ';')) {
+    std::istringstream is(entry);
+    std::string varname, opname;
+    Double_t limit;
+    if(!(is >> varname)) continue;	// Empty entry
+    if(!(is >> opname >> limit)) {
+      cout << GetName() << ": bad prune cut \"" << entry << "\"" << endl;
+      continue;
     }
-    fPruneSelect = 0;
-    Double_t PruneSelect=0;
-    // ! Prune on xptar
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( TMath::Abs( testTracks[ptrack]->GetTTheta() ) < fPruneXp ) && ( keep[ptrack] ) ){
-	nGood ++;
-      }
+    Int_t code;
+    Bool_t hascode = static_cast<Bool_t>(is >> code);
+    Int_t var = -1;
+    for(Int_t i=0;i<kPruneNVar;i++) {
+      if(varname == kPruneVarNames[i]) var = i;
     }
-    if ( nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( TMath::Abs( testTracks[ptrack]->GetTTheta() ) >= fPruneXp ){
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 1;
-	}
-      }
+    Bool_t useabs = (opname.compare(0,3,"abs") == 0);
+    if(useabs) opname.erase(0,3);
+    Int_t op = -1;
+    for(Int_t i=0;i<6;i++) {
+      if(opname == opnames[i]) op = kPruneLess + i;
     }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
-    // ! Prune on yptar
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( TMath::Abs( testTracks[ptrack]->GetTPhi() ) < fPruneYp ) && ( keep[ptrack] ) ){
-	nGood ++;
-      }
+    if(var < 0 || op < 0) {
+      cout << GetName() << ": unknown variable or operator in prune cut \""
+	   << entry << "\"" << endl;
+      continue;
     }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( TMath::Abs( testTracks[ptrack]->GetTPhi() ) >= fPruneYp ){
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 2;
-
-	}
+    if(!hascode) {
+      if(nextbit > lastbit) {
+	cout << GetName() << ": no reject code bit left for prune cut \""
+	     << entry << "\", give an explicit code" << endl;
+	continue;
       }
+      code = 1 << nextbit++;
     }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
+    AddPruneCut(var, op, useabs, limit, code);
+    nadded++;
+  }
+  return nadded;
+}
 
-    // !     Prune on ytar
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( TMath::Abs( testTracks[ptrack]->GetTY() ) < fPruneYtar ) && ( keep[ptrack] ) ){
-	nGood ++;
-      }
+//_____________________________________________________________________________
+void THcHallCSpectrometer::GatherPruneValues( Int_t var )
+{
+  // Copy one prune quantity of every track into its row of fPruneVal
+  Double_t* val = &fPruneVal[var*fNtracks];
+  Double_t starttime = (var == kPruneFpTime) ? fHodo->GetStartTimeCenter() : 0.0;
+  for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
+    THaTrack* track = static_cast<THaTrack*>( fTracks->At(ptrack) );
+    switch(var) {
+    case kPruneXptar:      val[ptrack] = track->GetTTheta(); break;
+    case kPruneYptar:      val[ptrack] = track->GetTPhi(); break;
+    case kPruneYtar:       val[ptrack] = track->GetTY(); break;
+    case kPruneDelta:      val[ptrack] = track->GetDp(); break;
+    case kPruneDipoleExit:
+      val[ptrack] = InsideDipoleExitWindow(track->GetX(),track->GetTheta(),
+					   track->GetY(),track->GetPhi()) ? 1.0 : 0.0;
+      break;
+    case kPruneBeta: {
+      Double_t p = track->GetP();
+      Double_t betaP = p / TMath::Sqrt( p * p + fPartMass * fPartMass );
+      val[ptrack] = track->GetBeta() - betaP;
+      break;
     }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( TMath::Abs( testTracks[ptrack]->GetTY() ) >= fPruneYtar ){
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 10;
-	}
-      }
+    case kPruneNDoF:       val[ptrack] = track->GetNDoF(); break;
+    case kPruneNPMT:       val[ptrack] = track->GetNPMT(); break;
+    case kPruneChiBeta:    val[ptrack] = track->GetBetaChi2(); break;
+    case kPruneFpTime:     val[ptrack] = track->GetFPTime() - starttime; break;
+    case kPruneGoodPlane4: val[ptrack] = track->GetGoodPlane4(); break;
+    case kPruneGoodPlane3: val[ptrack] = track->GetGoodPlane3(); break;
+    case kPruneXfp:        val[ptrack] = track->GetX(); break;
+    case kPruneYfp:        val[ptrack] = track->GetY(); break;
+    case kPruneXpfp:       val[ptrack] = track->GetTheta(); break;
+    case kPruneYpfp:       val[ptrack] = track->GetPhi(); break;
+    case kPruneP:          val[ptrack] = track->GetP(); break;
+    case kPruneChi2NDoF:   val[ptrack] = fPruneChi2[ptrack]; break;
     }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
+  }
+}
 
-    // !     Prune on delta
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( TMath::Abs( testTracks[ptrack]->GetDp() ) < fPruneDelta ) && ( keep[ptrack] ) ){
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( TMath::Abs( testTracks[ptrack]->GetDp() ) >= fPruneDelta ){
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 20;
-	}
-      }
-    }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
+//_____________________________________________________________________________
+static inline Int_t PruneCount( const ULong64_t* a, const ULong64_t* b, Int_t nwords )
+{
+  Int_t n = 0;
+  for(Int_t w=0;w<nwords;w++) {
+    n += __builtin_popcountll(a[w] & b[w]);
+  }
+  return n;
+}
 
-   // !     Prune on dipole exit
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      Double_t xfp=testTracks[ptrack]->GetX();
-      Double_t yfp=testTracks[ptrack]->GetY();
-      Double_t xpfp=testTracks[ptrack]->GetTheta();
-       Double_t ypfp=testTracks[ptrack]->GetPhi();
-       if ( fPruneDipoleExit==1 && InsideDipoleExitWindow(xfp,xpfp,yfp,ypfp) && ( keep[ptrack] ) ){
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      Double_t xfp=testTracks[ptrack]->GetX();
-      Double_t yfp=testTracks[ptrack]->GetY();
-      Double_t xpfp=testTracks[ptrack]->GetTheta();
-       Double_t ypfp=testTracks[ptrack]->GetPhi();
-	if (!InsideDipoleExitWindow(xfp,xpfp,yfp,ypfp)  ){
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 30;
-	}
-      }
-    }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
+//_____________________________________________________________________________
+Int_t THcHallCSpectrometer::BestTrackUsingPrune()
+{
+  /**
+     Select as best track the track with the lowest Chisq after pruning
+     tracks that don't meet various criteria such as xptar, yptar, ytar
+     delta, beta, degrees of freedom (of track fit), difference between
+     measured beta and beta from p, chisq of beta fit, focal plane time
+     and number of PMT hit.
 
-    // !     Prune on beta
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      Double_t p = testTracks[ptrack]->GetP();
-      Double_t betaP = p / TMath::Sqrt( p * p + fPartMass * fPartMass );
-      if ( ( TMath::Abs( testTracks[ptrack]->GetBeta() - betaP ) < fPruneBeta ) && ( keep[ptrack] ) ){
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	Double_t p = testTracks[ptrack]->GetP();
-	Double_t betaP = p / TMath::Sqrt( p * p + fPartMass * fPartMass );
-	if ( TMath::Abs( testTracks[ptrack]->GetBeta() - betaP ) >= fPruneBeta ) {
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 100;
-	}
-      }
-    }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
+     The criteria are the entries of fPruneCuts, applied in order.  A cut
+     only removes tracks if at least one track that is still kept passes
+     it; it then removes every track that fails it.  The quantities used
+     by the cuts are gathered once per track, and the pass/fail decisions
+     are kept as bitmasks over the tracks.
+  */
 
-    // !     Prune on deg. freedom for track chisq
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( testTracks[ptrack]->GetNDoF() >= fPruneDf ) && ( keep[ptrack] ) ){
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( testTracks[ptrack]->GetNDoF() < fPruneDf ){
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 200;
-	}
-      }
-    }
+  if ( fNtracks > 0 ) {
+    Double_t chi2Min = 10000000000.0;
+    fGoodTrack = 0;
 
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
-    //!     Prune on num pmt hits
-    nGood = 0;
     for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( testTracks[ptrack]->GetNPMT() >= fPruneNPMT ) && ( keep[ptrack] ) ){
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( testTracks[ptrack]->GetNPMT() < fPruneNPMT ){
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 100000;
-	}
-      }
+      if (!fTracks->At(ptrack)) return -1;
     }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
 
-    // !     Prune on beta chisqr
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( testTracks[ptrack]->GetBetaChi2() < fPruneChiBeta ) &&
-	   ( testTracks[ptrack]->GetBetaChi2() > 0.01 )          &&   ( keep[ptrack] ) ){
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( ( testTracks[ptrack]->GetBetaChi2() >= fPruneChiBeta ) ||
-	     ( testTracks[ptrack]->GetBetaChi2() <= 0.01          ) ){
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 1000;
-	}
-      }
-    }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
+    const Int_t nwords = (fNtracks+63)/64;
+    fPruneKeep.assign(nwords, 0);
+    fPrunePass.resize(nwords);
+    fPruneFail.resize(nwords);
+    fPruneReject.assign(fNtracks, 0);
+    fPruneVal.resize(kPruneNVar*fNtracks);
+    fPruneChi2.resize(fNtracks);
 
-    // !     Prune on fptime
-    nGood = 0;
+    // ! Initialize all tracks to be good
     for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( TMath::Abs( testTracks[ptrack]->GetFPTime() - fHodo->GetStartTimeCenter() ) < fPruneFpTime )  &&
-	   ( keep[ptrack] ) ){
-	nGood ++;
-      }
+      THaTrack* track = static_cast<THaTrack*>( fTracks->At(ptrack) );
+      fPruneKeep[ptrack>>6] |= (1ULL << (ptrack&63));
+      fPruneChi2[ptrack] = track->GetChi2() / track->GetNDoF();
     }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( TMath::Abs( testTracks[ptrack]->GetFPTime() - fHodo->GetStartTimeCenter() ) >= fPruneFpTime ) {
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 2000;
-	}
-      }
+    for (Int_t var = 0; var < kPruneNVar; var++ ){
+      if (fPruneVarUsed & (1U << var)) GatherPruneValues(var);
     }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
 
-    // !     Prune on Y2 being hit
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( testTracks[ptrack]->GetGoodPlane4() == 1 )  &&  keep[ptrack] ) {
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( testTracks[ptrack]->GetGoodPlane4() != 1 ) {
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 10000;
+    fPruneSelect = 0;
+    Double_t PruneSelect=0;
+    for (UInt_t icut = 0; icut < fPruneCuts.size(); icut++ ){
+      const PruneCut& cut = fPruneCuts[icut];
+      Int_t nGood = 0;
+      if (cut.fActive) {
+	// Pass and fail are tested separately so that a NaN quantity, as
+	// in the original cascade, neither selects nor rejects a track.
+	const Double_t* val = &fPruneVal[cut.fVar*fNtracks];
+	const Double_t lim = cut.fLimit;
+	for (Int_t w = 0; w < nwords; w++ ){
+	  fPrunePass[w] = 0;
+	  fPruneFail[w] = 0;
 	}
-      }
-    }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
-
-    // !     Prune on X2 being hit
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( testTracks[ptrack]->GetGoodPlane3() == 1 )  &&  keep[ptrack] ) {
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( testTracks[ptrack]->GetGoodPlane3() != 1 ) {
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 20000;
+	for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
+	  Double_t v = cut.fAbs ? TMath::Abs(val[ptrack]) : val[ptrack];
+	  Bool_t pass, fail;
+	  switch(cut.fOp) {
+	  case kPruneLess:      pass = v <  lim; fail = v >= lim; break;
+	  case kPruneLessEq:    pass = v <= lim; fail = v >  lim; break;
+	  case kPruneGreater:   pass = v >  lim; fail = v <= lim; break;
+	  case kPruneGreaterEq: pass = v >= lim; fail = v <  lim; break;
+	  case kPruneEqual:     pass = v == lim; fail = v != lim; break;
+	  case kPruneNotEqual:  pass = v != lim; fail = v == lim; break;
+	  default: // kPruneInside
+	    pass = ( v < lim ) && ( v > cut.fLow );
+	    fail = ( v >= lim ) || ( v <= cut.fLow );
+	    break;
+	  }
+	  ULong64_t bit = 1ULL << (ptrack&63);
+	  if (pass) fPrunePass[ptrack>>6] |= bit;
+	  if (fail) fPruneFail[ptrack>>6] |= bit;
+	}
+	nGood = PruneCount(&fPrunePass[0], &fPruneKeep[0], nwords);
+	if (nGood > 0) {
+	  for (Int_t w = 0; w < nwords; w++ ){
+	    fPruneKeep[w] &= ~fPruneFail[w];
+	  }
+	  for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
+	    if (fPruneFail[ptrack>>6] & (1ULL << (ptrack&63))) {
+	      fPruneReject[ptrack] += cut.fCode;
+	    }
+	  }
 	}
       }
+      PruneSelect++;
+      if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
     }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
 
     // !     Pick track with best chisq if more than one track passed prune tests
-    Double_t chi2PerDeg = 0.;
     for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-
-      chi2PerDeg =  testTracks[ptrack]->GetChi2() / testTracks[ptrack]->GetNDoF();
-
-      if ( ( chi2PerDeg < chi2Min ) && ( keep[ptrack] ) ){
+      Double_t chi2PerDeg = fPruneChi2[ptrack];
+      if ( ( chi2PerDeg < chi2Min ) &&
+	   ( fPruneKeep[ptrack>>6] & (1ULL << (ptrack&63)) ) ){
 	fGoodTrack = ptrack;
 	chi2Min = chi2PerDeg;
       }
     }
-     PruneSelect++;
+    PruneSelect++;
     if (fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
-   // Set index=0 for fGoodTrack 
+    // Set index=0 for fGoodTrack
     for (Int_t iitrack = 0; iitrack < fNtracks; iitrack++ ){
       THaTrack* aTrack = dynamic_cast<THaTrack*>( fTracks->At(iitrack) );
       aTrack->SetIndex(1);
@@ -10,6 +10,7 @@
 #include "THaSpectrometer.h"
 
 #include <vector>
+#include <string>
 
 #include "TClonesArray.h"
 #include "THaNonTrackingDetector.h"
@@ -23,6 +24,7 @@
 #include "THcSpacePoint.h"
 #include "THcDriftChamberPlane.h"
 #include "THcDriftChamber.h"
+#include "THcReconMatrix.h"
 #include "TMath.h"
 
 #include "THaSubDetector.h"
@@ -62,12 +64,19 @@ public:
   Double_t GetBetaAtPcentral() const { return
       fPcentral/TMath::Sqrt(fPcentral*fPcentral+fPartMass*fPartMass);}
 
+  // Compiled COSY matrix, for batch evaluation outside CalculateTargetQuantities
+  const THcReconMatrix& GetReconMatrix() const { return fReconMatrix; }
+
   virtual void AddEvtType(int evtype);
   virtual void SetEvtType(int evtype);
   virtual Bool_t IsMyEvent(Int_t evtype) const;
   virtual Int_t GetNumTypes() { return eventtypes.size(); };
   virtual Bool_t IsPresent() {return fPresent;};
 
+  // Sum of the reject codes of the prune cuts a track failed
+  Int_t GetPruneReject( Int_t itrack ) const {
+    return (itrack >= 0 && itrack < (Int_t)fPruneReject.size()) ? fPruneReject[itrack] : 0; }
+
   Bool_t InsideDipoleExitWindow(Double_t x_fp, Double_t xp_fp, Double_t y_fp, Double_t yp_fp);
 
 protected:
@@ -94,6 +103,41 @@ protected:
   Double_t     fSatCorr;
   Double_t     fPruneSelect;
 
+  // Prune cut table used by BestTrackUsingPrune().  Each cut tests one
+  // gathered track quantity against a limit; the built-in cuts come from
+  // the prune_* parameters and prune_user_cuts appends more.
+  enum EPruneVar { kPruneXptar = 0, kPruneYptar, kPruneYtar, kPruneDelta,
+		   kPruneDipoleExit, kPruneBeta, kPruneNDoF, kPruneNPMT,
+		   kPruneChiBeta, kPruneFpTime, kPruneGoodPlane4,
+		   kPruneGoodPlane3, kPruneXfp, kPruneYfp, kPruneXpfp,
+		   kPruneYpfp, kPruneP, kPruneChi2NDoF, kPruneNVar };
+  enum EPruneOp { kPruneLess = 0, kPruneLessEq, kPruneGreater,
+		  kPruneGreaterEq, kPruneEqual, kPruneNotEqual, kPruneInside };
+  struct PruneCut {
+    Int_t    fVar;      // EPruneVar
+    Int_t    fOp;       // EPruneOp
+    Bool_t   fAbs;      // Compare |value|
+    Double_t fLimit;    // Limit (upper limit for kPruneInside)
+    Double_t fLow;      // Lower limit for kPruneInside
+    Int_t    fCode;     // Added to the track's reject code on failure
+    Bool_t   fActive;   // Inactive cuts never select (but keep their slot)
+  };
+  std::vector<PruneCut> fPruneCuts;
+  std::string  fPruneUserCuts;
+  UInt_t       fPruneVarUsed;              // Bit per EPruneVar needed by the cuts
+  std::vector<Double_t>  fPruneVal;        //! [var][track] gathered quantities
+  std::vector<Double_t>  fPruneChi2;       //! [track] chi2 per degree of freedom
+  std::vector<ULong64_t> fPruneKeep;       //! Track bitmasks
+  std::vector<ULong64_t> fPrunePass;       //!
+  std::vector<ULong64_t> fPruneFail;       //!
+  std::vector<Int_t>     fPruneReject;     //! [track] sum of failed cut codes
+
+  void  BuildPruneCuts();
+  void  AddPruneCut( Int_t var, Int_t op, Bool_t useabs, Double_t limit,
+		     Int_t code, Double_t low = 0.0, Bool_t active = kTRUE );
+  Int_t ParsePruneCuts( const std::string& spec );
+  void  GatherPruneValues( Int_t var );
+
   Int_t        fGoodTrack;
   Int_t        fSelUsingScin;
   Int_t        fSelUsingPrune;
@@ -120,20 +164,7 @@ protected:
   THcHodoscope* fHodo;
   THcDC* fDC;
 
-  Int_t fNReconTerms;
-  struct reconTerm {
-    Double_t Coeff[4];
-    Int_t Exp[5];
-    reconTerm() {
-      for(Int_t i=0;i<4;i++) {
-	Coeff[i] = 0.0;
-      }
-      for(Int_t i=0;i<5;i++) {
-	Exp[i] = 0;
-      }
-    }
-  };
-  std::vector<reconTerm> fReconTerms;
+  THcReconMatrix fReconMatrix;  // COSY reconstruction matrix elements
   //  Double_t fReconCoeff[fMaxReconElements][4];
   //  Int_t fReconExponents[fMaxReconElements][5];
   Double_t fAngSlope_x;
@@ -18,15 +18,25 @@
 #include "THcParmList.h"
 #include "TList.h"
 
+#include <algorithm>
+
 using namespace std;
 
 #define SUPPRESSMISSINGADCREFTIMEMESSAGES 1
-THcHitList::THcHitList() : fMap(0), fTISlot(0), fDisableSlipCorrection(kFALSE)
+
+std::vector<THcHitList::RefTimeCacheEntry> THcHitList::fgRefTimeCache;
+UInt_t THcHitList::fgRefTimeCacheEvNum = 0;
+UInt_t THcHitList::fgRefTimeCacheRunNum = 0;
+UInt_t THcHitList::fgRefTimeCacheEvLength = 0;
+
+THcHitList::THcHitList() : fMinPlane(0), fDecodePlanResolved(kFALSE), fMap(0), fTISlot(0), fDisableSlipCorrection(kFALSE)
 {
   /// Normal constructor.
 
   fRawHitList = NULL;
   fPSE125 = NULL;
+  fPulseFinderCrate = -1;
+  fPulseFinderOK = kFALSE;
   fFADCSlotMap.clear();
 
 }
@@ -94,6 +104,96 @@ void THcHitList::InitHitList(THaDetMap* detmap,
 
   fdMap = detmap;
 
+  /* Build the (plane,counter) -> hit slot lookup table.  Find the counter
+     range of each plane, then hand out keys plane by plane so that key
+     order is the same as the (plane,counter) order of THcRawHit::Compare */
+  fMinPlane = 0;
+  Int_t maxplane = -1;
+  Bool_t firstmodule = kTRUE;
+  for (Int_t i=0; i < fdMap->GetSize(); i++) {
+    THaDetMap::Module* d = fdMap->GetModule(i);
+    if(d->plane >= 1000) continue;
+    if(firstmodule || d->plane < fMinPlane) fMinPlane = d->plane;
+    if(firstmodule || d->plane > maxplane) maxplane = d->plane;
+    firstmodule = kFALSE;
+  }
+  Int_t nplanes = maxplane - fMinPlane + 1;
+  vector<Int_t> maxcounter(nplanes>0 ? nplanes : 0, 0);
+  fPlaneMinCounter.assign(maxcounter.size(), 0);
+  fPlaneKeyOffset.assign(maxcounter.size(), 0);
+  vector<Bool_t> haveplane(maxcounter.size(), kFALSE);
+  for (Int_t i=0; i < fdMap->GetSize(); i++) {
+    THaDetMap::Module* d = fdMap->GetModule(i);
+    if(d->plane >= 1000) continue;
+    Int_t ip = d->plane - fMinPlane;
+    Int_t lastcounter = d->first + d->hi - d->lo;
+    if(!haveplane[ip] || d->first < fPlaneMinCounter[ip]) fPlaneMinCounter[ip] = d->first;
+    if(!haveplane[ip] || lastcounter > maxcounter[ip]) maxcounter[ip] = lastcounter;
+    haveplane[ip] = kTRUE;
+  }
+  fKeyPlane.clear();
+  fKeyCounter.clear();
+  for(Int_t ip=0; ip<nplanes; ip++) {
+    fPlaneKeyOffset[ip] = fKeyPlane.size();
+    if(!haveplane[ip]) continue;
+    for(Int_t counter=fPlaneMinCounter[ip]; counter<=maxcounter[ip]; counter++) {
+      fKeyPlane.push_back(ip + fMinPlane);
+      fKeyCounter.push_back(counter);
+    }
+  }
+  fHitSlot.assign(fKeyPlane.size(), -1);
+  fHitKeys.clear();
+  fHitKeys.reserve(fKeyPlane.size());
+
+  /* Compile the decode plan: one entry per channel, grouped by module so
+     that each module's channel list is only walked once per event.
+     Entries for a channel are chained in detector map order. */
+  fDecodeSlots.clear();
+  fDecodeChans.clear();
+  for (Int_t i=0; i < fdMap->GetSize(); i++) {
+    THaDetMap::Module* d = fdMap->GetModule(i);
+    if(d->plane >= 1000) continue;
+    UInt_t islot = 0;
+    while(islot < fDecodeSlots.size() &&
+	  (fDecodeSlots[islot].crate != d->crate || fDecodeSlots[islot].slot != d->slot)) {
+      islot++;
+    }
+    if(islot == fDecodeSlots.size()) {
+      DecodeSlot ds;
+      ds.crate = d->crate;
+      ds.slot = d->slot;
+      fDecodeSlots.push_back(ds);
+    }
+    vector<Int_t>& chanentry = fDecodeSlots[islot].chanentry;
+    if(d->hi >= (Int_t) chanentry.size()) chanentry.resize(d->hi+1, -1);
+    for(Int_t chan=d->lo; chan<=d->hi; chan++) {
+      DecodeChan dc;
+      dc.crate = d->crate;
+      dc.slot = d->slot;
+      dc.chan = chan;
+      dc.signal = d->signal;
+      dc.key = GetHitKey(d->plane, d->reverse ? d->first + d->hi - chan : d->first + chan - d->lo);
+      dc.refchan = d->refchan;
+      dc.refindex = d->refindex;
+      dc.refchanmap = -1;
+      dc.fadc = kFALSE;
+      dc.next = -1;
+      Int_t ientry = fDecodeChans.size();
+      fDecodeChans.push_back(dc);
+      if(chanentry[chan] < 0) {
+	chanentry[chan] = ientry;
+      } else {
+	Int_t last = chanentry[chan];
+	while(fDecodeChans[last].next >= 0) last = fDecodeChans[last].next;
+	fDecodeChans[last].next = ientry;
+      }
+    }
+  }
+  fRefChanMaps.clear();
+  fDecodePlanResolved = kFALSE;
+  fHitChans.clear();
+  fHitChans.reserve(fDecodeChans.size());
+
   /* Pull out all the reference channels */
   fNRefIndex = 0;
   fRefIndexMaps.clear();
@@ -112,6 +212,7 @@ void THcHitList::InitHitList(THaDetMap* detmap,
     RefIndexMap map;
     map.defined = kFALSE;
     map.hashit = kFALSE;
+    map.fadc = kFALSE;
     fRefIndexMaps.push_back(map);
   }
   // Put the refindex mapping information in the vector
@@ -166,6 +267,23 @@ void THcHitList::InitHitList(THaDetMap* detmap,
   }
   fHaveFADCInfo = kFALSE;
 
+  // Pulse data can be made in software from the samples of mode 10 runs,
+  // to study firmware settings offline
+  fSoftPulses = 0;
+  fSoftPulseTET = -1;
+  DBRequest list[] = {
+    {"gadc_software_pulses", &fSoftPulses, kInt, 0, 1},
+    {"gadc_software_tet", &fSoftPulseTET, kInt, 0, 1},
+    {0}
+  };
+  gHcParms->LoadParmValues(list);
+  if(fSoftPulses) {
+    cout << "InitHitList: FADC pulses found in software from samples" << endl;
+  }
+  fPulseFinderCrate = -1;
+  fPulseFinderOK = kFALSE;
+  fSoftPulseWarned.clear();
+
   fNTDCRef_miss = 0;
   fNADCRef_miss = 0;
 
@@ -180,7 +298,12 @@ Clears the hit list then, finds all populated channels belonging to the detector
 sort it into the hitlist.  A given counter in the detector can have
 at most one entry in the hit list.  However, the raw "hit" can contain
 multiple signal types (e.g. ADC+, ADC-, TDC+, TDC-), or multiplehits for multihit tdcs.
-The hit list is sorted (by plane, counter) after filling.
+
+The decode plan compiled in InitHitList gives the (plane, counter), signal,
+reference channel and decode kernel (TDC or Flash ADC) of every channel, so
+each module's channel list is walked once.  A first pass over the channels
+lays out the hit list in (plane, counter) order, so the list comes out
+sorted without a Sort().  The data are then copied by the channel kernels.
 
 */
 Int_t THcHitList::DecodeToHitList( const THaEvData& evdata, Bool_t suppresswarnings ) {
@@ -230,266 +353,108 @@ Int_t THcHitList::DecodeToHitList( const THaEvData& evdata, Bool_t suppresswarni
 
   // cout << " Clearing TClonesArray " << endl;
   fRawHitList->Clear( );
+  fSampleArena.clear();
   fNRawHits = 0;
+  // Only reset the lookup table entries used in the last event
+  for(UInt_t ikey=0; ikey<fHitKeys.size(); ikey++) {
+    fHitSlot[fHitKeys[ikey]] = -1;
+  }
+  fHitKeys.clear();
   Bool_t tdcref_miss = kFALSE;
   Bool_t adcref_miss = kFALSE;
 
-  // Get the indexed reference times for this event
-  for(Int_t i=0;i<fNRefIndex;i++) {
-    if(fRefIndexMaps[i].defined) {
-      
-      if(evdata.IsMultifunction(fRefIndexMaps[i].crate,
-				fRefIndexMaps[i].slot)) { // Multifunction module (e.g. FADC)
-	// Make sure at least one pulse
-	Int_t nrefhits = evdata.GetNumEvents(Decoder::kPulseTime,
-					     fRefIndexMaps[i].crate,
-					     fRefIndexMaps[i].slot,
-					     fRefIndexMaps[i].channel);
-	Int_t timeshift=0;
-	if(fTISlot>0) {		// Get the trigger time for this module
-	  if(fTrigTimeShiftMap.find(fRefIndexMaps[i].slot)
-	     == fTrigTimeShiftMap.end()) { // 
-	    if(fFADCSlotMap.find(fRefIndexMaps[i].slot) != fFADCSlotMap.end()) {
-	      fTrigTimeShiftMap[fRefIndexMaps[i].slot]
-		= fFADCSlotMap[fRefIndexMaps[i].slot]->GetTriggerTime() - titime;
-	    }
-	    timeshift = fTrigTimeShiftMap[fRefIndexMaps[i].slot];
-	  }
-	}
-	fRefIndexMaps[i].hashit = kFALSE;
-	Bool_t goodreftime=kFALSE;
-	Int_t reftime = 0;
-	for(Int_t ihit=0; ihit<nrefhits; ihit++) {
-	  reftime = evdata.GetData(Decoder::kPulseTime,fRefIndexMaps[i].crate,
-				   fRefIndexMaps[i].slot, fRefIndexMaps[i].channel,ihit);
-	  reftime += 64*timeshift;
-	  if(reftime >= fADC_RefTimeCut) {
-	    goodreftime = kTRUE;
-	    break;
-	  }
-	}
-	if(goodreftime || (nrefhits>0 && fADC_RefTimeBest)) {
-	  fRefIndexMaps[i].reftime = reftime;
-	  fRefIndexMaps[i].hashit = kTRUE;
-	}
-      } else {			// Assume this is a TDC
-	Int_t nrefhits = evdata.GetNumHits(fRefIndexMaps[i].crate,
-					   fRefIndexMaps[i].slot,
-					   fRefIndexMaps[i].channel);
-	fRefIndexMaps[i].hashit = kFALSE;
-	// Only take first hit in this reference channel that is bigger
-	// then fTDC_RefTimeCut
-	Bool_t goodreftime=kFALSE;
-	Int_t reftime = 0;
-	for(Int_t ihit=0; ihit<nrefhits; ihit++) {
-	  reftime = evdata.GetData(fRefIndexMaps[i].crate,fRefIndexMaps[i].slot,
-				   fRefIndexMaps[i].channel,ihit);
-	  if(reftime >= fTDC_RefTimeCut) {
-	    goodreftime = kTRUE;
-	    break;
-	  }
-	}
-	if(goodreftime || (nrefhits>0 && fTDC_RefTimeBest)) {
-	    fRefIndexMaps[i].reftime = reftime;
-	    fRefIndexMaps[i].hashit = kTRUE;
-	}
+  if(!fDecodePlanResolved) {
+    // Module types are only known once there is event data.  Pick the
+    // decode kernel for every channel in the plan once, and collect
+    // the distinct reference channels used by the plan.
+    for(Int_t i=0;i<fNRefIndex;i++) {
+      if(fRefIndexMaps[i].defined) {
+	fRefIndexMaps[i].fadc = evdata.IsMultifunction(fRefIndexMaps[i].crate,
+						       fRefIndexMaps[i].slot);
       }
     }
-  }
-  for ( Int_t i=0; i < fdMap->GetSize(); i++ ) {
-    THaDetMap::Module* d = fdMap->GetModule(i);
-    
-    // Loop over all channels that have a hit.
-    //    cout << "Crate/Slot: " << d->crate << "/" << d->slot << endl;
-    Int_t plane = d->plane;
-    if (plane >= 1000) continue; // Skip reference times
-    Int_t signal = d->signal;
-    UInt_t signaltype = fSignalTypes[signal];
-    Bool_t multifunction = evdata.IsMultifunction(d->crate, d->slot);
-    // Should probably get the Decoder::Module object and use it's
-    // methods.  Saving a THaEvData::GetModule call every time
-
-    for ( Int_t j=0; j < evdata.GetNumChan( d->crate, d->slot); j++) {
-      THcRawHit* rawhit=0;
-
-      Int_t chan = evdata.GetNextChan( d->crate, d->slot, j );
-      if( chan < d->lo || chan > d->hi ) continue;     // Not one of my channels
-
-      // Need to convert crate, slot, chan into plane, counter, signal
-      // Search hitlist for this plane,counter,signal
-      Int_t counter = d->reverse ? d->first + d->hi - chan : d->first + chan - d->lo;
-      //cout << d->crate << " " << d->slot << " " << chan << " " << plane << " "
-      // << counter << " " << signal << endl;
-      // Search hit list for plane and counter
-      // We could do sorting
-      UInt_t thishit = 0;
-      while(thishit < fNRawHits) {
-	rawhit = (THcRawHit*) (*fRawHitList)[thishit];
-	if (plane == rawhit->fPlane
-	    && counter == rawhit->fCounter) {
-	  // cout << "Found as " << thishit << "/" << fNRawHits << endl;
-	  break;
-	}
-	thishit++;
+    fRefChanMaps.clear();
+    for(UInt_t ichan=0; ichan<fDecodeChans.size(); ichan++) {
+      DecodeChan& dc = fDecodeChans[ichan];
+      dc.fadc = (fSignalTypes[dc.signal] != THcRawHit::kTDC
+		 && evdata.IsMultifunction(dc.crate, dc.slot));
+      dc.refchanmap = -1;
+      if(dc.refchan < 0) continue;
+      UInt_t iref = 0;
+      while(iref < fRefChanMaps.size() &&
+	    (fRefChanMaps[iref].crate != dc.crate || fRefChanMaps[iref].slot != dc.slot
+	     || fRefChanMaps[iref].channel != dc.refchan || fRefChanMaps[iref].fadc != dc.fadc)) {
+	iref++;
       }
-
-      if(thishit == fNRawHits) {
-	rawhit = (THcRawHit*) fRawHitList->ConstructedAt(thishit,"");
-	fNRawHits++;
-	rawhit->fPlane = plane;
-	rawhit->fCounter = counter;
+      if(iref == fRefChanMaps.size()) {
+	RefIndexMap map;
+	map.defined = kTRUE;
+	map.hashit = kFALSE;
+	map.fadc = dc.fadc;
+	map.crate = dc.crate;
+	map.slot = dc.slot;
+	map.channel = dc.refchan;
+	map.reftime = 0;
+	fRefChanMaps.push_back(map);
       }
+      dc.refchanmap = iref;
+    }
+    fDecodePlanResolved = kTRUE;
+  }
 
-      // Get the data from this channel
-      // Allow for multiple hits
-      if(signaltype == THcRawHit::kTDC || !multifunction) {
-	Int_t nMHits = evdata.GetNumHits(d->crate, d->slot, chan);
-	for (Int_t mhit = 0; mhit < nMHits; mhit++) {
-	  Int_t data = evdata.GetData( d->crate, d->slot, chan, mhit);
-	  // cout << "Signal " << signal << "=" << data << endl;
-	  rawhit->SetData(signal,data);
-	}
-	// Get the reference time.
-	if(d->refchan >= 0) {
-	  Int_t nrefhits = evdata.GetNumHits(d->crate,d->slot,d->refchan);
-	  Bool_t goodreftime=kFALSE;
-	  Int_t reftime=0;
-	  for(Int_t ihit=0; ihit<nrefhits; ihit++) {
-	    reftime = evdata.GetData(d->crate, d->slot, d->refchan, ihit);
-	    if(reftime >= fTDC_RefTimeCut) {
-	      goodreftime = kTRUE;
-	      break;
-	    }
-	  }
-	  // If RefTimeBest flag set, take the last hit if none of the
-	  // hits make the RefTimeCut
-	  if(goodreftime || (nrefhits>0 && fTDC_RefTimeBest)) {
-	    rawhit->SetReference(signal, reftime);
-	  } else if (!suppresswarnings) {
-	    cout << "HitList(event=" << evdata.GetEvNum() << "): refchan " << d->refchan <<
-	      " missing for (" << d->crate << ", " << d->slot <<
-	      ", " << chan << ")" << endl;
-	      tdcref_miss = kTRUE;
-	  }
-	} else {
-	  if(d->refindex >=0 && d->refindex < fNRefIndex) {
-	    if(fRefIndexMaps[d->refindex].hashit) {
-	      rawhit->SetReference(signal, fRefIndexMaps[d->refindex].reftime);
-	    } else {
-	      if(!suppresswarnings) {
-		cout << "HitList(event=" << evdata.GetEvNum() << "): refindex " << d->refindex <<
-		  " (" << fRefIndexMaps[d->refindex].crate <<
-		  ", " << fRefIndexMaps[d->refindex].slot <<
-		  ", " << fRefIndexMaps[d->refindex].channel << ")" <<
-		  " missing for (" << d->crate << ", " << d->slot <<
-		  ", " << chan << ")" << endl;
-		tdcref_miss = kTRUE;
-	      }
-	    }
-	  }
-	}
-      } else {			// This is a Flash ADC
-
-        if (fPSE125) {
-	  if(!fHaveFADCInfo) {
-	    fNSA = fPSE125->GetNSA(d->crate);
-	    fNSB = fPSE125->GetNSB(d->crate);
-	    fNPED = fPSE125->GetNPED(d->crate);
-	    fHaveFADCInfo = kTRUE;
-	  }
-	  // Set F250 parameters.
-          rawhit->SetF250Params(fNSA, fNSB, fNPED);
-        }
-	
-	// Copy the samples
-	Int_t nsamples=evdata.GetNumEvents(Decoder::kSampleADC, d->crate, d->slot, chan);
-
-	// If nsamples comes back zero, may want to suppress further attempts to
-	// get sample data for this or all modules
-	for (Int_t isamp=0;isamp<nsamples;isamp++) {
-	  rawhit->SetSample(signal,evdata.GetData(Decoder::kSampleADC, d->crate, d->slot, chan, isamp));
-	}
-	// Now get the pulse mode data
-	// Pulse area will go into regular SetData, others will use special hit methods
-	Int_t npulses=evdata.GetNumEvents(Decoder::kPulseIntegral, d->crate, d->slot, chan);
-	// Assume that the # of pulses for kPulseTime, kPulsePeak and kPulsePedestal are same;
-	Int_t timeshift=0;
-	if(fTISlot>0) {		// Get the trigger time for this module
-	  if(fTrigTimeShiftMap.find(d->slot)
-	     == fTrigTimeShiftMap.end()) { // 
-	    if(fFADCSlotMap.find(d->slot) != fFADCSlotMap.end()) {
-	      fTrigTimeShiftMap[d->slot]
-		= fFADCSlotMap[d->slot]->GetTriggerTime() - titime;
-	    }
-	  }
-	  timeshift = fTrigTimeShiftMap[d->slot];
-	}
-	for (Int_t ipulse=0;ipulse<npulses;ipulse++) {
-	  rawhit->SetDataTimePedestalPeak(signal,
-					  evdata.GetData(Decoder::kPulseIntegral, d->crate, d->slot, chan, ipulse),
-					  evdata.GetData(Decoder::kPulseTime, d->crate, d->slot, chan, ipulse)+64*timeshift,
-					  evdata.GetData(Decoder::kPulsePedestal, d->crate, d->slot, chan, ipulse),
-					  evdata.GetData(Decoder::kPulsePeak, d->crate, d->slot, chan, ipulse));
-	}
-	// Get the reference time for the FADC pulse time
-	if(d->refchan >= 0) {	// Reference time for the slot
-	  Int_t nrefhits = evdata.GetNumEvents(Decoder::kPulseIntegral,
-					       d->crate, d->slot, d->refchan);
-	  Bool_t goodreftime=kFALSE;
-	  Int_t reftime = 0;
-	  timeshift=0;
-	  if(fTISlot>0) {		// Get the trigger time for this module
-	    if(fTrigTimeShiftMap.find(d->slot)
-	       == fTrigTimeShiftMap.end()) { // 
-	      if(fFADCSlotMap.find(d->slot) != fFADCSlotMap.end()) {
-		fTrigTimeShiftMap[d->slot]
-		  = fFADCSlotMap[d->slot]->GetTriggerTime() - titime;
-	      }
-	    }
-	    timeshift = fTrigTimeShiftMap[d->slot];
-	  }
-	  for(Int_t ihit=0; ihit<nrefhits; ihit++) {
-	    reftime = evdata.GetData(Decoder::kPulseTime, d->crate, d->slot, d->refchan, ihit);
-	    reftime += 64*timeshift;
-	    if(reftime >= fADC_RefTimeCut) {
-	      goodreftime=kTRUE;
-	      break;
-	    }
-	  }
-	  // If RefTimeBest flag set, take the last hit if none of the
-	  // hits make the RefTimeCut
-	  if(goodreftime || (nrefhits>0 && fADC_RefTimeBest)) {
-	    rawhit->SetReference(signal, reftime);
-	  } else if (!suppresswarnings) {
-#ifndef SUPPRESSMISSINGADCREFTIMEMESSAGES
-	    cout << "HitList(event=" << evdata.GetEvNum() << "): refchan " << d->refchan <<
-	      " missing for (" << d->crate << ", " << d->slot <<
-	      ", " << chan << ")" << endl;
-#endif
-	      adcref_miss = kTRUE;
-	  }
-	} else {
-	  if(d->refindex >=0 && d->refindex < fNRefIndex) {
-	    if(fRefIndexMaps[d->refindex].hashit) {
-	      rawhit->SetReference(signal, fRefIndexMaps[d->refindex].reftime);
-	    } else {
-	      if(!suppresswarnings) {
-#ifndef SUPPRESSMISSINGADCREFTIMEMESSAGES
-		cout << "HitList(event=" << evdata.GetEvNum() << "): refindex " << d->refindex <<
-		  " (" << fRefIndexMaps[d->refindex].crate <<
-		  ", " << fRefIndexMaps[d->refindex].slot <<
-		  ", " << fRefIndexMaps[d->refindex].channel << ")" <<
-		  " missing for (" << d->crate << ", " << d->slot <<
-		  ", " << chan << ")" << endl;
-#endif
-		adcref_miss = kTRUE;
-	      }
-	    }
-	  }
+  // Get the reference times for this event, both the indexed ones and
+  // the per module reference channels.  Each is only looked up once per
+  // event, no matter how many channels or detectors use it.
+  for(Int_t i=0;i<fNRefIndex;i++) {
+    if(fRefIndexMaps[i].defined) {
+      ResolveRefTime(evdata, fRefIndexMaps[i], titime);
+    }
+  }
+  for(UInt_t i=0;i<fRefChanMaps.size();i++) {
+    ResolveRefTime(evdata, fRefChanMaps[i], titime);
+  }
+
+  // Find all the counters that have a hit and give them hit list slots
+  // in (plane, counter) order
+  fHitChans.clear();
+  for(UInt_t islot=0; islot<fDecodeSlots.size(); islot++) {
+    const DecodeSlot& ds = fDecodeSlots[islot];
+    Int_t nchan = evdata.GetNumChan(ds.crate, ds.slot);
+    Int_t maxchan = ds.chanentry.size();
+    for (Int_t j=0; j < nchan; j++) {
+      Int_t chan = evdata.GetNextChan(ds.crate, ds.slot, j);
+      if( chan < 0 || chan >= maxchan ) continue;     // Not one of my channels
+      for(Int_t ientry = ds.chanentry[chan]; ientry >= 0;
+	  ientry = fDecodeChans[ientry].next) {
+	Int_t key = fDecodeChans[ientry].key;
+	if(fHitSlot[key] < 0) {
+	  fHitSlot[key] = 0;
+	  fHitKeys.push_back(key);
 	}
+	fHitChans.push_back(ientry);
       }
     }
   }
+  sort(fHitKeys.begin(), fHitKeys.end());
+  for(UInt_t ikey=0; ikey<fHitKeys.size(); ikey++) {
+    Int_t key = fHitKeys[ikey];
+    THcRawHit* rawhit = (THcRawHit*) fRawHitList->ConstructedAt(ikey,"");
+    rawhit->fPlane = fKeyPlane[key];
+    rawhit->fCounter = fKeyCounter[key];
+    fHitSlot[key] = ikey;
+  }
+  fNRawHits = fHitKeys.size();
+
+  // Get the data from each channel with a hit
+  for(UInt_t ihit=0; ihit<fHitChans.size(); ihit++) {
+    const DecodeChan& dc = fDecodeChans[fHitChans[ihit]];
+    THcRawHit* rawhit = (THcRawHit*) fRawHitList->UncheckedAt(fHitSlot[dc.key]);
+    if(dc.fadc) {
+      DecodeFADCChannel(evdata, dc, rawhit, titime, suppresswarnings, adcref_miss);
+    } else {
+      DecodeTDCChannel(evdata, dc, rawhit, suppresswarnings, tdcref_miss);
+    }
+  }
 #if 1
   if(fTISlot>0) {
     //    cout << "TI ROC: " << fTICrate << "   TI Time: " << titime << endl;
@@ -502,12 +467,261 @@ Int_t THcHitList::DecodeToHitList( const THaEvData& evdata, Bool_t suppresswarni
     }
   }
 #endif    
-  fRawHitList->Sort(fNRawHits);
 
   fNTDCRef_miss += (tdcref_miss ? 1 : 0);
   fNADCRef_miss += (adcref_miss ? 1 : 0);
   return fNRawHits;		// Does anything care what is returned
 }
+//_____________________________________________________________________________
+Int_t THcHitList::GetTrigTimeShift(Int_t slot, Int_t titime)
+{
+  /// Trigger time shift (in 4 ns FADC clock ticks) of the FADC in slot
+  /// relative to the TI.  Computed once per slot per event.
+  if(fTrigTimeShiftMap.find(slot) == fTrigTimeShiftMap.end()) {
+    if(fFADCSlotMap.find(slot) != fFADCSlotMap.end()) {
+      fTrigTimeShiftMap[slot] = fFADCSlotMap[slot]->GetTriggerTime() - titime;
+    }
+  }
+  return fTrigTimeShiftMap[slot];
+}
+//_____________________________________________________________________________
+void THcHitList::ResolveRefTime(const THaEvData& evdata, RefIndexMap& ref,
+				Int_t titime)
+{
+  /// Find the reference time of a reference channel for this event.
+  /// The first hit at or above the reference time cut is used.  If the
+  /// RefTimeBest flag is set, the last hit is used if no hit makes the cut.
+  ///
+  /// Results are kept in a cache shared by all hit lists, so a reference
+  /// channel used by several detectors is only scanned once per event.
+  /// FADC pulse times are compared to the cut after the trigger time
+  /// shift of this hit list, so the cache key holds the shifted cut.
+
+  Int_t timeshift = 0;
+  Int_t cut;
+  Bool_t best;
+  if(ref.fadc) {
+    if(fTISlot>0) timeshift = GetTrigTimeShift(ref.slot, titime);
+    cut = fADC_RefTimeCut - 64*timeshift;
+    best = fADC_RefTimeBest;
+  } else {
+    cut = fTDC_RefTimeCut;
+    best = fTDC_RefTimeBest;
+  }
+
+  if(evdata.GetEvNum() != fgRefTimeCacheEvNum
+     || evdata.GetRunNum() != fgRefTimeCacheRunNum
+     || evdata.GetEvLength() != fgRefTimeCacheEvLength) {
+    fgRefTimeCache.clear();
+    fgRefTimeCacheEvNum = evdata.GetEvNum();
+    fgRefTimeCacheRunNum = evdata.GetRunNum();
+    fgRefTimeCacheEvLength = evdata.GetEvLength();
+  }
+  for(UInt_t i=0; i<fgRefTimeCache.size(); i++) {
+    const RefTimeCacheEntry& e = fgRefTimeCache[i];
+    if(e.crate == ref.crate && e.slot == ref.slot && e.channel == ref.channel
+       && e.fadc == ref.fadc && e.cut == cut && e.best == best) {
+      ref.hashit = e.hashit;
+      ref.reftime = e.reftime + 64*timeshift;
+      return;
+    }
+  }
+
+  Int_t nrefhits;
+  if(ref.fadc) {
+    nrefhits = evdata.GetNumEvents(Decoder::kPulseTime, ref.crate, ref.slot, ref.channel);
+  } else {
+    nrefhits = evdata.GetNumHits(ref.crate, ref.slot, ref.channel);
+  }
+  Bool_t goodreftime=kFALSE;
+  Int_t reftime = 0;
+  for(Int_t ihit=0; ihit<nrefhits; ihit++) {
+    if(ref.fadc) {
+      reftime = evdata.GetData(Decoder::kPulseTime, ref.crate, ref.slot, ref.channel, ihit);
+    } else {
+      reftime = evdata.GetData(ref.crate, ref.slot, ref.channel, ihit);
+    }
+    if(reftime >= cut) {
+      goodreftime = kTRUE;
+      break;
+    }
+  }
+  RefTimeCacheEntry e;
+  e.crate = ref.crate;
+  e.slot = ref.slot;
+  e.channel = ref.channel;
+  e.fadc = ref.fadc;
+  e.cut = cut;
+  e.best = best;
+  e.hashit = (goodreftime || (nrefhits>0 && best));
+  e.reftime = reftime;
+  fgRefTimeCache.push_back(e);
+
+  ref.hashit = e.hashit;
+  ref.reftime = reftime + 64*timeshift;
+}
+//_____________________________________________________________________________
+void THcHitList::DecodeTDCChannel(const THaEvData& evdata, const DecodeChan& dc,
+				  THcRawHit* rawhit, Bool_t suppresswarnings,
+				  Bool_t& refmiss)
+{
+  /// Copy the hits of a TDC (or other single function module) channel
+  /// into the raw hit along with its reference time.
+
+  // Allow for multiple hits
+  Int_t nMHits = evdata.GetNumHits(dc.crate, dc.slot, dc.chan);
+  for (Int_t mhit = 0; mhit < nMHits; mhit++) {
+    Int_t data = evdata.GetData(dc.crate, dc.slot, dc.chan, mhit);
+    rawhit->SetData(dc.signal,data);
+  }
+  // Get the reference time.
+  if(dc.refchan >= 0) {
+    if(fRefChanMaps[dc.refchanmap].hashit) {
+      rawhit->SetReference(dc.signal, fRefChanMaps[dc.refchanmap].reftime);
+    } else if (!suppresswarnings) {
+      cout << "HitList(event=" << evdata.GetEvNum() << "): refchan " << dc.refchan <<
+	" missing for (" << dc.crate << ", " << dc.slot <<
+	", " << dc.chan << ")" << endl;
+      refmiss = kTRUE;
+    }
+  } else {
+    if(dc.refindex >=0 && dc.refindex < fNRefIndex) {
+      if(fRefIndexMaps[dc.refindex].hashit) {
+	rawhit->SetReference(dc.signal, fRefIndexMaps[dc.refindex].reftime);
+      } else {
+	if(!suppresswarnings) {
+	  cout << "HitList(event=" << evdata.GetEvNum() << "): refindex " << dc.refindex <<
+	    " (" << fRefIndexMaps[dc.refindex].crate <<
+	    ", " << fRefIndexMaps[dc.refindex].slot <<
+	    ", " << fRefIndexMaps[dc.refindex].channel << ")" <<
+	    " missing for (" << dc.crate << ", " << dc.slot <<
+	    ", " << dc.chan << ")" << endl;
+	  refmiss = kTRUE;
+	}
+      }
+    }
+  }
+}
+//_____________________________________________________________________________
+void THcHitList::SetPulseFinderCrate(Int_t crate)
+{
+  /// Set up fPulseFinder with the FADC250 parameters of a crate from the
+  /// configuration event.  If NSA or NPED are not known for the crate,
+  /// the firmware pulse data of its channels are kept.
+
+  fPulseFinderCrate = crate;
+  Int_t nsa = -1, nsb = -1, nped = -1, np = -1;
+  if(fPSE125) {
+    nsa = fPSE125->GetNSA(crate);
+    nsb = fPSE125->GetNSB(crate);
+    nped = fPSE125->GetNPED(crate);
+    np = fPSE125->GetNP(crate);
+  }
+  fPulseFinderOK = (nsa > 0 && nsb >= 0 && nped > 0);
+  if(fPulseFinderOK) {
+    fPulseFinder.SetParams(nsa, nsb, nped,
+			   (np > 0) ? np : THcFADC250PulseFinder::kMaxPulses);
+  } else if(fSoftPulseWarned.insert(crate).second) {
+    cout << "THcHitList: No FADC250 NSA/NPED for crate " << crate
+	 << " in the configuration event, keeping firmware pulse data" << endl;
+  }
+}
+//_____________________________________________________________________________
+void THcHitList::DecodeFADCChannel(const THaEvData& evdata, const DecodeChan& dc,
+				   THcRawHit* rawhit, Int_t titime,
+				   Bool_t suppresswarnings, Bool_t& refmiss)
+{
+  /// Copy the samples and pulse data of a Flash ADC channel into the
+  /// raw hit along with the reference time for the pulse time.
+
+  if (fPSE125) {
+    if(!fHaveFADCInfo) {
+      fNSA = fPSE125->GetNSA(dc.crate);
+      fNSB = fPSE125->GetNSB(dc.crate);
+      fNPED = fPSE125->GetNPED(dc.crate);
+      fHaveFADCInfo = kTRUE;
+    }
+    // Set F250 parameters.
+    rawhit->SetF250Params(fNSA, fNSB, fNPED);
+  }
+
+  // Copy the samples
+  Int_t nsamples=evdata.GetNumEvents(Decoder::kSampleADC, dc.crate, dc.slot, dc.chan);
+
+  // If nsamples comes back zero, may want to suppress further attempts to
+  // get sample data for this or all modules
+  UInt_t narena = fSampleArena.size();
+  if(nsamples > 0) rawhit->SetSampleArena(dc.signal, &fSampleArena);
+  for (Int_t isamp=0;isamp<nsamples;isamp++) {
+    rawhit->SetSample(dc.signal,evdata.GetData(Decoder::kSampleADC, dc.crate, dc.slot, dc.chan, isamp));
+  }
+  Int_t timeshift = (fTISlot>0) ? GetTrigTimeShift(dc.slot, titime) : 0;
+  Bool_t softpulses = fSoftPulses && nsamples > 0
+    && fSampleArena.size() >= narena+nsamples;
+  // Parameters that are not known yet are looked up again, in case the
+  // configuration event comes later
+  if(softpulses && (dc.crate != fPulseFinderCrate || !fPulseFinderOK))
+    SetPulseFinderCrate(dc.crate);
+  if(softpulses && fPulseFinderOK) {
+    // Pulse data from the samples just stored (the end of the arena)
+    // instead of from the firmware
+    Int_t tet = fSoftPulseTET;
+    if(tet < 0 && fPSE125) tet = fPSE125->GetThreshold(dc.crate, dc.slot, dc.chan);
+    if(tet < 0) tet = 10;
+    const Int_t* samples = &fSampleArena[fSampleArena.size()-nsamples];
+    UInt_t nfound = fPulseFinder.FindPulses(samples, nsamples, tet);
+    for (UInt_t ipulse=0;ipulse<nfound;ipulse++) {
+      const THcFADC250PulseFinder::Pulse_t& pulse = fPulseFinder.GetPulse(ipulse);
+      rawhit->SetDataTimePedestalPeak(dc.signal, pulse.integral,
+				      pulse.time+64*timeshift,
+				      fPulseFinder.GetPedestal(), pulse.peak);
+    }
+  } else {
+    // Now get the pulse mode data
+    // Pulse area will go into regular SetData, others will use special hit methods
+    Int_t npulses=evdata.GetNumEvents(Decoder::kPulseIntegral, dc.crate, dc.slot, dc.chan);
+    // Assume that the # of pulses for kPulseTime, kPulsePeak and kPulsePedestal are same;
+    for (Int_t ipulse=0;ipulse<npulses;ipulse++) {
+      rawhit->SetDataTimePedestalPeak(dc.signal,
+				      evdata.GetData(Decoder::kPulseIntegral, dc.crate, dc.slot, dc.chan, ipulse),
+				      evdata.GetData(Decoder::kPulseTime, dc.crate, dc.slot, dc.chan, ipulse)+64*timeshift,
+				      evdata.GetData(Decoder::kPulsePedestal, dc.crate, dc.slot, dc.chan, ipulse),
+				      evdata.GetData(Decoder::kPulsePeak, dc.crate, dc.slot, dc.chan, ipulse));
+    }
+  }
+  // Get the reference time for the FADC pulse time
+  if(dc.refchan >= 0) {	// Reference time for the slot
+    if(fRefChanMaps[dc.refchanmap].hashit) {
+      rawhit->SetReference(dc.signal, fRefChanMaps[dc.refchanmap].reftime);
+    } else if (!suppresswarnings) {
+#ifndef SUPPRESSMISSINGADCREFTIMEMESSAGES
+      cout << "HitList(event=" << evdata.GetEvNum() << "): refchan " << dc.refchan <<
+	" missing for (" << dc.crate << ", " << dc.slot <<
+	", " << dc.chan << ")" << endl;
+#endif
+      refmiss = kTRUE;
+    }
+  } else {
+    if(dc.refindex >=0 && dc.refindex < fNRefIndex) {
+      if(fRefIndexMaps[dc.refindex].hashit) {
+	rawhit->SetReference(dc.signal, fRefIndexMaps[dc.refindex].reftime);
+      } else {
+	if(!suppresswarnings) {
+#ifndef SUPPRESSMISSINGADCREFTIMEMESSAGES
+	  cout << "HitList(event=" << evdata.GetEvNum() << "): refindex " << dc.refindex <<
+	    " (" << fRefIndexMaps[dc.refindex].crate <<
+	    ", " << fRefIndexMaps[dc.refindex].slot <<
+	    ", " << fRefIndexMaps[dc.refindex].channel << ")" <<
+	    " missing for (" << dc.crate << ", " << dc.slot <<
+	    ", " << dc.chan << ")" << endl;
+#endif
+	  refmiss = kTRUE;
+	}
+      }
+    }
+  }
+}
+//_____________________________________________________________________________
 void THcHitList::CreateMissReportParms(const char *prefix)
 {
   /**
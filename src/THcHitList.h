@@ -2,6 +2,7 @@
 #define ROOT_THcHitList
 
 #include "THcRawHit.h"
+#include "THcFADC250PulseFinder.h"
 #include "THaDetMap.h"
 #include "THaEvData.h"
 #include "TClonesArray.h"
@@ -12,6 +13,8 @@
 
 #include <iomanip>
 #include <map>
+#include <set>
+#include <vector>
 
 using namespace std;
 
@@ -49,6 +52,7 @@ public:
   Bool_t        fTDC_RefTimeBest;
   Bool_t        fADC_RefTimeBest;
   TClonesArray* fRawHitList; // List of raw hits
+  std::vector<Int_t> fSampleArena; // FADC samples of all raw hits this event
   TClass* fRawHitClass;		  // Class of raw hit object to use
 
   THaDetMap*    fdMap;
@@ -62,12 +66,76 @@ protected:
     Int_t slot;
     Int_t channel;
     Int_t reftime;
+    Bool_t fadc;		// Read as FADC pulse time
   };
   std::vector<RefIndexMap> fRefIndexMaps;
+  std::vector<RefIndexMap> fRefChanMaps; // Reference channels (refchan) used by the decode plan
   // Should this be a sparse list instead in case user
   // picks ridiculously large refindexes?
 
   Int_t fNRefIndex;
+
+  // Dense (plane,counter) -> hit list slot lookup table.  Keys are
+  // assigned in (plane,counter) order so that sorting keys sorts hits.
+  Int_t GetHitKey(Int_t plane, Int_t counter) const
+  { return fPlaneKeyOffset[plane-fMinPlane] + counter - fPlaneMinCounter[plane-fMinPlane]; }
+  Int_t fMinPlane;
+  std::vector<Int_t> fPlaneKeyOffset;  // Key of lowest counter of each plane
+  std::vector<Int_t> fPlaneMinCounter; // Lowest counter of each plane
+  std::vector<Int_t> fKeyPlane;	       // Plane for each key
+  std::vector<Int_t> fKeyCounter;      // Counter for each key
+  std::vector<Int_t> fHitSlot;	       // Hit list slot for each key, -1 if no hit
+  std::vector<Int_t> fHitKeys;	       // Keys with hits in this event
+
+  // Decode plan compiled from the detector map in InitHitList
+  struct DecodeChan {		// One electronics channel
+    Int_t crate;
+    Int_t slot;
+    Int_t chan;
+    Int_t signal;
+    Int_t key;			// (plane,counter) key
+    Int_t refchan;
+    Int_t refindex;
+    Int_t refchanmap;		// Index into fRefChanMaps if refchan >= 0
+    Bool_t fadc;		// Decode as Flash ADC pulse data
+    Int_t next;			// Next entry for the same channel, -1 if none
+  };
+  struct DecodeSlot {		// One module
+    Int_t crate;
+    Int_t slot;
+    std::vector<Int_t> chanentry; // First DecodeChan of each channel, -1 if unused
+  };
+  std::vector<DecodeSlot> fDecodeSlots;
+  std::vector<DecodeChan> fDecodeChans;
+  Bool_t fDecodePlanResolved;	// Decode kernels picked from module types
+  std::vector<Int_t> fHitChans;	// DecodeChans with data in this event
+
+  void DecodeTDCChannel(const THaEvData& evdata, const DecodeChan& dc,
+			THcRawHit* rawhit, Bool_t suppresswarnings,
+			Bool_t& refmiss);
+  void DecodeFADCChannel(const THaEvData& evdata, const DecodeChan& dc,
+			 THcRawHit* rawhit, Int_t titime,
+			 Bool_t suppresswarnings, Bool_t& refmiss);
+  void SetPulseFinderCrate(Int_t crate);
+  Int_t GetTrigTimeShift(Int_t slot, Int_t titime);
+  void ResolveRefTime(const THaEvData& evdata, RefIndexMap& ref, Int_t titime);
+
+  // Reference times already found in this event, shared by all hit lists
+  struct RefTimeCacheEntry {
+    Int_t crate;
+    Int_t slot;
+    Int_t channel;
+    Bool_t fadc;
+    Int_t cut;
+    Bool_t best;
+    Bool_t hashit;
+    Int_t reftime;
+  };
+  static std::vector<RefTimeCacheEntry> fgRefTimeCache;
+  static UInt_t fgRefTimeCacheEvNum;
+  static UInt_t fgRefTimeCacheRunNum;
+  static UInt_t fgRefTimeCacheEvLength;
+
   UInt_t fNSignals;
   THcRawHit::ESignalType *fSignalTypes;
 
@@ -77,6 +145,14 @@ protected:
   Int_t fNSB;
   Int_t fNPED;
 
+  // Pulses found in software from the FADC samples
+  Int_t fSoftPulses;		// Replace firmware pulse data if nonzero
+  Int_t fSoftPulseTET;		// Threshold, <0 to use the config event ones
+  THcFADC250PulseFinder fPulseFinder;
+  Int_t fPulseFinderCrate;	// Crate fPulseFinder is set up for, -1 if none
+  Bool_t fPulseFinderOK;	// FADC250 parameters of that crate are known
+  std::set<Int_t> fSoftPulseWarned; // Crates warned about missing parameters
+
   Int_t fNTDCRef_miss;
   Int_t fNADCRef_miss;
 
@@ -48,6 +48,35 @@ hodoscope array, not just one plane.
 using namespace std;
 using std::vector;
 
+//_____________________________________________________________________________
+THcHodoTimeHist::THcHodoTimeHist( Int_t nbins, Double_t xlow, Double_t xup ) :
+  fNbins(nbins), fXmin(xlow), fXmax(xup), fCount(nbins+1,0)
+{
+  fTouched.reserve(nbins);
+  Reset();
+}
+
+//_____________________________________________________________________________
+void THcHodoTimeHist::Reset()
+{
+  for(UInt_t i=0;i<fTouched.size();i++) {
+    fCount[fTouched[i]] = 0;
+  }
+  fTouched.clear();
+  fMaxCount = 0;
+  fMaxBin = 1;
+  fSumW = fSumX = fSumX2 = 0.;
+}
+
+//_____________________________________________________________________________
+Double_t THcHodoTimeHist::GetRMS() const
+{
+  // As TH1::GetRMS: computed from the filled values, not bin centers
+  if( fSumW == 0 ) return 0;
+  Double_t x = fSumX/fSumW;
+  return TMath::Sqrt(TMath::Abs(fSumX2/fSumW - x*x));
+}
+
 //_____________________________________________________________________________
 THcHodoscope::THcHodoscope( const char* name, const char* description,
 				  THaApparatus* apparatus ) :
@@ -93,8 +122,6 @@ void THcHodoscope::Setup(const char* name, const char* description)
   TString temp(prefix[0]);
   fSHMS=kFALSE;
   if (temp == "p" ) fSHMS=kTRUE;
-  TString histname=temp+"_timehist";
-  hTime = new TH1F(histname,"",400,0,200);
   // cout << " fSHMS = " << fSHMS << endl;
   string planenamelist;
   DBRequest listextra[]={
@@ -782,7 +809,7 @@ void THcHodoscope::EstimateFocalPlaneTime()
    */
   Int_t ihit=0;
   Int_t nscinhits=0;		// Total # hits with at least one good tdc
-  hTime->Reset();
+  fTimeHist.Reset();
   //
   for(Int_t ip=0;ip<fNPlanes;ip++) {
     Int_t nphits=fPlanes[ip]->GetNScinHits();
@@ -793,8 +820,8 @@ void THcHodoscope::EstimateFocalPlaneTime()
       if(hit->GetHasCorrectedTimes()) {
 	Double_t postime=hit->GetPosTOFCorrectedTime();
 	Double_t negtime=hit->GetNegTOFCorrectedTime();
-	hTime->Fill(postime);
-	hTime->Fill(negtime);
+	fTimeHist.Fill(postime);
+	fTimeHist.Fill(negtime);
       }
     }
   }
@@ -807,10 +834,10 @@ void THcHodoscope::EstimateFocalPlaneTime()
   Double_t Plane_fptime_sum=0.0;
   Bool_t goodplanetime[fNPlanes];
   Bool_t twogoodtimes[nscinhits];
-  Double_t tmin = 0.5*hTime->GetMaximumBin();
+  Double_t tmin = 0.5*fTimeHist.GetMaximumBin();
   fTimeHist_Peak=  tmin;
-  fTimeHist_Sigma=  hTime->GetRMS();
-  fTimeHist_Hits=  hTime->Integral();
+  fTimeHist_Sigma=  fTimeHist.GetRMS();
+  fTimeHist_Hits=  fTimeHist.Integral();
   for(Int_t ip=0;ip<fNumPlanesBetaCalc;ip++) {
     goodplanetime[ip] = kFALSE;
     Int_t nphits=fPlanes[ip]->GetNScinHits();
@@ -864,7 +891,7 @@ void THcHodoscope::EstimateFocalPlaneTime()
   }
     //
    //
-  hTime->Reset();
+  fTimeHist.Reset();
   //
   if((goodplanetime[0]||goodplanetime[1]) &&(goodplanetime[2]||goodplanetime[3])) {
 
@@ -1045,7 +1072,7 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
 
       // Loop over scintillator planes.
       // In ENGINE, its loop over good scintillator hits.
-      hTime->Reset();
+      fTimeHist.Reset();
       fTOFCalc.clear();   // SAW - Can we
       fTOFPInfo.clear();  // SAW - combine these two?
       Int_t ihhit = 0;		// Hit # overall
@@ -1147,7 +1174,7 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
  	      timep -= zcor;
 	      fTOFPInfo[ihhit].time_pos = timep;
 
-              hTime->Fill(timep);
+              fTimeHist.Fill(timep);
 	    }
 	    Double_t tdc_neg = hit->GetNegTDC();
 	    if(tdc_neg >=fScinTdcMin && tdc_neg <= fScinTdcMax ) {
@@ -1171,7 +1198,7 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
 	      fTOFPInfo[ihhit].scin_neg_time = timen;
 	      timen -=  zcor;
 	      fTOFPInfo[ihhit].time_neg = timen;
-              hTime->Fill(timen);
+              fTimeHist.Fill(timen);
 	    }
 	  } // condition for cenetr on a paddle
 	  ihhit++;
@@ -1184,8 +1211,8 @@ Int_t THcHodoscope::CoarseProcess( TClonesArray& tracks )
       Int_t nhits=ihhit;
 
 
-      if(0.5*hTime->GetMaximumBin() > 0) {
-	Double_t tmin = 0.5*hTime->GetMaximumBin();
+      if(0.5*fTimeHist.GetMaximumBin() > 0) {
+	Double_t tmin = 0.5*fTimeHist.GetMaximumBin();
 	
 	for(Int_t ih = 0; ih < nhits; ih++) { // loop over all scintillator hits
 	  if ( ( fTOFPInfo[ih].time_pos > (tmin-fTofTolerance) ) && ( fTOFPInfo[ih].time_pos < ( tmin + fTofTolerance ) ) ) {
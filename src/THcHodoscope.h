@@ -34,6 +34,50 @@
 
 class THaScCalib;
 
+// Fixed-bin time histogram used to find the focal plane time peak.
+// Reproduces the TH1F quantities the hodoscope needs (maximum bin, RMS of
+// in-range entries, integral) without ROOT histogram overhead.  Only the
+// bins touched since the last Reset() are cleared.
+class THcHodoTimeHist {
+public:
+  THcHodoTimeHist( Int_t nbins=400, Double_t xlow=0., Double_t xup=200. );
+
+  void Reset();
+  Int_t FindBin( Double_t x ) const {
+    // Same as TAxis::FindBin: 0 is underflow, fNbins+1 overflow (and NaN)
+    if( x < fXmin ) return 0;
+    if( !(x < fXmax) ) return fNbins+1;
+    Int_t bin = 1 + Int_t(fNbins*(x-fXmin)/(fXmax-fXmin));
+    return (bin > fNbins) ? fNbins+1 : bin;	// Rounded up into overflow
+  }
+  void Fill( Double_t x ) {
+    // Under/overflow only count as entries, as in TH1::Fill.
+    Int_t bin = FindBin(x);
+    if( bin < 1 || bin > fNbins ) return;
+    Int_t c = ++fCount[bin];
+    if( c == 1 ) fTouched.push_back(bin);
+    if( c > fMaxCount || (c == fMaxCount && bin < fMaxBin) ) {
+      fMaxCount = c;
+      fMaxBin = bin;
+    }
+    fSumW += 1.;
+    fSumX += x;
+    fSumX2 += x*x;
+  }
+  Int_t    GetMaximumBin() const { return fMaxBin; }
+  Double_t GetRMS() const;
+  Double_t Integral() const { return fSumW; }
+
+private:
+  Int_t    fNbins;
+  Double_t fXmin, fXmax;
+  std::vector<Int_t> fCount;	// [nbins+1] bin contents, bin 0 unused
+  std::vector<Int_t> fTouched;	// Bins filled since last Reset
+  Int_t    fMaxCount;
+  Int_t    fMaxBin;		// First bin with fMaxCount (1 if empty)
+  Double_t fSumW, fSumX, fSumX2;
+};
+
 class THcHodoscope : public THaNonTrackingDetector, public THcHitList {
 
 public:
@@ -146,7 +190,7 @@ protected:
 
   Int_t fNHits;
 
-  TH1F *hTime;
+  THcHodoTimeHist fTimeHist;	//! Focal plane time peak finder
   // Calibration
   Double_t fRatio_xpfp_to_xfp;
   Double_t trackeff_scint_ydiff_max ;
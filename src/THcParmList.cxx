@@ -33,6 +33,9 @@ An instance of THaTextvars is created to hold the string parameters.
 \fn THcParmList::ReadArray(const char* attrC, T* array, Int_t size)
 \brief Copy values from parameter store to array.
 
+\fn THcParmList::GetIncludeChain(const char* fname, Int_t RunNumber, vector<string>& files)
+\brief List the files that loading a parameter file for a run would read.
+
 \fn THcParmList::PrintFull( Option_t* option )
 \brief Print all the numeric parameter desciptions and value and text parameters.
 
@@ -43,6 +46,8 @@ An instance of THaTextvars is created to hold the string parameters.
 #include "TObjArray.h"
 #include "TObjString.h"
 #include "TSystem.h"
+#include "TMD5.h"
+#include "TStopwatch.h"
 
 #include "THcParmList.h"
 #include "THaVar.h"
@@ -57,6 +62,8 @@ An instance of THaTextvars is created to hold the string parameters.
 #include <cstdlib>
 #include <stdexcept>
 #include <memory>
+#include <algorithm>
+#include <iterator>
 
 using namespace std;
 Int_t  fDebug   = 1;  // Keep this at one while we're working on the code
@@ -70,7 +77,8 @@ Int_t  fDebug   = 1;  // Keep this at one while we're working on the code
 ClassImp(THcParmList)
 
 /// Create empty numerical and string parameter lists
-THcParmList::THcParmList() : THaVarList()
+THcParmList::THcParmList() : THaVarList(),
+  fLastLoadTime(0), fLastParseTime(0), fLastLoadCached(kFALSE)
 {
   TextList = new THaTextvars;
 }
@@ -81,6 +89,88 @@ inline static bool IsComment( const string& s, string::size_type pos )
 	   (s[pos] == '#' || s[pos] == ';' || s.substr(pos,2) == "//") );
 }
 
+static const char* const whtspc = " \t";
+
+inline static string IncludeFileName( string line )
+{
+  // File name from an #include line
+  line.erase(0,strlen(INCLUDESTR));
+  string::size_type pos = line.find_first_not_of(whtspc);
+  // Strip leading white space
+  if(pos != string::npos && pos > 0 && pos < line.length()) {
+    line.erase(0,pos);
+  }
+  char quotechar=line[0];
+  if(quotechar == '"' || quotechar == '\'') {
+    line.erase(0,1);
+    line.erase(line.find_first_of(quotechar));
+  } else {
+    line.erase(line.find_first_of(whtspc));
+  }
+  return line;
+}
+
+static Bool_t RunInRanges( const string& line, Int_t RunNumber )
+{
+  // Check RunNumber against a comma separated list of run numbers and
+  // run number ranges
+  TString runnums(line.c_str());
+  SMART_PTR<TObjArray> runnumarr( runnums.Tokenize(",") );
+  Int_t nranges=runnumarr->GetLast()+1;
+
+  Int_t ind;
+  for(Int_t i=0;i<nranges;i++) {
+    TString runstr = ((TObjString *)runnumarr->At(i))->GetString();
+    if(runstr.IsDec()) {	// A single run number
+      if(RunNumber == runstr.Atoi()) {
+	return kTRUE;
+      }
+    } else if ((ind=runstr.First('-'))>=0) {		// A run range
+      TString start=runstr(0,ind);
+      TString end=runstr(ind+1,runstr.Length());
+      if(start.IsDec() && end.IsDec()) {
+	if((RunNumber >= start.Atoi()) && (RunNumber <= end.Atoi())) {
+	  return kTRUE;
+	}
+      }
+    }
+  }
+  return kFALSE;
+}
+
+static Int_t ClassifyLine( string line, string& ranges )
+{
+  // Classify a line of a parameter file the way Load sees it:
+  //  -1: include, blank, comment, begin or end line
+  //   0: parameter definition or continuation
+  //   1: run number range, stripped range list in ranges
+  if(line.compare(0,strlen(INCLUDESTR),INCLUDESTR)==0) return -1;
+  string::size_type start, pos = 0;
+  if( line.empty()
+      || (start = line.find_first_not_of( whtspc )) == string::npos
+      || IsComment(line, start) )
+    return -1;
+  while( (pos = line.find_first_of("#;/", pos+1)) != string::npos ) {
+    if( IsComment(line, pos) ) {
+      line.erase(pos);
+      break;
+    }
+  }
+  line.erase(0,start);
+  if(line.compare(0,5,"begin")==0 ||
+     line.compare(0,3,"end")==0) return -1;
+  // A range has no quotes, so all white space can go
+  string stripped;
+  for(pos=0;pos<line.length();pos++) {
+    if(line[pos] != ' ' && line[pos] != '\t') stripped += line[pos];
+  }
+  if(stripped.find_first_not_of("0123456789-,")==string::npos) {
+    ranges = stripped;
+    return 1;
+  }
+  return 0;
+}
+
 void THcParmList::Load( const char* fname, Int_t RunNumber )
 {
   /**
@@ -119,14 +209,61 @@ A parameter file can load other files with the include statement
 The ENGINE CTP support parameter "blocks" which were marked with
 `begin` and `end` statements.  These statements are ignored.
 
+When a run number is given, the file is a database whose lines
+following a run number list (e.g. `1000-1099,1200`) apply only to those
+runs.  An index of these blocks is built the first time a file is loaded
+(and kept in the cache directory, if one is set), so only the blocks for
+the run and the files they include are read.
+
+If a cache directory has been set with SetCacheDir, the list resulting
+from the load is saved there in binary form, together with the MD5
+checksums of every file that was read.  A later Load of the same file
+and run, starting from the same parameter list, restores the list from
+the cache if none of those files have changed, without parsing the
+text or evaluating any expressions.
+
   */
 
-  static const char* const whtspc = " \t";
+  TStopwatch timer;
+  timer.Start();
+
+  fLastLoadCached = kFALSE;
+  string cachefile, prestate;
+  if(!fCacheDir.empty()) {
+    cachefile = CacheFileName(fname, Form("%d.parmcache", RunNumber));
+    prestate = StateChecksum();
+    Double_t parsetime;
+    if(ReadCache(cachefile.c_str(), fname, RunNumber, prestate, parsetime)) {
+      fLastLoadCached = kTRUE;
+      fLastParseTime = parsetime;
+      fLastLoadTime = timer.RealTime();
+      cout << "Loaded parameters from cache " << cachefile << " in "
+	   << fLastLoadTime << " s (parsing took " << parsetime << " s)" << endl;
+      return;
+    }
+  }
+
+  LoadText(fname, RunNumber);
+  fLastLoadTime = fLastParseTime = timer.RealTime();
+
+  // Only cache a load whose top level file could be read
+  if(!cachefile.empty() && !fLoadFiles.empty() && !fLoadFiles[0].second.empty()) {
+    WriteCache(cachefile.c_str(), fname, RunNumber, prestate, fLastParseTime);
+  }
+}
+
+//_____________________________________________________________________________
+void THcParmList::LoadText( const char* fname, Int_t RunNumber )
+{
+  // Parse the parameter file fname and the files it includes.  See Load.
 
   ifstream ifiles[100];		// Should use stack instead
 
+  fLoadFiles.clear();
+
   Int_t nfiles=0;
   ifiles[nfiles].open(fname);
+  NoteLoadFile(fname, ifiles[nfiles].is_open());
   if(ifiles[nfiles].is_open()) {
     cout << "Opening parameter file: [" << nfiles << "] " << fname << endl;
     nfiles++;
@@ -153,12 +290,64 @@ The ENGINE CTP support parameter "blocks" which were marked with
     InRunRange = 1;		// Interpret all lines
   }
 
+  // With a run number, use the run range index of the top level file to
+  // read only the blocks for this run.  Without the index, every line is
+  // read and the run ranges are checked as they come.
+  const RunRangeIndex* runindex = 0;
+  vector<const RunRangeBlock*> runblocks;
+  UInt_t iblock = 0;
+  Long64_t blockend = -1;
+  if(RunNumber > 0) {
+    runindex = GetRunRangeIndex(fname);
+  }
+  if(runindex) {
+    for(UInt_t i=0;i<runindex->blocks.size();i++) {
+      if(RunInRanges(runindex->blocks[i].ranges, RunNumber)) {
+	runblocks.push_back(&runindex->blocks[i]);
+      }
+    }
+    // Never trust offsets that don't land on the range lines they were
+    // taken from; read the whole file instead
+    if(!CheckRunRangeBlocks(ifiles[0], runblocks)) {
+      cout << "THcParmList: run range index of " << fname
+	   << " is out of date, reading the whole file" << endl;
+      runblocks.clear();
+      runindex = 0;
+      DropRunRangeIndex(fname);
+    }
+  }
+  if(runindex) {
+    InRunRange = 1;		// Only lines in matching blocks are read
+    if(runindex->firstLineNotRange) {
+      cout << "WARNING: THcParmList::Load in database mode but first line is not" << endl;
+      cout << "   a run number or run number range.  Parameter definitions" << endl;
+      cout << "   will be ignored until a run number or range is specified." << endl;
+    }
+  }
+
   while(nfiles) {
     string current_comment("");
     // EJB_Note:  existing_comment is never used.
     // string existing_comment("");
     string::size_type start, pos = 0;
 
+    if(runindex && nfiles==1) {
+      // At the end of a block, jump to the next one for this run
+      Long64_t here = ifiles[0].tellg();
+      while(here < 0 || here >= blockend) {
+	if(iblock >= runblocks.size()) break;
+	ifiles[0].clear();
+	ifiles[0].seekg(runblocks[iblock]->begin);
+	here = runblocks[iblock]->begin;
+	blockend = runblocks[iblock]->end;
+	iblock++;
+      }
+      if(here < 0 || here >= blockend) {
+	ifiles[0].close();
+	nfiles--;
+	continue;
+      }
+    }
     if(!getline(ifiles[nfiles-1],line)) {
       ifiles[nfiles-1].close();
       nfiles--;
@@ -167,21 +356,10 @@ The ENGINE CTP support parameter "blocks" which were marked with
     }
     // Look for include statement
     if(line.compare(0,strlen(INCLUDESTR),INCLUDESTR)==0) {
-      line.erase(0,strlen(INCLUDESTR));
-      pos = line.find_first_not_of(whtspc);
-      // Strip leading white space
-      if(pos != string::npos && pos > 0 && pos < line.length()) {
-	line.erase(0,pos);
-      }
-      char quotechar=line[0];
-      if(quotechar == '"' || quotechar == '\'') {
-	line.erase(0,1);
-	line.erase(line.find_first_of(quotechar));
-      } else {
-	line.erase(line.find_first_of(whtspc));
-      }
+      line = IncludeFileName(line);
       //      cout << line << endl;
       ifiles[nfiles].open(line.c_str());
+      NoteLoadFile(line.c_str(), ifiles[nfiles].is_open());
       if(ifiles[nfiles].is_open()) {
 	cout << "Opening parameter file: [" << nfiles << "] " << line << endl;
 	nfiles++;
@@ -264,33 +442,10 @@ The ENGINE CTP support parameter "blocks" which were marked with
     linecount++;
     // If RunNumber>0 and first line we encounter is not a run range, need to
     // print an error
-    if(RunNumber>0 && nfiles==1) {
+    if(RunNumber>0 && nfiles==1 && !runindex) {
       if(line.find_first_not_of("0123456789-,")==string::npos) { // Interpret as runnum range
 	// Interpret line as a list of comma separated run numbers or ranges
-	TString runnums(line.c_str());
-	SMART_PTR<TObjArray> runnumarr( runnums.Tokenize(",") );
-	Int_t nranges=runnumarr->GetLast()+1;
-
-	InRunRange = 0;
-	Int_t ind;
-	for(Int_t i=0;i<nranges;i++) {
-	  TString runstr = ((TObjString *)runnumarr->At(i))->GetString();
-	  if(runstr.IsDec()) {	// A single run number
-	    if(RunNumber == runstr.Atoi()) {
-	      InRunRange = 1;
-	      break;
-	    }
-	  } else if ((ind=runstr.First('-'))>=0) {		// A run range
-	    TString start=runstr(0,ind);
-	    TString end=runstr(ind+1,runstr.Length());
-	    if(start.IsDec() && end.IsDec()) {
-	      if((RunNumber >= start.Atoi()) && (RunNumber <= end.Atoi())) {
-		InRunRange = 1;
-		break;
-	      }
-	    }
-	  }
-	}
+	InRunRange = RunInRanges(line, RunNumber) ? 1 : 0;
 	continue;		// Skip to next line
       } else {
 	if(linecount==1) {
@@ -518,6 +673,564 @@ The ENGINE CTP support parameter "blocks" which were marked with
   return;
 
 }
+//_____________________________________________________________________________
+static string FileChecksum( const char* fname )
+{
+  // MD5 checksum of a file as a hex string, empty if it can't be read
+  string sum;
+  TMD5* md5 = TMD5::FileChecksum(fname);
+  if(md5) {
+    sum = md5->AsString();
+    delete md5;
+  }
+  return sum;
+}
+
+//_____________________________________________________________________________
+void THcParmList::NoteLoadFile( const char* fname, Bool_t opened )
+{
+  // Record a file opened (or not found) by LoadText, for the cache
+  if(fCacheDir.empty()) return;
+  fLoadFiles.push_back(make_pair(string(fname),
+				 opened ? FileChecksum(fname) : string()));
+}
+
+//_____________________________________________________________________________
+string THcParmList::CacheFileName( const char* fname, const char* suffix ) const
+{
+  string name(fname);
+  replace(name.begin(), name.end(), '/', '_');
+  return fCacheDir + "/" + name + "." + suffix;
+}
+
+/*
+  Parameter cache format (native byte order).  Strings are stored as
+  a UInt_t length followed by the characters.
+
+    UInt_t magic, version
+    string file name, Int_t run number, string checksum of the parameter
+    list before the load, Double_t time taken by the text parsing
+    UInt_t number of files read, then for each: string name, string MD5
+    (empty if the file was not found)
+    UInt_t number of numerical parameters, then for each: string name,
+    string title, Int_t type (kInt or kDouble), Int_t length, values
+    UInt_t number of string parameters, then for each: string name,
+    UInt_t number of values, values
+*/
+static const UInt_t kParmCacheMagic   = 0x43504348; // "HCPC"
+static const UInt_t kParmCacheVersion = 1;
+
+static void PutBytes( string& buf, const void* p, size_t n )
+{
+  buf.append(static_cast<const char*>(p), n);
+}
+static void PutUInt( string& buf, UInt_t i ) { PutBytes(buf, &i, sizeof(i)); }
+static void PutString( string& buf, const string& str )
+{
+  PutUInt(buf, str.length());
+  buf.append(str);
+}
+
+// Read back what the Put functions wrote.  Any read past the end of the
+// buffer clears fOK and returns zeros.
+struct ParmCacheReader {
+  const char* fPos;
+  const char* fEnd;
+  Bool_t fOK;
+  ParmCacheReader( const string& buf )
+    : fPos(buf.data()), fEnd(buf.data()+buf.length()), fOK(kTRUE) {}
+  void Get( void* p, size_t n ) {
+    if(!fOK || (size_t)(fEnd-fPos) < n) {
+      fOK = kFALSE;
+      memset(p, 0, n);
+      return;
+    }
+    memcpy(p, fPos, n);
+    fPos += n;
+  }
+  UInt_t GetUInt() { UInt_t i; Get(&i, sizeof(i)); return i; }
+  Int_t GetInt() { Int_t i; Get(&i, sizeof(i)); return i; }
+  string GetString() {
+    UInt_t n = GetUInt();
+    if(!fOK || (size_t)(fEnd-fPos) < n) {
+      fOK = kFALSE;
+      return string();
+    }
+    string str(fPos, n);
+    fPos += n;
+    return str;
+  }
+};
+
+// A numerical parameter decoded from a cache.  values points into the
+// cache buffer.
+struct CachedVar {
+  string name, title;
+  Int_t type, len;
+  const char* values;
+};
+
+static bool VarNameLess( const THaVar* a, const THaVar* b )
+{
+  return strcmp(a->GetName(), b->GetName()) < 0;
+}
+
+//_____________________________________________________________________________
+void THcParmList::SerializeState( string& buf, Bool_t all ) const
+{
+  // Append the numerical and string parameters to buf, sorted by name so
+  // that the result does not depend on the order of definition.  With
+  // all set, also append the names of variables of other types.  Those
+  // are not restored from a cache, but they are part of the state checksum.
+
+  vector<THaVar*> vars, others;
+  TIter next(this);
+  while( THaVar* var = static_cast<THaVar*>(next()) ) {
+    if(var->GetType() == kInt || var->GetType() == kDouble) {
+      vars.push_back(var);
+    } else {
+      others.push_back(var);
+    }
+  }
+  sort(vars.begin(), vars.end(), VarNameLess);
+
+  PutUInt(buf, vars.size());
+  for(UInt_t i=0;i<vars.size();i++) {
+    const THaVar* var = vars[i];
+    Int_t type = var->GetType();
+    Int_t len = var->GetLen();
+    PutString(buf, var->GetName());
+    PutString(buf, var->GetTitle());
+    PutBytes(buf, &type, sizeof(type));
+    PutBytes(buf, &len, sizeof(len));
+    PutBytes(buf, var->GetValuePointer(),
+	     len*(type == kInt ? sizeof(Int_t) : sizeof(Double_t)));
+  }
+
+  vector<string> names = TextList->GetNames();
+  sort(names.begin(), names.end());
+  PutUInt(buf, names.size());
+  for(UInt_t i=0;i<names.size();i++) {
+    Int_t nvalues = TextList->GetNvalues(names[i]);
+    PutString(buf, names[i]);
+    PutUInt(buf, nvalues);
+    for(Int_t j=0;j<nvalues;j++) {
+      PutString(buf, TextList->Get(names[i], j));
+    }
+  }
+
+  if(all) {
+    sort(others.begin(), others.end(), VarNameLess);
+    PutUInt(buf, others.size());
+    for(UInt_t i=0;i<others.size();i++) {
+      Int_t type = others[i]->GetType();
+      PutString(buf, others[i]->GetName());
+      PutBytes(buf, &type, sizeof(type));
+    }
+  }
+}
+
+//_____________________________________________________________________________
+string THcParmList::StateChecksum() const
+{
+  // MD5 checksum of the current parameter list
+  string buf;
+  SerializeState(buf, kTRUE);
+  TMD5 md5;
+  md5.Update((const UChar_t*)buf.data(), buf.length());
+  md5.Final();
+  return md5.AsString();
+}
+
+//_____________________________________________________________________________
+Bool_t THcParmList::ReadCache( const char* cachefile, const char* fname,
+			       Int_t RunNumber, const string& prestate,
+			       Double_t& parsetime )
+{
+  // Restore the parameter list from cachefile if it was written by a
+  // load of fname for RunNumber that started from the current list and
+  // none of the files that load read have changed since.
+
+  ifstream ifile(cachefile, ios::in | ios::binary);
+  if(!ifile.is_open()) return kFALSE;
+  ifile.seekg(0, ios::end);
+  streamoff size = ifile.tellg();
+  if(size <= 0) return kFALSE;
+  string buf(size, '\0');
+  ifile.seekg(0, ios::beg);
+  ifile.read(&buf[0], buf.length());
+  if(!ifile) return kFALSE;
+  ifile.close();
+
+  ParmCacheReader in(buf);
+  if(in.GetUInt() != kParmCacheMagic || in.GetUInt() != kParmCacheVersion) {
+    cout << "Ignoring parameter cache " << cachefile << " of unknown format" << endl;
+    return kFALSE;
+  }
+  if(in.GetString() != fname || in.GetInt() != RunNumber ||
+     in.GetString() != prestate) {
+    return kFALSE;
+  }
+  in.Get(&parsetime, sizeof(parsetime));
+  UInt_t nfiles = in.GetUInt();
+  for(UInt_t i=0;in.fOK && i<nfiles;i++) {
+    string file = in.GetString();
+    string sum = in.GetString();
+    if(in.fOK && FileChecksum(file.c_str()) != sum) {
+      cout << "Parameter cache " << cachefile << " is out of date: "
+	   << file << " has changed" << endl;
+      return kFALSE;
+    }
+  }
+
+  // Decode everything before changing the list
+  vector<CachedVar> vars(in.GetUInt());
+  for(UInt_t i=0;in.fOK && i<vars.size();i++) {
+    CachedVar& var = vars[i];
+    var.name = in.GetString();
+    var.title = in.GetString();
+    var.type = in.GetInt();
+    var.len = in.GetInt();
+    size_t nbytes = var.len*(var.type == kInt ? sizeof(Int_t) : sizeof(Double_t));
+    if(var.len < 0 || (var.type != kInt && var.type != kDouble) ||
+       (size_t)(in.fEnd-in.fPos) < nbytes) {
+      in.fOK = kFALSE;
+      break;
+    }
+    var.values = in.fPos;
+    in.fPos += nbytes;
+  }
+  vector<pair<string,vector<string> > > strings(in.GetUInt());
+  for(UInt_t i=0;in.fOK && i<strings.size();i++) {
+    strings[i].first = in.GetString();
+    UInt_t nvalues = in.GetUInt();
+    for(UInt_t j=0;in.fOK && j<nvalues;j++) {
+      strings[i].second.push_back(in.GetString());
+    }
+  }
+  if(!in.fOK) {
+    cout << "Error reading parameter cache " << cachefile << endl;
+    return kFALSE;
+  }
+
+  for(UInt_t i=0;i<vars.size();i++) {
+    const CachedVar& var = vars[i];
+    THaVar* existingvar=Find(var.name.c_str());
+    if(existingvar) {
+      if(existingvar->GetType() == kDouble) {
+	delete [] (Double_t*) existingvar->GetValuePointer();
+      } else if (existingvar->GetType() == kInt) {
+	delete [] (Int_t*) existingvar->GetValuePointer();
+      }
+      RemoveName(var.name.c_str());
+    }
+    char *arrayname=new char [var.name.length()+20];
+    sprintf(arrayname,"%s[%d]",var.name.c_str(),var.len);
+    if(var.type == kInt) {
+      Int_t* ip = new Int_t[var.len];
+      memcpy(ip, var.values, var.len*sizeof(Int_t));
+      Define(arrayname, var.title.c_str(), *ip);
+    } else {
+      Double_t* fp = new Double_t[var.len];
+      memcpy(fp, var.values, var.len*sizeof(Double_t));
+      Define(arrayname, var.title.c_str(), *fp);
+    }
+    delete[] arrayname;
+  }
+  for(UInt_t i=0;i<strings.size();i++) {
+    RemoveString(strings[i].first);
+    for(UInt_t j=0;j<strings[i].second.size();j++) {
+      AddString(strings[i].first, strings[i].second[j]);
+    }
+  }
+
+  return kTRUE;
+}
+
+//_____________________________________________________________________________
+void THcParmList::WriteCache( const char* cachefile, const char* fname,
+			      Int_t RunNumber, const string& prestate,
+			      Double_t parsetime ) const
+{
+  // Save the parameter list after a text load in cachefile
+
+  string buf;
+  PutUInt(buf, kParmCacheMagic);
+  PutUInt(buf, kParmCacheVersion);
+  PutString(buf, fname);
+  PutBytes(buf, &RunNumber, sizeof(RunNumber));
+  PutString(buf, prestate);
+  PutBytes(buf, &parsetime, sizeof(parsetime));
+  PutUInt(buf, fLoadFiles.size());
+  for(UInt_t i=0;i<fLoadFiles.size();i++) {
+    PutString(buf, fLoadFiles[i].first);
+    PutString(buf, fLoadFiles[i].second);
+  }
+  SerializeState(buf, kFALSE);
+
+  if(gSystem->AccessPathName(fCacheDir.c_str())) {
+    gSystem->mkdir(fCacheDir.c_str(), kTRUE);
+  }
+  // Write to a temporary file first so that jobs sharing the cache
+  // directory never see a partial file
+  string tmpfile = string(cachefile) + Form(".%d", gSystem->GetPid());
+  ofstream ofile(tmpfile.c_str(), ios::out | ios::binary);
+  if(!ofile.is_open()) {
+    cout << "Unable to write parameter cache " << cachefile << endl;
+    return;
+  }
+  ofile.write(buf.data(), buf.length());
+  ofile.close();
+  if(!ofile || gSystem->Rename(tmpfile.c_str(), cachefile)) {
+    cout << "Unable to write parameter cache " << cachefile << endl;
+    gSystem->Unlink(tmpfile.c_str());
+    return;
+  }
+  cout << "Wrote parameter cache " << cachefile << endl;
+}
+
+//_____________________________________________________________________________
+Bool_t THcParmList::BuildRunRangeIndex( const char* fname,
+					RunRangeIndex& index ) const
+{
+  // Find the run number range lines of a database file.  Each starts a
+  // block that runs to the next range line or the end of the file.
+
+  ifstream ifile(fname);
+  if(!ifile.is_open()) return kFALSE;
+
+  index.blocks.clear();
+  index.firstLineNotRange = kFALSE;
+  Bool_t firstline = kTRUE;
+  string line, ranges;
+  Long64_t pos = 0;
+  while(getline(ifile,line)) {
+    Long64_t next = pos + line.length() + 1;
+    Int_t type = ClassifyLine(line, ranges);
+    if(type >= 0 && firstline) {
+      index.firstLineNotRange = (type == 0);
+      firstline = kFALSE;
+    }
+    if(type == 1) {
+      if(!index.blocks.empty()) index.blocks.back().end = pos;
+      RunRangeBlock block;
+      block.ranges = ranges;
+      block.header = pos;
+      block.begin = next;
+      index.blocks.push_back(block);
+    }
+    pos = next;
+  }
+  if(!index.blocks.empty()) index.blocks.back().end = pos;
+  return kTRUE;
+}
+
+/*
+  Run range index file format (native byte order): UInt_t magic and
+  version, Long64_t size and modification time of the database file,
+  string MD5 checksum of the database file, Int_t firstLineNotRange,
+  UInt_t number of blocks, then for each block the range string and the
+  Long64_t header, begin and end offsets.
+*/
+static const UInt_t kRunIndexMagic   = 0x49525048; // "HPRI"
+static const UInt_t kRunIndexVersion = 2;
+
+//_____________________________________________________________________________
+Bool_t THcParmList::ReadRunRangeIndex( const char* file,
+				       RunRangeIndex& index ) const
+{
+  ifstream ifile(file, ios::in | ios::binary);
+  if(!ifile.is_open()) return kFALSE;
+  string buf((istreambuf_iterator<char>(ifile)), istreambuf_iterator<char>());
+
+  ParmCacheReader in(buf);
+  if(in.GetUInt() != kRunIndexMagic || in.GetUInt() != kRunIndexVersion)
+    return kFALSE;
+  in.Get(&index.size, sizeof(index.size));
+  in.Get(&index.mtime, sizeof(index.mtime));
+  index.md5 = in.GetString();
+  index.firstLineNotRange = (in.GetInt() != 0);
+  UInt_t nblocks = in.GetUInt();
+  index.blocks.clear();
+  for(UInt_t i=0;in.fOK && i<nblocks;i++) {
+    RunRangeBlock block;
+    block.ranges = in.GetString();
+    in.Get(&block.header, sizeof(block.header));
+    in.Get(&block.begin, sizeof(block.begin));
+    in.Get(&block.end, sizeof(block.end));
+    index.blocks.push_back(block);
+  }
+  return in.fOK;
+}
+
+//_____________________________________________________________________________
+void THcParmList::WriteRunRangeIndex( const char* file,
+				      const RunRangeIndex& index ) const
+{
+  string buf;
+  PutUInt(buf, kRunIndexMagic);
+  PutUInt(buf, kRunIndexVersion);
+  PutBytes(buf, &index.size, sizeof(index.size));
+  PutBytes(buf, &index.mtime, sizeof(index.mtime));
+  PutString(buf, index.md5);
+  PutUInt(buf, index.firstLineNotRange ? 1 : 0);
+  PutUInt(buf, index.blocks.size());
+  for(UInt_t i=0;i<index.blocks.size();i++) {
+    PutString(buf, index.blocks[i].ranges);
+    PutBytes(buf, &index.blocks[i].header, sizeof(index.blocks[i].header));
+    PutBytes(buf, &index.blocks[i].begin, sizeof(index.blocks[i].begin));
+    PutBytes(buf, &index.blocks[i].end, sizeof(index.blocks[i].end));
+  }
+
+  if(gSystem->AccessPathName(fCacheDir.c_str())) {
+    gSystem->mkdir(fCacheDir.c_str(), kTRUE);
+  }
+  string tmpfile = string(file) + Form(".%d", gSystem->GetPid());
+  ofstream ofile(tmpfile.c_str(), ios::out | ios::binary);
+  if(!ofile.is_open()) return;
+  ofile.write(buf.data(), buf.length());
+  ofile.close();
+  if(!ofile || gSystem->Rename(tmpfile.c_str(), file)) {
+    gSystem->Unlink(tmpfile.c_str());
+  }
+}
+
+//_____________________________________________________________________________
+const THcParmList::RunRangeIndex* THcParmList::GetRunRangeIndex( const char* fname )
+{
+  // Run range index of a database file.  Indexes are kept for the life
+  // of the list and, if a cache directory is set, saved there.  An index
+  // is rebuilt when the size, modification time or MD5 checksum of the
+  // file changes.  Returns 0 if the file can't be read.
+
+  FileStat_t stat;
+  if(gSystem->GetPathInfo(fname, stat)) return 0;
+  string md5 = FileChecksum(fname);
+  if(md5.empty()) return 0;
+
+  map<string,RunRangeIndex>::iterator it = fRunIndex.find(fname);
+  if(it != fRunIndex.end() && it->second.size == stat.fSize
+     && it->second.mtime == stat.fMtime && it->second.md5 == md5) {
+    return &it->second;
+  }
+
+  RunRangeIndex index;
+  string indexfile;
+  if(!fCacheDir.empty()) {
+    indexfile = CacheFileName(fname, "runindex");
+  }
+  if(indexfile.empty() || !ReadRunRangeIndex(indexfile.c_str(), index)
+     || index.size != stat.fSize || index.mtime != stat.fMtime
+     || index.md5 != md5) {
+    if(!BuildRunRangeIndex(fname, index)) return 0;
+    index.size = stat.fSize;
+    index.mtime = stat.fMtime;
+    index.md5 = md5;
+    if(!indexfile.empty()) {
+      WriteRunRangeIndex(indexfile.c_str(), index);
+    }
+  }
+  RunRangeIndex& saved = fRunIndex[fname];
+  saved = index;
+  return &saved;
+}
+
+//_____________________________________________________________________________
+Bool_t THcParmList::CheckRunRangeBlocks( istream& ifile,
+			const vector<const RunRangeBlock*>& blocks ) const
+{
+  // Check that each block starts right after the run range line it was
+  // indexed from.  Leaves ifile cleared and at the start of the file.
+
+  Bool_t ok = kTRUE;
+  string line, ranges;
+  for(UInt_t i=0;ok && i<blocks.size();i++) {
+    ifile.clear();
+    ifile.seekg(blocks[i]->header);
+    ok = getline(ifile,line) && ClassifyLine(line, ranges) == 1
+      && ranges == blocks[i]->ranges
+      && blocks[i]->header + (Long64_t)line.length() + 1 == blocks[i]->begin;
+  }
+  ifile.clear();
+  ifile.seekg(0);
+  return ok;
+}
+
+//_____________________________________________________________________________
+void THcParmList::DropRunRangeIndex( const char* fname )
+{
+  // Forget the run range index of fname, in memory and in the cache
+  fRunIndex.erase(fname);
+  if(!fCacheDir.empty()) {
+    gSystem->Unlink(CacheFileName(fname, "runindex").c_str());
+  }
+}
+
+//_____________________________________________________________________________
+Int_t THcParmList::GetIncludeChain( const char* fname, Int_t RunNumber,
+				    vector<string>& files )
+{
+  /**
+     List the parameter files that Load(fname, RunNumber) reads, in the
+     order they are opened.  Only #include lines are looked at, and with
+     a run number only the blocks of the top level file for that run are
+     read.  Files that can't be opened are not listed.  Returns the
+     number of files.
+  */
+  files.clear();
+  ScanIncludes(fname, RunNumber, 0, files);
+  return files.size();
+}
+
+//_____________________________________________________________________________
+void THcParmList::ScanIncludes( const char* fname, Int_t RunNumber,
+				Int_t depth, vector<string>& files )
+{
+  if(depth >= 100) return;	// Same nesting limit as Load
+  ifstream ifile(fname);
+  if(!ifile.is_open()) return;
+  files.push_back(fname);
+
+  // Regions of the file to read: the whole file, or the blocks for this
+  // run of a top level database file
+  vector<pair<Long64_t,Long64_t> > regions;
+  const RunRangeIndex* runindex = 0;
+  if(depth == 0 && RunNumber > 0) runindex = GetRunRangeIndex(fname);
+  Bool_t wholefile = (runindex == 0);
+  if(runindex) {
+    vector<const RunRangeBlock*> runblocks;
+    for(UInt_t i=0;i<runindex->blocks.size();i++) {
+      const RunRangeBlock& block = runindex->blocks[i];
+      if(RunInRanges(block.ranges, RunNumber)) {
+	runblocks.push_back(&block);
+	regions.push_back(make_pair(block.begin, block.end));
+      }
+    }
+    if(!CheckRunRangeBlocks(ifile, runblocks)) {
+      regions.clear();
+      wholefile = kTRUE;
+      DropRunRangeIndex(fname);
+    }
+  }
+  if(wholefile) {
+    regions.push_back(make_pair(Long64_t(0), Long64_t(-1)));
+  }
+
+  string line;
+  for(UInt_t i=0;i<regions.size();i++) {
+    ifile.clear();
+    ifile.seekg(regions[i].first);
+    Long64_t pos = regions[i].first;
+    while((regions[i].second < 0 || pos < regions[i].second)
+	  && getline(ifile,line)) {
+      pos += line.length() + 1;
+      if(line.compare(0,strlen(INCLUDESTR),INCLUDESTR)==0) {
+	ScanIncludes(IncludeFileName(line).c_str(), RunNumber, depth+1, files);
+      }
+    }
+  }
+}
+
 //_____________________________________________________________________________
 Int_t THcParmList::LoadParmValues(const DBRequest* list, const char* prefix)
 {
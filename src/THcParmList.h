@@ -9,6 +9,10 @@
 
 #include "THaVarList.h"
 #include "THaTextvars.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
 
 #ifdef WITH_CCDB
 #ifdef __CINT__
@@ -33,6 +37,19 @@ public:
 
   virtual void Load( const char *fname, Int_t RunNumber=0);
 
+  // Binary cache of loaded parameter lists
+  void SetCacheDir(const char* dir) { fCacheDir = dir ? dir : ""; }
+  const char* GetCacheDir() const { return fCacheDir.c_str(); }
+  // Timing of the last Load.  For a load from the cache, the parse time
+  // is that of the load that wrote the cache.
+  Double_t GetLastLoadTime() const { return fLastLoadTime; }
+  Double_t GetLastParseTime() const { return fLastParseTime; }
+  Bool_t   IsLastLoadCached() const { return fLastLoadCached; }
+
+  // Files a Load of fname for RunNumber would read, without loading them
+  Int_t GetIncludeChain(const char* fname, Int_t RunNumber,
+			std::vector<std::string>& files);
+
   virtual void PrintFull(Option_t *opt="") const;
 
   const char* GetString(const std::string& name) const {
@@ -63,6 +80,50 @@ private:
 
   THaTextvars* TextList;  //! Dictionary of string parameters
 
+  std::string fCacheDir;	// Directory for parameter caches (none if empty)
+  std::vector<std::pair<std::string,std::string> > fLoadFiles; //! Files read by the last text load and their checksums
+  Double_t fLastLoadTime;	// Time taken by the last Load (s)
+  Double_t fLastParseTime;	// Time taken by text parsing (s)
+  Bool_t   fLastLoadCached;	// Last Load came from the cache
+
+  // Blocks of a database file following a run number range line.
+  // header, begin and end are byte offsets of the range line, of the
+  // block's first line and of the next range line (or the end of the file).
+  struct RunRangeBlock {
+    std::string ranges;
+    Long64_t header;
+    Long64_t begin;
+    Long64_t end;
+  };
+  struct RunRangeIndex {
+    Long64_t size;		// Size and modification time of the file
+    Long64_t mtime;		//  when the index was built
+    std::string md5;		// MD5 checksum of the file
+    Bool_t firstLineNotRange;
+    std::vector<RunRangeBlock> blocks;
+  };
+  std::map<std::string,RunRangeIndex> fRunIndex; //! Indexes of database files
+
+  const RunRangeIndex* GetRunRangeIndex( const char* fname );
+  Bool_t BuildRunRangeIndex( const char* fname, RunRangeIndex& index ) const;
+  Bool_t ReadRunRangeIndex( const char* file, RunRangeIndex& index ) const;
+  void WriteRunRangeIndex( const char* file, const RunRangeIndex& index ) const;
+  Bool_t CheckRunRangeBlocks( std::istream& ifile,
+			      const std::vector<const RunRangeBlock*>& blocks ) const;
+  void DropRunRangeIndex( const char* fname );
+  void ScanIncludes( const char* fname, Int_t RunNumber, Int_t depth,
+		     std::vector<std::string>& files );
+
+  void LoadText( const char* fname, Int_t RunNumber );
+  void NoteLoadFile( const char* fname, Bool_t opened );
+  std::string CacheFileName( const char* fname, const char* suffix ) const;
+  void SerializeState( std::string& buf, Bool_t all ) const;
+  std::string StateChecksum() const;
+  Bool_t ReadCache( const char* cachefile, const char* fname, Int_t RunNumber,
+		    const std::string& prestate, Double_t& parsetime );
+  void WriteCache( const char* cachefile, const char* fname, Int_t RunNumber,
+		   const std::string& prestate, Double_t parsetime ) const;
+
 #ifdef WITH_CCDB
   SQLiteCalibration* CCDB_obj;
 #endif
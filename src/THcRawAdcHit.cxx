@@ -4,6 +4,12 @@
 \brief Class representing a single raw ADC hit.
 
 It supports rich data from flash 250 ADC modules.
+
+Waveform samples are not stored in the hit itself.  They are appended to a
+sample arena, a vector owned by the THcHitList that decoded the hit and
+cleared once per event; the hit only keeps the offset and number of its
+samples.  Samples of a copied hit therefore refer to the same arena and
+are only valid for the current event.
 */
 
 /**
@@ -42,6 +48,22 @@ Should be used for old style ADCs.
 \brief Sets raw signal sample.
 \param[in] data Raw signal sample. In channels.
 \throw std::out_of_range Tried to set too many samples.
+\throw std::logic_error No sample arena set.
+
+The samples of a hit are kept contiguous in the arena.  If another hit has
+added samples since the last call, the samples of this hit are first moved
+to the end of the arena.
+*/
+
+/**
+\fn void THcRawAdcHit::SetSampleArena(std::vector<Int_t>* arena)
+\brief Sets the per-event storage that SetSample appends to.
+\param[in] arena Sample arena. Not owned.
+*/
+
+/**
+\fn const Int_t* THcRawAdcHit::GetSamples() const
+\brief Gets pointer to the first sample of this hit in the arena, or 0.
 */
 
 /**
@@ -198,8 +220,9 @@ THcRawAdcHit::THcRawAdcHit() :
   fNPedestalSamples(4), fNPeakSamples(9),
   fPeakPedestalRatio(1.0*fNPeakSamples/fNPedestalSamples),
   fSubsampleToTimeFactor(0.0625),
-  fPed(0), fPulseInt(), fPulseAmp(), fPulseTime(), fSample(),
-  fRefTime(0), fHasMulti(kFALSE), fHasRefTime(kFALSE), fNPulses(0), fNSamples(0)
+  fPed(0), fPulseInt(), fPulseAmp(), fPulseTime(),
+  fRefTime(0), fSampleArena(0), fSampleOffset(0),
+  fHasMulti(kFALSE), fHasRefTime(kFALSE), fNPulses(0), fNSamples(0)
 {}
 
 THcRawAdcHit& THcRawAdcHit::operator=(const THcRawAdcHit& right) {
@@ -212,9 +235,8 @@ THcRawAdcHit& THcRawAdcHit::operator=(const THcRawAdcHit& right) {
       fPulseAmp[i]  = right.fPulseAmp[i];
       fPulseTime[i] = right.fPulseTime[i];
     }
-    for (UInt_t i=0; i<fMaxNSamples; ++i) {
-      fSample[i] = right.fSample[i];
-    }
+    fSampleArena  = right.fSampleArena;
+    fSampleOffset = right.fSampleOffset;
     fHasMulti = right.fHasMulti;
     fNPulses  = right.fNPulses;
     fNSamples = right.fNSamples;
@@ -236,9 +258,7 @@ void THcRawAdcHit::Clear(Option_t* opt) {
     fPulseAmp[i] = 0;
     fPulseTime[i] = 0;
   }
-  for (UInt_t i=0; i<fNSamples; ++i) {
-    fSample[i] = 0 ;
-  }
+  fSampleOffset = 0;
   fHasMulti = kFALSE;
   fNPulses = 0;
   fNSamples = 0;
@@ -267,10 +287,35 @@ void THcRawAdcHit::SetSample(Int_t data) {
       "`THcRawAdcHit::SetSample`: too many samples!"
     );
   }
-  fSample[fNSamples] = data;
+  if (!fSampleArena) {
+    throw std::logic_error(
+      "`THcRawAdcHit::SetSample`: no sample arena!"
+    );
+  }
+  std::vector<Int_t>& arena = *fSampleArena;
+  if (fNSamples == 0) {
+    fSampleOffset = arena.size();
+  }
+  else if (fSampleOffset+fNSamples != arena.size()) {
+    UInt_t offset = arena.size();
+    for (UInt_t i=0; i<fNSamples; ++i) {
+      Int_t sample = arena[fSampleOffset+i];
+      arena.push_back(sample);
+    }
+    fSampleOffset = offset;
+  }
+  arena.push_back(data);
   ++fNSamples;
 }
 
+void THcRawAdcHit::SetSampleArena(std::vector<Int_t>* arena) {
+  fSampleArena = arena;
+}
+
+const Int_t* THcRawAdcHit::GetSamples() const {
+  return fNSamples > 0 ? &(*fSampleArena)[fSampleOffset] : 0;
+}
+
 void THcRawAdcHit::SetDataTimePedestalPeak(
   Int_t data, Int_t time, Int_t pedestal, Int_t peak
 ) {
@@ -311,9 +356,10 @@ Double_t THcRawAdcHit::GetAverage(UInt_t iSampleLow, UInt_t iSampleHigh) const {
     throw std::out_of_range(msg.Data());
   }
   else {
+    const Int_t* samples = GetSamples();
     Double_t average = 0.0;
     for (UInt_t i=iSampleLow; i<=iSampleHigh; ++i) {
-      average += fSample[i];
+      average += samples[i];
     }
     return average / (iSampleHigh - iSampleLow + 1);
   }
@@ -328,9 +374,10 @@ Int_t THcRawAdcHit::GetIntegral(UInt_t iSampleLow, UInt_t iSampleHigh) const {
     throw std::out_of_range(msg.Data());
   }
   else {
+    const Int_t* samples = GetSamples();
     Int_t integral = 0;
     for (UInt_t i=iSampleLow; i<=iSampleHigh; ++i) {
-      integral += fSample[i];
+      integral += samples[i];
     }
     return integral;
   }
@@ -410,7 +457,7 @@ Int_t THcRawAdcHit::GetPulseTimeRaw(UInt_t iPulse) const {
 
 Int_t THcRawAdcHit::GetSampleRaw(UInt_t iSample) const {
   if (iSample < fNSamples) {
-    return fSample[iSample];
+    return GetSamples()[iSample];
   }
   else {
     TString msg = TString::Format(
@@ -442,10 +489,11 @@ Double_t THcRawAdcHit::GetPulseTime(UInt_t iPulse) const {
 }
 
 Int_t THcRawAdcHit::GetSampleIntRaw() const {
+  const Int_t* samples = GetSamples();
   Int_t integral = 0;
 
   for (UInt_t iSample=0; iSample<fNSamples; ++iSample) {
-    integral += fSample[iSample];
+    integral += samples[iSample];
   }
 
   return integral;
@@ -2,6 +2,7 @@
 #define ROOT_THcRawAdcHit
 
 #include "TObject.h"
+#include <vector>
 
 
 class THcRawAdcHit : public TObject {
@@ -14,13 +15,14 @@ class THcRawAdcHit : public TObject {
 
     void SetData(Int_t data);
     void SetSample(Int_t data);
+    void SetSampleArena(std::vector<Int_t>* arena);
     void SetRefTime(Int_t refTime);
     void SetDataTimePedestalPeak(
       Int_t data, Int_t time, Int_t pedestal, Int_t peak
     );
 
     Int_t GetRawData(UInt_t iPulse=0) const;
-    Double_t GetF250_PeakPedestalRatio() {return fPeakPedestalRatio;};
+    Double_t GetF250_PeakPedestalRatio() const {return fPeakPedestalRatio;};
 
     Double_t GetAverage(UInt_t iSampleLow, UInt_t iSampleHigh) const;
     Int_t GetIntegral(UInt_t iSampleLow, UInt_t iSampleHigh) const;
@@ -75,15 +77,24 @@ class THcRawAdcHit : public TObject {
     Int_t fPulseInt[fMaxNPulses];
     Int_t fPulseAmp[fMaxNPulses];
     Int_t fPulseTime[fMaxNPulses];
-    Int_t fSample[fMaxNSamples];
     Int_t fRefTime;
 
+    // Samples are stored in a per-event arena owned by the hit list
+    std::vector<Int_t>* fSampleArena;  //! Not owned
+    UInt_t fSampleOffset;              // Index of first sample in arena
+
     Bool_t fHasMulti;
     Bool_t fHasRefTime;
     UInt_t fNPulses;
     UInt_t fNSamples;
 
+    const Int_t* GetSamples() const;
+
   private:
+    // Not implemented, so a by-value copy of a hit fails to compile.
+    // Use references, or operator= where a copy is really needed.
+    THcRawAdcHit(const THcRawAdcHit&);
+
     ClassDef(THcRawAdcHit, 0)
 };
 
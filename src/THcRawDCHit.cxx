@@ -130,4 +130,9 @@ THcRawTdcHit& THcRawDCHit::GetRawTdcHit() {
 }
 
 
+const THcRawTdcHit& THcRawDCHit::GetRawTdcHit() const {
+  return fTdcHit;
+}
+
+
 ClassImp(THcRawDCHit)
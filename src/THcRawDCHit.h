@@ -28,6 +28,7 @@ class THcRawDCHit : public THcRawHit {
     virtual Bool_t HasReference(Int_t signal);
 
     THcRawTdcHit& GetRawTdcHit();
+    const THcRawTdcHit& GetRawTdcHit() const;
 
   protected:
     static const Int_t fNTdcSignals = 1;
@@ -35,6 +36,9 @@ class THcRawDCHit : public THcRawHit {
     THcRawTdcHit fTdcHit;
 
   private:
+    // Not implemented; pass raw hits by reference.
+    THcRawDCHit(const THcRawDCHit&);
+
     ClassDef(THcRawDCHit, 0);	// Raw Drift Chamber hit
 };
 
@@ -7,6 +7,7 @@
 //                                                                           //
 ///////////////////////////////////////////////////////////////////////////////
 #include "TObject.h"
+#include <vector>
 
 class THcRawHit : public TObject {
 
@@ -31,6 +32,7 @@ public:
 
   virtual void SetData(Int_t signal, Int_t data) {};
   virtual void SetSample(Int_t signal, Int_t data) {};
+  virtual void SetSampleArena(Int_t signal, std::vector<Int_t>* arena) {};
   virtual void SetDataTimePedestalPeak(Int_t signal, Int_t data,
 				       Int_t time, Int_t pedestal, Int_t peak) {};
   virtual Int_t GetData(Int_t signal) {return 0;}; /* Ref time subtracted */
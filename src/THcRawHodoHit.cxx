@@ -79,6 +79,18 @@ void THcRawHodoHit::SetSample(Int_t signal, Int_t data) {
 }
 
 
+void THcRawHodoHit::SetSampleArena(Int_t signal, std::vector<Int_t>* arena) {
+  if (0 <= signal && signal < fNAdcSignals) {
+    fAdcHits[signal].SetSampleArena(arena);
+  }
+  else {
+    throw std::out_of_range(
+      "`THcRawHodoHit::SetSampleArena`: only signals `0` and `1` available!"
+    );
+  }
+}
+
+
 void THcRawHodoHit::SetDataTimePedestalPeak(
   Int_t signal, Int_t data, Int_t time, Int_t pedestal, Int_t peak
 ) {
@@ -184,21 +196,41 @@ THcRawAdcHit& THcRawHodoHit::GetRawAdcHitPos() {
 }
 
 
+const THcRawAdcHit& THcRawHodoHit::GetRawAdcHitPos() const {
+  return fAdcHits[0];
+}
+
+
 THcRawAdcHit& THcRawHodoHit::GetRawAdcHitNeg() {
   return fAdcHits[1];
 }
 
 
+const THcRawAdcHit& THcRawHodoHit::GetRawAdcHitNeg() const {
+  return fAdcHits[1];
+}
+
+
 THcRawTdcHit& THcRawHodoHit::GetRawTdcHitPos() {
   return fTdcHits[0];
 }
 
 
+const THcRawTdcHit& THcRawHodoHit::GetRawTdcHitPos() const {
+  return fTdcHits[0];
+}
+
+
 THcRawTdcHit& THcRawHodoHit::GetRawTdcHitNeg() {
   return fTdcHits[1];
 }
 
 
+const THcRawTdcHit& THcRawHodoHit::GetRawTdcHitNeg() const {
+  return fTdcHits[1];
+}
+
+
 void THcRawHodoHit::SetF250Params(Int_t NSA, Int_t NSB, Int_t NPED) {
   for (Int_t iAdcSig=0; iAdcSig<fNAdcSignals; ++iAdcSig) {
     fAdcHits[iAdcSig].SetF250Params(NSA, NSB, NPED);
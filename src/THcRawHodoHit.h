@@ -21,6 +21,7 @@ class THcRawHodoHit : public THcRawHit {
 
     virtual void SetData(Int_t signal, Int_t data);
     virtual void SetSample(Int_t signal, Int_t data);
+    virtual void SetSampleArena(Int_t signal, std::vector<Int_t>* arena);
     virtual void SetDataTimePedestalPeak(
       Int_t signal, Int_t data, Int_t time, Int_t pedestal, Int_t peak
     );
@@ -35,9 +36,13 @@ class THcRawHodoHit : public THcRawHit {
     virtual Bool_t HasReference(Int_t signal);
 
     THcRawAdcHit& GetRawAdcHitPos();
+    const THcRawAdcHit& GetRawAdcHitPos() const;
     THcRawAdcHit& GetRawAdcHitNeg();
+    const THcRawAdcHit& GetRawAdcHitNeg() const;
     THcRawTdcHit& GetRawTdcHitPos();
+    const THcRawTdcHit& GetRawTdcHitPos() const;
     THcRawTdcHit& GetRawTdcHitNeg();
+    const THcRawTdcHit& GetRawTdcHitNeg() const;
 
     void SetF250Params(Int_t NSA, Int_t NSB, Int_t NPED);
 
@@ -49,6 +54,9 @@ class THcRawHodoHit : public THcRawHit {
     THcRawTdcHit fTdcHits[fNTdcSignals];
 
   private:
+    // Not implemented; pass raw hits by reference.
+    THcRawHodoHit(const THcRawHodoHit&);
+
     ClassDef(THcRawHodoHit, 0);  // Raw Hodoscope hit
 };
 
@@ -68,6 +68,18 @@ void THcRawShowerHit::SetSample(Int_t signal, Int_t data) {
 }
 
 
+void THcRawShowerHit::SetSampleArena(Int_t signal, std::vector<Int_t>* arena) {
+  if (0 <= signal && signal < fNAdcSignals) {
+    fAdcHits[signal].SetSampleArena(arena);
+  }
+  else {
+    throw std::out_of_range(
+      "`THcRawShowerHit::SetSampleArena`: only signals `0` and `1` available!"
+    );
+  }
+}
+
+
 void THcRawShowerHit::SetDataTimePedestalPeak(
   Int_t signal, Int_t data, Int_t time, Int_t pedestal, Int_t peak
 ) {
@@ -139,11 +151,21 @@ THcRawAdcHit& THcRawShowerHit::GetRawAdcHitPos() {
 }
 
 
+const THcRawAdcHit& THcRawShowerHit::GetRawAdcHitPos() const {
+  return fAdcHits[0];
+}
+
+
 THcRawAdcHit& THcRawShowerHit::GetRawAdcHitNeg() {
   return fAdcHits[1];
 }
 
 
+const THcRawAdcHit& THcRawShowerHit::GetRawAdcHitNeg() const {
+  return fAdcHits[1];
+}
+
+
 void THcRawShowerHit::SetF250Params(Int_t NSA, Int_t NSB, Int_t NPED) {
   for (Int_t iAdcSig=0; iAdcSig<fNAdcSignals; ++iAdcSig) {
     fAdcHits[iAdcSig].SetF250Params(NSA, NSB, NPED);
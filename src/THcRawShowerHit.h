@@ -18,6 +18,7 @@ class THcRawShowerHit : public THcRawHit {
 
     virtual void SetData(Int_t signal, Int_t data);
     virtual void SetSample(Int_t signal, Int_t data);
+    virtual void SetSampleArena(Int_t signal, std::vector<Int_t>* arena);
     virtual void SetDataTimePedestalPeak(
       Int_t signal, Int_t data, Int_t time, Int_t pedestal, Int_t peak
     );
@@ -29,7 +30,9 @@ class THcRawShowerHit : public THcRawHit {
     virtual Int_t GetNSignals();
 
     THcRawAdcHit& GetRawAdcHitPos();
+    const THcRawAdcHit& GetRawAdcHitPos() const;
     THcRawAdcHit& GetRawAdcHitNeg();
+    const THcRawAdcHit& GetRawAdcHitNeg() const;
 
     void SetF250Params(Int_t NSA, Int_t NSB, Int_t NPED);
 
@@ -39,6 +42,9 @@ class THcRawShowerHit : public THcRawHit {
     THcRawAdcHit fAdcHits[fNAdcSignals];
 
   private:
+    // Not implemented; pass raw hits by reference.
+    THcRawShowerHit(const THcRawShowerHit&);
+
     ClassDef(THcRawShowerHit, 0);  // Raw Shower counter hit
 };
 
@@ -35,6 +35,10 @@ class THcRawTdcHit : public TObject {
     UInt_t fNHits;
 
   private:
+    // Not implemented, so a by-value copy of a hit fails to compile.
+    // Use references, or operator= where a copy is really needed.
+    THcRawTdcHit(const THcRawTdcHit&);
+
     ClassDef(THcRawTdcHit, 0)
 };
 
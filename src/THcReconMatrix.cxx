@@ -0,0 +1,194 @@
+/** \class THcReconMatrix
+    \ingroup DetSupport
+
+    \brief COSY reconstruction matrix compiled for fast evaluation
+
+    Holds the focal plane to target matrix elements read from the
+    reconstruction coefficient file.  Each term is
+    Coeff[k] * x0^e0 * x1^e1 * x2^e2 * x3^e3 * x4^e4 for the four outputs
+    (xptar, ytar, yptar, delta).
+
+    Compile() turns the exponent list into indices into a small power
+    table.  Eval() fills that table once per track (one pow() per distinct
+    power rather than one per term and variable) and then accumulates all
+    four outputs in a single pass over the terms.  The terms are summed in
+    file order with the same factor order as the old term-by-term loop, so
+    results are unchanged.
+
+    EvalArray() evaluates a whole array of focal plane vectors, for use
+    from THcExtTarCor or from optics fitting macros.
+*/
+
+#include "THcReconMatrix.h"
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+using namespace std;
+
+ClassImp(THcReconMatrix)
+
+//_____________________________________________________________________________
+THcReconMatrix::THcReconMatrix() : fNPow(0), fCompiled(kFALSE)
+{
+  for(Int_t j=0;j<kNVar;j++) {
+    fMaxExp[j] = 0;
+    fPowOffset[j] = 0;
+  }
+}
+
+//_____________________________________________________________________________
+THcReconMatrix::~THcReconMatrix()
+{
+}
+
+//_____________________________________________________________________________
+void THcReconMatrix::Clear( Option_t* )
+{
+  fCoeff.clear();
+  fExp.clear();
+  fPowIndex.clear();
+  for(Int_t j=0;j<kNVar;j++) {
+    fMaxExp[j] = 0;
+    fPowOffset[j] = 0;
+  }
+  fNPow = 0;
+  fCompiled = kFALSE;
+}
+
+//_____________________________________________________________________________
+void THcReconMatrix::AddTerm( const Double_t coeff[kNOut], const Int_t exp[kNVar] )
+{
+  /// Append a term.  Compile() must be called before the next Eval().
+  for(Int_t k=0;k<kNOut;k++) {
+    fCoeff.push_back(coeff[k]);
+  }
+  for(Int_t j=0;j<kNVar;j++) {
+    fExp.push_back(exp[j]);
+  }
+  fCompiled = kFALSE;
+}
+
+//_____________________________________________________________________________
+Int_t THcReconMatrix::ReadTerm( const char* line )
+{
+  /**
+     Parse one line of a COSY coefficient file
+     ("c0 c1 c2 c3 e0e1e2e3e4") and append it.  Fields that cannot be
+     parsed are left at zero.  Returns the number of fields converted.
+  */
+  Double_t coeff[kNOut] = {0.0, 0.0, 0.0, 0.0};
+  Int_t exp[kNVar] = {0, 0, 0, 0, 0};
+  Int_t nread = sscanf(line," %le %le %le %le %1d%1d%1d%1d%1d"
+		       ,&coeff[0],&coeff[1],&coeff[2],&coeff[3]
+		       ,&exp[0],&exp[1],&exp[2],&exp[3],&exp[4]);
+  AddTerm(coeff,exp);
+  return nread;
+}
+
+//_____________________________________________________________________________
+void THcReconMatrix::Compile()
+{
+  /// Lay out the power table and convert exponents into table indices.
+  Int_t nterms = GetNTerms();
+  for(Int_t j=0;j<kNVar;j++) {
+    fMaxExp[j] = 0;
+  }
+  for(Int_t iterm=0;iterm<nterms;iterm++) {
+    for(Int_t j=0;j<kNVar;j++) {
+      Int_t e = fExp[iterm*kNVar+j];
+      if(e < 0 || e > kMaxExp) {
+	cout << "THcReconMatrix: exponent " << e << " out of range in term "
+	     << iterm << ", treating as 0" << endl;
+	fExp[iterm*kNVar+j] = e = 0;
+      }
+      if(e > fMaxExp[j]) fMaxExp[j] = e;
+    }
+  }
+  fNPow = 0;
+  for(Int_t j=0;j<kNVar;j++) {
+    fPowOffset[j] = fNPow;
+    fNPow += fMaxExp[j]+1;
+  }
+  fPowIndex.resize(fExp.size());
+  for(Int_t iterm=0;iterm<nterms;iterm++) {
+    for(Int_t j=0;j<kNVar;j++) {
+      fPowIndex[iterm*kNVar+j] = fPowOffset[j] + fExp[iterm*kNVar+j];
+    }
+  }
+  fCompiled = kTRUE;
+}
+
+//_____________________________________________________________________________
+void THcReconMatrix::FillPowers( const Double_t x[kNVar], Double_t* pw ) const
+{
+  // Entry 0 of each variable is 1 so zero exponents drop out of the
+  // product exactly; the rest use pow() to match the term-by-term sum.
+  for(Int_t j=0;j<kNVar;j++) {
+    Double_t* p = pw + fPowOffset[j];
+    p[0] = 1.0;
+    for(Int_t e=1;e<=fMaxExp[j];e++) {
+      p[e] = pow(x[j],e);
+    }
+  }
+}
+
+//_____________________________________________________________________________
+void THcReconMatrix::Eval( const Double_t x[kNVar], Double_t sum[kNOut] ) const
+{
+  /// Evaluate all four COSY sums for one focal plane vector x.
+  for(Int_t k=0;k<kNOut;k++) {
+    sum[k] = 0.0;
+  }
+  if(!fCompiled) {
+    cout << "THcReconMatrix::Eval: matrix not compiled" << endl;
+    return;
+  }
+
+  Double_t pw[kNVar*(kMaxExp+1)];
+  FillPowers(x, pw);
+
+  Int_t nterms = GetNTerms();
+  const Int_t* idx = nterms > 0 ? &fPowIndex[0] : 0;
+  const Double_t* c = nterms > 0 ? &fCoeff[0] : 0;
+  Double_t s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+  for(Int_t iterm=0;iterm<nterms;iterm++) {
+    Double_t term = pw[idx[0]]*pw[idx[1]]*pw[idx[2]]*pw[idx[3]]*pw[idx[4]];
+    s0 += term*c[0];
+    s1 += term*c[1];
+    s2 += term*c[2];
+    s3 += term*c[3];
+    idx += kNVar;
+    c += kNOut;
+  }
+  sum[0] = s0;
+  sum[1] = s1;
+  sum[2] = s2;
+  sum[3] = s3;
+}
+
+//_____________________________________________________________________________
+void THcReconMatrix::EvalArray( Int_t n, const Double_t* x, Double_t* sum ) const
+{
+  /**
+     Evaluate n focal plane vectors.  x is laid out as [n][kNVar] and
+     sum receives [n][kNOut].
+  */
+  for(Int_t i=0;i<n;i++) {
+    Eval(x + i*kNVar, sum + i*kNOut);
+  }
+}
+
+//_____________________________________________________________________________
+void THcReconMatrix::Print( Option_t* ) const
+{
+  Int_t nterms = GetNTerms();
+  cout << "THcReconMatrix: " << nterms << " terms, power table size "
+       << fNPow << (fCompiled ? "" : " (not compiled)") << endl;
+  cout << "  max exponents:";
+  for(Int_t j=0;j<kNVar;j++) {
+    cout << " " << fMaxExp[j];
+  }
+  cout << endl;
+}
@@ -0,0 +1,52 @@
+#ifndef ROOT_THcReconMatrix
+#define ROOT_THcReconMatrix
+
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// THcReconMatrix                                                            //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TObject.h"
+#include <vector>
+
+class THcReconMatrix : public TObject {
+
+public:
+
+  enum { kNVar = 5, kNOut = 4, kMaxExp = 9 };
+
+  THcReconMatrix();
+  virtual ~THcReconMatrix();
+
+  virtual void Clear( Option_t* opt="" );
+  virtual void Print( Option_t* opt="" ) const;
+
+  void  AddTerm( const Double_t coeff[kNOut], const Int_t exp[kNVar] );
+  Int_t ReadTerm( const char* line );
+  void  Compile();
+
+  void  Eval( const Double_t x[kNVar], Double_t sum[kNOut] ) const;
+  void  EvalArray( Int_t n, const Double_t* x, Double_t* sum ) const;
+
+  Int_t    GetNTerms() const { return fExp.size()/kNVar; }
+  Bool_t   IsCompiled() const { return fCompiled; }
+  Double_t GetCoeff( Int_t iterm, Int_t k ) const { return fCoeff[iterm*kNOut+k]; }
+  Int_t    GetExp( Int_t iterm, Int_t j ) const { return fExp[iterm*kNVar+j]; }
+
+protected:
+
+  std::vector<Double_t> fCoeff;    // [nterms][kNOut] coefficients
+  std::vector<Int_t>    fExp;      // [nterms][kNVar] exponents as read
+  std::vector<Int_t>    fPowIndex; // [nterms][kNVar] index into power table
+  Int_t    fMaxExp[kNVar];         // Highest exponent used per variable
+  Int_t    fPowOffset[kNVar];      // Start of each variable's powers
+  Int_t    fNPow;                  // Size of the power table
+  Bool_t   fCompiled;
+
+  void FillPowers( const Double_t x[kNVar], Double_t* pw ) const;
+
+  ClassDef(THcReconMatrix,0)
+};
+
+#endif
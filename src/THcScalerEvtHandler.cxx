@@ -44,6 +44,7 @@ To enable debugging you may try this in the setup script
 #include "Scaler9250.h"
 #include "THaCodaData.h"
 #include "THaEvData.h"
+#include "THcEvioBankIndex.h"
 #include "THcParmList.h"
 #include "THcGlobals.h"
 #include "THaGlobals.h"
@@ -264,85 +265,70 @@ Int_t THcScalerEvtHandler::AnalyzeBuffer(UInt_t* rdata, Bool_t onlysync)
 {
 
   // Parse the data, load local data arrays.
-  UInt_t *p = (UInt_t*) rdata;
-
-  UInt_t *plast = p+*p;		// Index to last word in the bank
+  fBankIndex.Build(rdata);
 
   ifound=0;
-  while(p<plast) {
-    p++;			  // point to header
+  for(Int_t ib=0; ib<fBankIndex.GetNBanks(); ib++) {
+    const THcEvioBankIndex::Bank& bank = fBankIndex.GetBank(ib);
     if (fDebugFile) {
-      *fDebugFile << "Bank: " << hex << *p << dec << " len: " << *(p-1) << endl;
+      *fDebugFile << "Bank: " << hex << bank.header << dec << " len: " << bank.length << endl;
     }
-    if((*p & 0xff00) == 0x1000) {	// Bank Containing banks
-      p++;				// Now pointing to a bank in the bank
-    } else if (((*p & 0xff00) == 0x100) && (*p != 0xC0000100)) {
-      // Bank containing integers.  Look for scalers
-      // This is either ROC bank containing integers or
-      // a bank within a ROC containing data from modules of a single type
-      // Look for scaler data
-      // Assume that very first word is a scaler header
-      // At any point in the bank where the word is not a matching
-      // header, we stop.
-      UInt_t tag = (*p>>16) & 0xffff;
-      UInt_t num = (*p) & 0xff;
-      UInt_t *pnext = p+*(p-1);	// Next bank
-      p++;			// First data word
-
-      // Skip over banks that can't contain scalers
-      // If SetOnlyBanks(kTRUE) called, fRocSet will be empty
-      // so only bank tags matching module types will be considered.
-      if(fModuleSet.find(tag)!=fModuleSet.end()) {
-	if(onlysync && num==0) {
-	  ifound = 0;
-	  return 0;
-	}
-      } else if (fRocSet.find(tag)==fRocSet.end()) {
-	p = pnext;		// Fall through to end of the above else if
+    if(bank.kind != THcEvioBankIndex::kUInt32) continue;
+    // Bank containing integers.  Look for scalers
+    // This is either ROC bank containing integers or
+    // a bank within a ROC containing data from modules of a single type
+    // Look for scaler data
+    // Assume that very first word is a scaler header
+    // At any point in the bank where the word is not a matching
+    // header, we stop.
+    UInt_t *p = fBankIndex.GetData(ib);	// First data word
+    UInt_t *pnext = fBankIndex.GetEnd(ib);	// Next bank
+
+    // Skip over banks that can't contain scalers
+    // If SetOnlyBanks(kTRUE) called, fRocSet will be empty
+    // so only bank tags matching module types will be considered.
+    if(fModuleSet.find(bank.tag)!=fModuleSet.end()) {
+      if(onlysync && bank.num==0) {
+	ifound = 0;
+	return 0;
       }
+    } else if (fRocSet.find(bank.tag)==fRocSet.end()) {
+      continue;
+    }
 
-      // Look for normalization scaler module first.
-      if(fNormIdx >= 0) {
-	UInt_t *psave = p;
-	while(p < pnext) {
-	  if(scalers[fNormIdx]->IsSlot(*p)) {
-	    scalers[fNormIdx]->Decode(p);
-	    ifound = 1;
-	    break;
-	  }
-	  p += scalers[fNormIdx]->GetNumChan() + 1;
+    // Look for normalization scaler module first.
+    if(fNormIdx >= 0) {
+      UInt_t *psave = p;
+      while(p < pnext) {
+	if(scalers[fNormIdx]->IsSlot(*p)) {
+	  scalers[fNormIdx]->Decode(p);
+	  ifound = 1;
+	  break;
 	}
-	p = psave;
+	p += scalers[fNormIdx]->GetNumChan() + 1;
       }
-      while(p < pnext) {
-	Int_t nskip = 0;
+      p = psave;
+    }
+    while(p < pnext) {
+      if(fDebugFile) {
+	*fDebugFile << "Scaler Header: " << hex << *p << dec;
+      }
+      Int_t j = FindScaler(*p);
+      if(j < 0) {
 	if(fDebugFile) {
-	  *fDebugFile << "Scaler Header: " << hex << *p << dec;
+	  *fDebugFile << endl;
 	}
-	for(size_t j=0; j<scalers.size(); j++) {
-	  if(scalers[j]->IsSlot(*p)) {
-	    nskip = scalers[j]->GetNumChan() + 1;
-	    if((Int_t) j != fNormIdx) {
-	      if(fDebugFile) {
-		*fDebugFile << " found (" << j << ")  skip " << nskip << endl;
-	      }
-	      scalers[j]->Decode(p);
-	      ifound = 1;
-	    }
-	    break;
-	  }
-	}
-	if(nskip == 0) {
-	  if(fDebugFile) {
-	    *fDebugFile << endl;
-	  }
-	  break;	// Didn't find a matching header
+	break;	// Didn't find a matching header
+      }
+      Int_t nskip = scalers[j]->GetNumChan() + 1;
+      if(j != fNormIdx) {
+	if(fDebugFile) {
+	  *fDebugFile << " found (" << j << ")  skip " << nskip << endl;
 	}
-	p = p + nskip;
+	scalers[j]->Decode(p);
+	ifound = 1;
       }
-      p = pnext;
-    } else {
-      p = p+*(p-1);		// Skip to next bank
+      p = p + nskip;
     }
   }
 
@@ -596,6 +582,54 @@ Int_t THcScalerEvtHandler::AnalyzeBuffer(UInt_t* rdata, Bool_t onlysync)
 }
 
 
+void THcScalerEvtHandler::BuildScalerLookup()
+{
+  // Map each scaler header pattern to the first scaler that has it, one
+  // map per distinct header mask, so that a header word is matched to
+  // its module without testing every module.
+  fHeaderMasks.clear();
+  fHeaderLookup.clear();
+  if(fScalerHeader.size() != scalers.size()) return; // Headers not known
+  for(size_t j=0; j<scalers.size(); j++) {
+    UInt_t mask = fScalerMask[j];
+    UInt_t header = fScalerHeader[j];
+    if((header & mask) != header) continue;	// Can never match
+    size_t im;
+    for(im=0; im<fHeaderMasks.size(); im++) {
+      if(fHeaderMasks[im] == mask) break;
+    }
+    if(im == fHeaderMasks.size()) {
+      fHeaderMasks.push_back(mask);
+      fHeaderLookup.push_back(std::map<UInt_t, Int_t>());
+    }
+    fHeaderLookup[im].insert(std::make_pair(header, (Int_t) j));
+  }
+}
+
+Int_t THcScalerEvtHandler::FindScaler(UInt_t word) const
+{
+  // Index of the first scaler whose header matches word, or -1.
+  // Same result as testing scalers[j]->IsSlot(word) in order.
+  size_t jstart = 0;
+  if(fScalerHeader.size() == scalers.size()) {
+    Int_t jfirst = -1;
+    for(size_t im=0; im<fHeaderMasks.size(); im++) {
+      std::map<UInt_t, Int_t>::const_iterator it =
+	fHeaderLookup[im].find(word & fHeaderMasks[im]);
+      if(it != fHeaderLookup[im].end() && (jfirst < 0 || it->second < jfirst)) {
+	jfirst = it->second;
+      }
+    }
+    if(jfirst < 0) return -1;
+    if(scalers[jfirst]->IsSlot(word)) return jfirst;
+    jstart = jfirst+1;		// Module rejected it; keep looking
+  }
+  for(size_t j=jstart; j<scalers.size(); j++) {
+    if(scalers[j]->IsSlot(word)) return j;
+  }
+  return -1;
+}
+
 THaAnalysisObject::EStatus THcScalerEvtHandler::Init(const TDatime& date)
 {
   //
@@ -724,6 +758,10 @@ THaAnalysisObject::EStatus THcScalerEvtHandler::Init(const TDatime& date)
 	  // Headers must be unique over whole event, not
 	  // just within a ROC
 	  scalers[idx]->SetHeader(header, mask);
+	  fScalerHeader.resize(scalers.size());
+	  fScalerMask.resize(scalers.size());
+	  fScalerHeader[idx] = header;
+	  fScalerMask[idx] = mask;
 // The normalization slot has the clock in it, so we automatically recognize it.
 // fNormIdx is the index in scaler[] and 
 // fNormSlot is the slot#, checked for consistency
@@ -800,6 +838,8 @@ THaAnalysisObject::EStatus THcScalerEvtHandler::Init(const TDatime& date)
   }
 #endif
 
+  BuildScalerLookup();
+
   // Verify that the slots are not defined twice
   for (UInt_t i1=0; i1 < scalers.size()-1; i1++) {
     for (UInt_t i2=i1+1; i2 < scalers.size(); i2++) {
@@ -12,9 +12,11 @@
 
 #include "THaEvtTypeHandler.h"
 #include "Decoder.h"
+#include "THcEvioBankIndex.h"
 #include <string>
 #include <vector>
 #include <set>
+#include <map>
 #include "TTree.h"
 #include "TString.h"
 #include <cstring>
@@ -53,6 +55,8 @@ private:
    void AddVars(TString name, TString desc, UInt_t iscal, UInt_t ichan, UInt_t ikind);
    void DefVars();
    static size_t FindNoCase(const std::string& sdata, const std::string& skey);
+   void BuildScalerLookup();
+   Int_t FindScaler(UInt_t word) const;
 
    std::vector<Decoder::GenScaler*> scalers;
    std::vector<HCScalerLoc*> scalerloc;
@@ -89,6 +93,11 @@ private:
    std::vector<UInt_t*> fDelayedEvents;
    std::set<UInt_t> fRocSet;
    std::set<UInt_t> fModuleSet;
+   std::vector<UInt_t> fScalerHeader;	// Header/mask of each scaler
+   std::vector<UInt_t> fScalerMask;
+   std::vector<UInt_t> fHeaderMasks;	// Distinct header masks
+   std::vector<std::map<UInt_t, Int_t> > fHeaderLookup; // Header -> scaler, per mask
+   THcEvioBankIndex fBankIndex;
 
    THcScalerEvtHandler(const THcScalerEvtHandler& fh);
    THcScalerEvtHandler& operator=(const THcScalerEvtHandler& fh);
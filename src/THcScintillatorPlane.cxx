@@ -11,6 +11,7 @@ The THcHodoscope class instatiates one of these objects per plane.
 #include "THcScintPlaneCluster.h"
 #include "TClonesArray.h"
 #include "THcSignalHit.h"
+#include "THcSignalTable.h"
 #include "THcHodoHit.h"
 #include "THcGlobals.h"
 #include "THcParmList.h"
@@ -35,17 +36,11 @@ THcScintillatorPlane::THcScintillatorPlane( const char* name,
 					    const Int_t planenum,
 					    THaDetectorBase* parent )
 : THaSubDetector(name,description,parent),
-  fParentHitList(0), fCluster(0),frPosAdcErrorFlag(0), frNegAdcErrorFlag(0),
+  fParentHitList(0), fCluster(0),
   frPosTDCHits(0), frNegTDCHits(0), frPosADCHits(0), frNegADCHits(0),
   frPosADCSums(0), frNegADCSums(0), frPosADCPeds(0), frNegADCPeds(0),
-  fHodoHits(0), frPosTdcTimeRaw(0), frPosAdcPedRaw(0),
-  frPosAdcPulseIntRaw(0), frPosAdcPulseAmpRaw(0),
-  frPosAdcPulseTimeRaw(0), frPosTdcTime(0), frPosAdcPed(0),
-  frPosAdcPulseInt(0), frPosAdcPulseAmp(0), frPosAdcPulseTime(0),
-  frNegTdcTimeRaw(0), frNegAdcPedRaw(0), frNegAdcPulseIntRaw(0),
-  frNegAdcPulseAmpRaw(0), frNegAdcPulseTimeRaw(0), frNegTdcTime(0),
-  frNegAdcPed(0), frNegAdcPulseInt(0), frNegAdcPulseAmp(0),
-  frNegAdcPulseTime(0), fPosCenter(0), fHodoPosMinPh(0),
+  fHodoHits(0), frPosTdc(0), frPosAdc(0), frNegTdc(0), frNegAdc(0),
+  fPosCenter(0), fHodoPosMinPh(0),
   fHodoNegMinPh(0), fHodoPosPhcCoeff(0), fHodoNegPhcCoeff(0),
   fHodoPosTimeOffset(0), fHodoNegTimeOffset(0), fHodoVelLight(0),
   fHodoPosInvAdcOffset(0), fHodoNegInvAdcOffset(0),
@@ -64,9 +59,6 @@ THcScintillatorPlane::THcScintillatorPlane( const char* name,
 
   fCluster = new TClonesArray("THcScintPlaneCluster", 10);
 
-  frPosAdcErrorFlag = new TClonesArray("THcSignalHit", 16);
-  frNegAdcErrorFlag = new TClonesArray("THcSignalHit", 16);
-
   frPosTDCHits = new TClonesArray("THcSignalHit",16);
   frNegTDCHits = new TClonesArray("THcSignalHit",16);
   frPosADCHits = new TClonesArray("THcSignalHit",16);
@@ -76,29 +68,10 @@ THcScintillatorPlane::THcScintillatorPlane( const char* name,
   frPosADCPeds = new TClonesArray("THcSignalHit",16);
   frNegADCPeds = new TClonesArray("THcSignalHit",16);
 
-  frPosTdcTimeRaw      = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPedRaw       = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseIntRaw  = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseAmpRaw  = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseTimeRaw = new TClonesArray("THcSignalHit", 16);
-
-  frPosTdcTime      = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPed       = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseInt  = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseAmp  = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseTime = new TClonesArray("THcSignalHit", 16);
-
-  frNegTdcTimeRaw      = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPedRaw       = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseIntRaw  = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseAmpRaw  = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseTimeRaw = new TClonesArray("THcSignalHit", 16);
-
-  frNegTdcTime      = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPed       = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseInt  = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseAmp  = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseTime = new TClonesArray("THcSignalHit", 16);
+  frPosTdc = new THcSignalTable(THcSignalTable::kTdcSignals, 16);
+  frPosAdc = new THcSignalTable(THcSignalTable::kAdcSignals, 16);
+  frNegTdc = new THcSignalTable(THcSignalTable::kTdcSignals, 16);
+  frNegAdc = new THcSignalTable(THcSignalTable::kAdcSignals, 16);
 
 
   fPlaneNum = planenum;
@@ -112,9 +85,6 @@ THcScintillatorPlane::~THcScintillatorPlane()
   // Destructor
   if( fIsSetup )
     RemoveVariables();
-  delete  frPosAdcErrorFlag; frPosAdcErrorFlag = NULL;
-  delete  frNegAdcErrorFlag; frNegAdcErrorFlag = NULL;
-
   delete  fCluster; fCluster = NULL;
 
   delete fHodoHits;
@@ -127,29 +97,10 @@ THcScintillatorPlane::~THcScintillatorPlane()
   delete frPosADCPeds;
   delete frNegADCPeds;
 
-  delete frPosTdcTimeRaw;
-  delete frPosAdcPedRaw;
-  delete frPosAdcPulseIntRaw;
-  delete frPosAdcPulseAmpRaw;
-  delete frPosAdcPulseTimeRaw;
-
-  delete frPosTdcTime;
-  delete frPosAdcPed;
-  delete frPosAdcPulseInt;
-  delete frPosAdcPulseAmp;
-  delete frPosAdcPulseTime;
-
-  delete frNegTdcTimeRaw;
-  delete frNegAdcPedRaw;
-  delete frNegAdcPulseIntRaw;
-  delete frNegAdcPulseAmpRaw;
-  delete frNegAdcPulseTimeRaw;
-
-  delete frNegTdcTime;
-  delete frNegAdcPed;
-  delete frNegAdcPulseInt;
-  delete frNegAdcPulseAmp;
-  delete frNegAdcPulseTime;
+  delete frPosTdc;
+  delete frPosAdc;
+  delete frNegTdc;
+  delete frNegAdc;
 
   delete [] fPosCenter; fPosCenter = 0;
 
@@ -437,34 +388,50 @@ Int_t THcScintillatorPlane::DefineVariables( EMode mode )
   // Register variables in global list
 
   if (fDebugAdc) {
-    RVarDef vars[] = {
-      {"posAdcErrorFlag", "Error Flag for When FPGA Fails", "frPosAdcErrorFlag.THcSignalHit.GetData()"},
-      {"negAdcErrorFlag", "Error Flag for When FPGA Fails", "frNegAdcErrorFlag.THcSignalHit.GetData()"},
-
-      {"posTdcTimeRaw",      "List of positive raw TDC values.",           "frPosTdcTimeRaw.THcSignalHit.GetData()"},
-      {"posAdcPedRaw",       "List of positive raw ADC pedestals",         "frPosAdcPedRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseIntRaw",  "List of positive raw ADC pulse integrals.",  "frPosAdcPulseIntRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseAmpRaw",  "List of positive raw ADC pulse amplitudes.", "frPosAdcPulseAmpRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseTimeRaw", "List of positive raw ADC pulse times.",      "frPosAdcPulseTimeRaw.THcSignalHit.GetData()"},
-
-      {"posTdcTime",         "List of positive TDC values.",               "frPosTdcTime.THcSignalHit.GetData()"},
-      {"posAdcPed",          "List of positive ADC pedestals",             "frPosAdcPed.THcSignalHit.GetData()"},
-      {"posAdcPulseInt",     "List of positive ADC pulse integrals.",      "frPosAdcPulseInt.THcSignalHit.GetData()"},
-      {"posAdcPulseAmp",     "List of positive ADC pulse amplitudes.",     "frPosAdcPulseAmp.THcSignalHit.GetData()"},
-      {"posAdcPulseTime",    "List of positive ADC pulse times.",          "frPosAdcPulseTime.THcSignalHit.GetData()"},
-
-      {"negTdcTimeRaw",      "List of negative raw TDC values.",           "frNegTdcTimeRaw.THcSignalHit.GetData()"},
-      {"negAdcPedRaw",       "List of negative raw ADC pedestals",         "frNegAdcPedRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseIntRaw",  "List of negative raw ADC pulse integrals.",  "frNegAdcPulseIntRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseAmpRaw",  "List of negative raw ADC pulse amplitudes.", "frNegAdcPulseAmpRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseTimeRaw", "List of negative raw ADC pulse times.",      "frNegAdcPulseTimeRaw.THcSignalHit.GetData()"},
-
-      {"negTdcTime",         "List of negative TDC values.",               "frNegTdcTime.THcSignalHit.GetData()"},
-      {"negAdcPed",          "List of negative ADC pedestals",             "frNegAdcPed.THcSignalHit.GetData()"},
-      {"negAdcPulseInt",     "List of negative ADC pulse integrals.",      "frNegAdcPulseInt.THcSignalHit.GetData()"},
-      {"negAdcPulseAmp",     "List of negative ADC pulse amplitudes.",     "frNegAdcPulseAmp.THcSignalHit.GetData()"},
-      {"negAdcPulseTime",    "List of negative ADC pulse times.",          "frNegAdcPulseTime.THcSignalHit.GetData()"},
+    THcSignalTable::SignalVar_t postdcvars[] = {
+      {"posTdcTimeRaw",      "List of positive raw TDC values.",           THcSignalTable::kTimeRaw},
+      {"posTdcTime",         "List of positive TDC values.",               THcSignalTable::kTime},
+      { 0 }
+    };
+    frPosTdc->DefineVariables(mode, GetPrefix(), postdcvars);
+    THcSignalTable::SignalVar_t posadcvars[] = {
+      {"posAdcErrorFlag", "Error Flag for When FPGA Fails", THcSignalTable::kErrorFlag},
+
+      {"posAdcPedRaw",       "List of positive raw ADC pedestals",         THcSignalTable::kPedRaw},
+      {"posAdcPulseIntRaw",  "List of positive raw ADC pulse integrals.",  THcSignalTable::kPulseIntRaw},
+      {"posAdcPulseAmpRaw",  "List of positive raw ADC pulse amplitudes.", THcSignalTable::kPulseAmpRaw},
+      {"posAdcPulseTimeRaw", "List of positive raw ADC pulse times.",      THcSignalTable::kPulseTimeRaw},
+
+      {"posAdcPed",          "List of positive ADC pedestals",             THcSignalTable::kPed},
+      {"posAdcPulseInt",     "List of positive ADC pulse integrals.",      THcSignalTable::kPulseInt},
+      {"posAdcPulseAmp",     "List of positive ADC pulse amplitudes.",     THcSignalTable::kPulseAmp},
+      {"posAdcPulseTime",    "List of positive ADC pulse times.",          THcSignalTable::kPulseTime},
+      { 0 }
+    };
+    frPosAdc->DefineVariables(mode, GetPrefix(), posadcvars);
+    THcSignalTable::SignalVar_t negtdcvars[] = {
+      {"negTdcTimeRaw",      "List of negative raw TDC values.",           THcSignalTable::kTimeRaw},
+      {"negTdcTime",         "List of negative TDC values.",               THcSignalTable::kTime},
+      { 0 }
+    };
+    frNegTdc->DefineVariables(mode, GetPrefix(), negtdcvars);
+    THcSignalTable::SignalVar_t negadcvars[] = {
+      {"negAdcErrorFlag", "Error Flag for When FPGA Fails", THcSignalTable::kErrorFlag},
+
+      {"negAdcPedRaw",       "List of negative raw ADC pedestals",         THcSignalTable::kPedRaw},
+      {"negAdcPulseIntRaw",  "List of negative raw ADC pulse integrals.",  THcSignalTable::kPulseIntRaw},
+      {"negAdcPulseAmpRaw",  "List of negative raw ADC pulse amplitudes.", THcSignalTable::kPulseAmpRaw},
+      {"negAdcPulseTimeRaw", "List of negative raw ADC pulse times.",      THcSignalTable::kPulseTimeRaw},
+
+      {"negAdcPed",          "List of negative ADC pedestals",             THcSignalTable::kPed},
+      {"negAdcPulseInt",     "List of negative ADC pulse integrals.",      THcSignalTable::kPulseInt},
+      {"negAdcPulseAmp",     "List of negative ADC pulse amplitudes.",     THcSignalTable::kPulseAmp},
+      {"negAdcPulseTime",    "List of negative ADC pulse times.",          THcSignalTable::kPulseTime},
+      { 0 }
+    };
+    frNegAdc->DefineVariables(mode, GetPrefix(), negadcvars);
 
+    RVarDef vars[] = {
       {"totNumPosAdcHits", "Total Number of Positive ADC Hits",   "fTotNumPosAdcHits"}, // Hodo+ raw ADC multiplicity Int_t
       {"totNumNegAdcHits", "Total Number of Negative ADC Hits",   "fTotNumNegAdcHits"}, // Hodo- raw ADC multiplicity  ""
       {"totNumAdcHits",   "Total Number of PMTs Hit (as measured by ADCs)",      "fTotNumAdcHits"},    // Hodo raw ADC multiplicity  ""
@@ -477,14 +444,30 @@ Int_t THcScintillatorPlane::DefineVariables( EMode mode )
     DefineVarsFromList( vars, mode);
   } //end debug statement
 
+  THcSignalTable::SignalVar_t postdcvars[] = {
+    {"posTdcCounter", "List of positive TDC counter numbers.", THcSignalTable::kPaddle},   //Hodo+ raw TDC occupancy
+    { 0 }
+  };
+  frPosTdc->DefineVariables(mode, GetPrefix(), postdcvars);
+  THcSignalTable::SignalVar_t posadcvars[] = {
+    {"posAdcCounter", "List of positive ADC counter numbers.", THcSignalTable::kPaddle}, //Hodo+ raw ADC occupancy
+    { 0 }
+  };
+  frPosAdc->DefineVariables(mode, GetPrefix(), posadcvars);
+  THcSignalTable::SignalVar_t negtdcvars[] = {
+    {"negTdcCounter", "List of negative TDC counter numbers.", THcSignalTable::kPaddle},     //Hodo- raw TDC occupancy
+    { 0 }
+  };
+  frNegTdc->DefineVariables(mode, GetPrefix(), negtdcvars);
+  THcSignalTable::SignalVar_t negadcvars[] = {
+    {"negAdcCounter", "List of negative ADC counter numbers.", THcSignalTable::kPaddle},  //Hodo- raw ADC occupancy
+    { 0 }
+  };
+  frNegAdc->DefineVariables(mode, GetPrefix(), negadcvars);
+
   RVarDef vars[] = {
     {"nhits", "Number of paddle hits (passed TDC && ADC Min and Max cuts for either end)",           "GetNScinHits() "},
 
-    {"posTdcCounter", "List of positive TDC counter numbers.", "frPosTdcTimeRaw.THcSignalHit.GetPaddleNumber()"},   //Hodo+ raw TDC occupancy
-    {"posAdcCounter", "List of positive ADC counter numbers.", "frPosAdcPulseIntRaw.THcSignalHit.GetPaddleNumber()"}, //Hodo+ raw ADC occupancy
-    {"negTdcCounter", "List of negative TDC counter numbers.", "frNegTdcTimeRaw.THcSignalHit.GetPaddleNumber()"},     //Hodo- raw TDC occupancy
-    {"negAdcCounter", "List of negative ADC counter numbers.", "frNegAdcPulseIntRaw.THcSignalHit.GetPaddleNumber()"},  //Hodo- raw ADC occupancy
-
     {"fptime", "Time at focal plane",     "GetFpTime()"},
 
     {"numGoodPosAdcHits",    "Number of Good Positive ADC Hits Per PMT", "fNumGoodPosAdcHits"},    // Hodo+ good ADC occupancy - vector<Int_t>
@@ -556,38 +539,16 @@ void THcScintillatorPlane::Clear( Option_t* )
   // Clears the hit lists
   fCluster->Clear();
 
-  frPosAdcErrorFlag->Clear();
-  frNegAdcErrorFlag->Clear();
-
   fHodoHits->Clear();
   frPosTDCHits->Clear();
   frNegTDCHits->Clear();
   frPosADCHits->Clear();
   frNegADCHits->Clear();
 
-  frPosTdcTimeRaw->Clear();
-  frPosAdcPedRaw->Clear();
-  frPosAdcPulseIntRaw->Clear();
-  frPosAdcPulseAmpRaw->Clear();
-  frPosAdcPulseTimeRaw->Clear();
-
-  frPosTdcTime->Clear();
-  frPosAdcPed->Clear();
-  frPosAdcPulseInt->Clear();
-  frPosAdcPulseAmp->Clear();
-  frPosAdcPulseTime->Clear();
-
-  frNegTdcTimeRaw->Clear();
-  frNegAdcPedRaw->Clear();
-  frNegAdcPulseIntRaw->Clear();
-  frNegAdcPulseAmpRaw->Clear();
-  frNegAdcPulseTimeRaw->Clear();
-
-  frNegTdcTime->Clear();
-  frNegAdcPed->Clear();
-  frNegAdcPulseInt->Clear();
-  frNegAdcPulseAmp->Clear();
-  frNegAdcPulseTime->Clear();
+  frPosTdc->Clear();
+  frPosAdc->Clear();
+  frNegTdc->Clear();
+  frNegAdc->Clear();
 
 
   //Clear occupancies
@@ -703,10 +664,6 @@ Int_t THcScintillatorPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
   Int_t nrNegTDCHits=0;
   Int_t nrPosADCHits=0;
   Int_t nrNegADCHits=0;
-  UInt_t nrPosAdcHits = 0;
-  UInt_t nrNegAdcHits = 0;
-  UInt_t nrPosTdcHits = 0;
-  UInt_t nrNegTdcHits = 0;
   frPosTDCHits->Clear();
   frNegTDCHits->Clear();
   frPosADCHits->Clear();
@@ -717,29 +674,10 @@ Int_t THcScintillatorPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
   frNegADCPeds->Clear();
 
 
-  frPosTdcTimeRaw->Clear();
-  frPosAdcPedRaw->Clear();
-  frPosAdcPulseIntRaw->Clear();
-  frPosAdcPulseAmpRaw->Clear();
-  frPosAdcPulseTimeRaw->Clear();
-
-  frPosTdcTime->Clear();
-  frPosAdcPed->Clear();
-  frPosAdcPulseInt->Clear();
-  frPosAdcPulseAmp->Clear();
-  frPosAdcPulseTime->Clear();
-
-  frNegTdcTimeRaw->Clear();
-  frNegAdcPedRaw->Clear();
-  frNegAdcPulseIntRaw->Clear();
-  frNegAdcPulseAmpRaw->Clear();
-  frNegAdcPulseTimeRaw->Clear();
-
-  frNegTdcTime->Clear();
-  frNegAdcPed->Clear();
-  frNegAdcPulseInt->Clear();
-  frNegAdcPulseAmp->Clear();
-  frNegAdcPulseTime->Clear();
+  frPosTdc->Clear();
+  frPosAdc->Clear();
+  frNegTdc->Clear();
+  frNegAdc->Clear();
   //stripped
   fNScinHits=0;
 
@@ -786,59 +724,29 @@ Int_t THcScintillatorPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
 
     THcRawTdcHit& rawPosTdcHit = hit->GetRawTdcHitPos();
     for (UInt_t thit=0; thit<rawPosTdcHit.GetNHits(); ++thit) {
-      ((THcSignalHit*) frPosTdcTimeRaw->ConstructedAt(nrPosTdcHits))->Set(padnum, rawPosTdcHit.GetTimeRaw(thit));
-      ((THcSignalHit*) frPosTdcTime->ConstructedAt(nrPosTdcHits))->Set(padnum, rawPosTdcHit.GetTime(thit));
-      ++nrPosTdcHits;
+      frPosTdc->AddTdcHit(padnum, rawPosTdcHit, thit);
       fTotNumTdcHits++;
       fTotNumPosTdcHits++;
     }
     THcRawTdcHit& rawNegTdcHit = hit->GetRawTdcHitNeg();
     for (UInt_t thit=0; thit<rawNegTdcHit.GetNHits(); ++thit) {
-      ((THcSignalHit*) frNegTdcTimeRaw->ConstructedAt(nrNegTdcHits))->Set(padnum, rawNegTdcHit.GetTimeRaw(thit));
-      ((THcSignalHit*) frNegTdcTime->ConstructedAt(nrNegTdcHits))->Set(padnum, rawNegTdcHit.GetTime(thit));
-      ++nrNegTdcHits;
+      frNegTdc->AddTdcHit(padnum, rawNegTdcHit, thit);
       fTotNumTdcHits++;
       fTotNumNegTdcHits++;
     }
     THcRawAdcHit& rawPosAdcHit = hit->GetRawAdcHitPos();
     for (UInt_t thit=0; thit<rawPosAdcHit.GetNPulses(); ++thit) {
-      ((THcSignalHit*) frPosAdcPedRaw->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPedRaw());
-      ((THcSignalHit*) frPosAdcPed->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPed());
-
-      ((THcSignalHit*) frPosAdcPulseIntRaw->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseIntRaw(thit));
-      ((THcSignalHit*) frPosAdcPulseInt->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseInt(thit));
-
-      ((THcSignalHit*) frPosAdcPulseAmpRaw->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseAmpRaw(thit));
-
-      ((THcSignalHit*) frPosAdcPulseAmp->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseAmp(thit));
-
-      ((THcSignalHit*) frPosAdcPulseTimeRaw->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseTimeRaw(thit));
-      ((THcSignalHit*) frPosAdcPulseTime->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseTime(thit)+fAdcTdcOffset);
+      Int_t row = frPosAdc->AddAdcPulse(padnum, rawPosAdcHit, thit, fAdcTdcOffset);
+      frPosAdc->Set(row, THcSignalTable::kErrorFlag, (rawPosAdcHit.GetPulseAmpRaw(thit) <= 0) ? 1 : 0);
 
-      if (rawPosAdcHit.GetPulseAmpRaw(thit) > 0)  ((THcSignalHit*) frPosAdcErrorFlag->ConstructedAt(nrPosAdcHits))->Set(padnum, 0);
-      if (rawPosAdcHit.GetPulseAmpRaw(thit) <= 0) ((THcSignalHit*) frPosAdcErrorFlag->ConstructedAt(nrPosAdcHits))->Set(padnum, 1);
-
-      ++nrPosAdcHits;
       fTotNumAdcHits++;
       fTotNumPosAdcHits++;
     }
     THcRawAdcHit& rawNegAdcHit = hit->GetRawAdcHitNeg();
     for (UInt_t thit=0; thit<rawNegAdcHit.GetNPulses(); ++thit) {
-      ((THcSignalHit*) frNegAdcPedRaw->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPedRaw());
-      ((THcSignalHit*) frNegAdcPed->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPed());
-
-      ((THcSignalHit*) frNegAdcPulseIntRaw->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseIntRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseInt->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseInt(thit));
-
-      ((THcSignalHit*) frNegAdcPulseAmpRaw->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseAmpRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseAmp->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseAmp(thit));
-      ((THcSignalHit*) frNegAdcPulseTimeRaw->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseTimeRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseTime->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseTime(thit)+fAdcTdcOffset);
-
-      if (rawNegAdcHit.GetPulseAmpRaw(thit) > 0)  ((THcSignalHit*) frNegAdcErrorFlag->ConstructedAt(nrNegAdcHits))->Set(padnum, 0);
-      if (rawNegAdcHit.GetPulseAmpRaw(thit) <= 0) ((THcSignalHit*) frNegAdcErrorFlag->ConstructedAt(nrNegAdcHits))->Set(padnum, 1);
+      Int_t row = frNegAdc->AddAdcPulse(padnum, rawNegAdcHit, thit, fAdcTdcOffset);
+      frNegAdc->Set(row, THcSignalTable::kErrorFlag, (rawNegAdcHit.GetPulseAmpRaw(thit) <= 0) ? 1 : 0);
 
-      ++nrNegAdcHits;
       fTotNumAdcHits++;
       fTotNumNegAdcHits++;
     }
@@ -849,7 +757,7 @@ Int_t THcScintillatorPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
     if (hit->GetRawTdcHitNeg().GetNHits() > 0)
       ((THcSignalHit*) frNegTDCHits->ConstructedAt(nrNegTDCHits++))->Set(padnum, hit->GetRawTdcHitNeg().GetTime()+fTdcOffset);
     // Should we make lists of offset corrected ADC Pulse times here too?  For now
-    // the frNegAdcPulseTime frPosAdcPulseTime have that offset correction.
+    // the frNegAdc and frPosAdc pulse times have that offset correction.
     //
     Bool_t badcraw_pos=kFALSE;
     Bool_t badcraw_neg=kFALSE;
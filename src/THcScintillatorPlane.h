@@ -20,6 +20,7 @@ using namespace std;
 
 class THaEvData;
 class THaSignalHit;
+class THcSignalTable;
 
 class THcScintillatorPlane : public THaSubDetector {
 
@@ -79,10 +80,6 @@ class THcScintillatorPlane : public THaSubDetector {
 
  protected:
 
-  TClonesArray* frPosAdcErrorFlag;
-  TClonesArray* frNegAdcErrorFlag;
-
-
   TClonesArray* frPosTDCHits;
   TClonesArray* frNegTDCHits;
   TClonesArray* frPosADCHits;
@@ -93,29 +90,10 @@ class THcScintillatorPlane : public THaSubDetector {
   TClonesArray* frNegADCPeds;
   TClonesArray* fHodoHits;
 
-  TClonesArray* frPosTdcTimeRaw;
-  TClonesArray* frPosAdcPedRaw;
-  TClonesArray* frPosAdcPulseIntRaw;
-  TClonesArray* frPosAdcPulseAmpRaw;
-  TClonesArray* frPosAdcPulseTimeRaw;
-
-  TClonesArray* frPosTdcTime;
-  TClonesArray* frPosAdcPed;
-  TClonesArray* frPosAdcPulseInt;
-  TClonesArray* frPosAdcPulseAmp;
-  TClonesArray* frPosAdcPulseTime;
-
-  TClonesArray* frNegTdcTimeRaw;
-  TClonesArray* frNegAdcPedRaw;
-  TClonesArray* frNegAdcPulseIntRaw;
-  TClonesArray* frNegAdcPulseAmpRaw;
-  TClonesArray* frNegAdcPulseTimeRaw;
-
-  TClonesArray* frNegTdcTime;
-  TClonesArray* frNegAdcPed;
-  TClonesArray* frNegAdcPulseInt;
-  TClonesArray* frNegAdcPulseAmp;
-  TClonesArray* frNegAdcPulseTime;
+  THcSignalTable* frPosTdc;   // Raw positive TDC hits
+  THcSignalTable* frPosAdc;   // Raw positive ADC pulses
+  THcSignalTable* frNegTdc;   // Raw negative TDC hits
+  THcSignalTable* frNegAdc;   // Raw negative ADC pulses
 
   //Hodoscopes Multiplicities
   Int_t fTotNumPosAdcHits;
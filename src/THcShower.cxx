@@ -19,14 +19,11 @@
 #include "TClonesArray.h"
 #include "THaTrackProj.h"
 #include "TMath.h"
-#include "Helper.h"
 
 #include <cstring>
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
-#include <numeric>
-#include <cassert>
 
 using namespace std;
 
@@ -590,11 +587,6 @@ THcShower::~THcShower()
   if( fIsInit )
     DeleteArrays();
 
-  for (THcShowerClusterListIt i=fClusterList->begin(); i!=fClusterList->end();
-       ++i) {
-    Podd::DeleteContainer(**i);
-    delete *i;
-  }
   delete fClusterList; fClusterList = 0;
 
   for( UInt_t i = 0; i<fNLayers; ++i) {
@@ -670,12 +662,8 @@ void THcShower::Clear(Option_t* opt)
 
   // Purge cluster list
 
-  for (THcShowerClusterListIt i=fClusterList->begin(); i!=fClusterList->end();
-       ++i) {
-    Podd::DeleteContainer(**i);
-    delete *i;
-  }
   fClusterList->clear();
+  fHitList.clear();
 }
 
 //_____________________________________________________________________________
@@ -750,7 +738,7 @@ Int_t THcShower::CoarseProcess( TClonesArray& tracks)
   THcHallCSpectrometer *app = static_cast<THcHallCSpectrometer*>(GetApparatus());
   fEtotNorm=fEtot/(app->GetPcentral());
   //
-  THcShowerHitSet HitSet;
+  fHitList.clear();
 
   for(UInt_t j=0; j < fNLayers; j++) {
 
@@ -773,15 +761,13 @@ Int_t THcShower::CoarseProcess( TClonesArray& tracks)
 	}
 	Double_t z = fLayerZPos[j] + BlockThick[j]/2.;      //front + thick/2
 
-	THcShowerHit* hit = new THcShowerHit(i,j,x,y,z,Edep,Epos,Eneg);
-
-	HitSet.insert(hit);   //<set> version
+	fHitList.push_back(THcShowerHit(i,j,x,y,z,Edep,Epos,Eneg));
       }
 
     }
   }
 
-  fNhits = HitSet.size();
+  fNhits = fHitList.size();
 
   //Debug output, print out hits before clustering.
 
@@ -792,17 +778,15 @@ Int_t THcShower::CoarseProcess( TClonesArray& tracks)
 
     cout << " event = " << fEvent << endl;
     cout << "  List of unclustered hits. Total hits:     " << fNhits << endl;
-    THcShowerHitIt it = HitSet.begin();    //<set> version
     for (Int_t i=0; i!=fNhits; i++) {
       cout << "  hit " << i << ": ";
-      (*(it++))->show();
+      fHitList[i].show();
     }
   }
 
   // Fill list of clusters.
 
-  ClusterHits(HitSet, fClusterList);
-  assert( HitSet.empty() );  // else bug in ClusterHits()
+  ClusterHits(fHitList, fClusterPool, fClusterList);
 
   fNclust = (*fClusterList).size();   //number of clusters
 
@@ -858,101 +842,117 @@ Int_t THcShower::CoarseProcess( TClonesArray& tracks)
 
 //-----------------------------------------------------------------------------
 
-void THcShower::ClusterHits(THcShowerHitSet& HitSet,
-			    THcShowerClusterList* ClusterList) {
-
-  // Collect hits from the HitSet into the clusters. The resultant clusters
-  // of hits are saved in the ClusterList.
-
-  while (HitSet.size() != 0) {
-
-    THcShowerCluster* cluster = new THcShowerCluster;
-
-    THcShowerHitIt it = HitSet.end();
-    (*cluster).insert(*(--it));   //Move the last hit from the hit list
-    HitSet.erase(it);             //into the 1st cluster
-
-    bool clustered = true;
-
-    while (clustered) {                   //Proceed while a hit is clustered
-
-      clustered = false;
-
-      for (THcShowerHitIt i=HitSet.begin(); i!=HitSet.end(); ++i) {
+// Root of the union-find tree of hit i, with path halving.
+//
+static Int_t ClusterRoot(vector<Int_t>& parent, Int_t i) {
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
 
-	for (THcShowerClusterIt k=(*cluster).begin(); k!=(*cluster).end();
-	     ++k) {
+void THcShower::ClusterHits(THcShowerHitList& HitList,
+			    vector<THcShowerCluster>& ClusterPool,
+			    THcShowerClusterList* ClusterList) {
 
-	  if ((**i).isNeighbour(*k)) {
-	    (*cluster).insert(*i);      //If the hit #i is neighbouring a hit
-	    HitSet.erase(i);            //in the cluster, then move it
-	                                //into the cluster.
-	    clustered = true;
-	  }
+  // Collect hits from the HitList into clusters of neighbouring hits
+  // (see THcShowerHit::isNeighbour). The clusters are taken from the
+  // ClusterPool, pointers to them are saved in the ClusterList.
+  //
+  // The hits are put in a (column,row) grid, and each hit is merged with
+  // the hits in its neighbouring cells by union-find. The clusters are
+  // ordered by their last hit in the HitList, starting from the end of the
+  // list, and the hits of a cluster keep their HitList order.
+
+  ClusterList->clear();
+
+  Int_t nhits = HitList.size();
+  if (nhits == 0) return;
+
+  Int_t colmin = HitList[0].hitColumn(), colmax = colmin;
+  Int_t rowmin = HitList[0].hitRow(), rowmax = rowmin;
+  for (Int_t i=1; i<nhits; i++) {
+    colmin = TMath::Min(colmin, HitList[i].hitColumn());
+    colmax = TMath::Max(colmax, HitList[i].hitColumn());
+    rowmin = TMath::Min(rowmin, HitList[i].hitRow());
+    rowmax = TMath::Max(rowmax, HitList[i].hitRow());
+  }
+  Int_t ncols = colmax - colmin + 1;
+  Int_t nrows = rowmax - rowmin + 1;
+
+  fClusterGrid.assign(ncols*nrows, -1);
+  fClusterParent.resize(nhits);
+  for (Int_t i=0; i<nhits; i++) {
+    fClusterParent[i] = i;
+    Int_t cell = (HitList[i].hitColumn()-colmin)*nrows
+      + HitList[i].hitRow()-rowmin;
+    if (fClusterGrid[cell] < 0)
+      fClusterGrid[cell] = i;
+    else                        //two hits in the same block
+      fClusterParent[i] = ClusterRoot(fClusterParent, fClusterGrid[cell]);
+  }
 
-	  if (clustered) break;
-	}                               //k
+  // Cells of the neighbours: sharing a side or a corner, or in the same
+  // row but separated by no more than a block.
+  const Int_t nneighbours = 10;
+  const Int_t dcol[nneighbours] = {-2, -1, -1, -1, 0, 0, 1, 1, 1, 2};
+  const Int_t drow[nneighbours] = { 0, -1,  0,  1,-1, 1,-1, 0, 1, 0};
+
+  for (Int_t i=0; i<nhits; i++) {
+    Int_t col = HitList[i].hitColumn() - colmin;
+    Int_t row = HitList[i].hitRow() - rowmin;
+    for (Int_t k=0; k<nneighbours; k++) {
+      Int_t c = col + dcol[k];
+      Int_t r = row + drow[k];
+      if (c < 0 || c >= ncols || r < 0 || r >= nrows) continue;
+      Int_t j = fClusterGrid[c*nrows + r];
+      if (j < 0) continue;
+      Int_t rooti = ClusterRoot(fClusterParent, i);
+      Int_t rootj = ClusterRoot(fClusterParent, j);
+      if (rooti != rootj) fClusterParent[TMath::Max(rooti,rootj)] =
+			    TMath::Min(rooti,rootj);
+    }
+  }
 
-	if (clustered) break;
-      }                                 //i
+  // Number the clusters, starting from the end of the hit list.
 
-    }                                   //while clustered
+  fClusterIndex.assign(nhits, -1);
+  Int_t nclust = 0;
+  for (Int_t i=nhits-1; i>=0; i--) {
+    Int_t root = ClusterRoot(fClusterParent, i);
+    if (fClusterIndex[root] < 0) fClusterIndex[root] = nclust++;
+  }
 
-    ClusterList->push_back(cluster);   //Put the cluster in the cluster list
+  // Fill the clusters, accumulating the cluster sums on the way.
 
-  }                                     //While hit_list not exhausted
+  if ((Int_t)ClusterPool.size() < nclust) ClusterPool.resize(nclust);
+  for (Int_t icl=0; icl<nclust; icl++) ClusterPool[icl].clear();
+  for (Int_t i=0; i<nhits; i++) {
+    Int_t icl = fClusterIndex[ClusterRoot(fClusterParent, i)];
+    ClusterPool[icl].addHit(&HitList[i]);
+  }
+  for (Int_t icl=0; icl<nclust; icl++) ClusterList->push_back(&ClusterPool[icl]);
 
 };
 
 //-----------------------------------------------------------------------------
 
-// Various helper functions to accumulate hit related quantities.
-
-Double_t addE(Double_t x, THcShowerHit* h) {
-  return x + h->hitE();
-}
-
-Double_t addX(Double_t x, THcShowerHit* h) {
-  return x + h->hitE() * h->hitX();
-}
-
-Double_t addY(Double_t x, THcShowerHit* h) {
-  return x + h->hitE() * h->hitY();
-}
-
-Double_t addZ(Double_t x, THcShowerHit* h) {
-  return x + h->hitE() * h->hitZ();
-}
-
-Double_t addEpr(Double_t x, THcShowerHit* h) {
-  return h->hitColumn() == 0 ? x + h->hitE() : x;
-}
-
-Double_t addEpos(Double_t x, THcShowerHit* h) {
-  return x + h->hitEpos();
-}
-
-Double_t addEneg(Double_t x, THcShowerHit* h) {
-  return x + h->hitEneg();
-}
-
 // Y coordinate of center of gravity of cluster, calculated as hit energy
 // weighted average. Put X out of the calorimeter (-100 cm), if there is no
 // energy deposition in the cluster.
 //
 Double_t clY(THcShowerCluster* cluster) {
-  Double_t Etot = accumulate((*cluster).begin(),(*cluster).end(),0.,addE);
-  return (Etot != 0. ?
-	  accumulate((*cluster).begin(),(*cluster).end(),0.,addY)/Etot : -100.);
+  Double_t Etot = cluster->sumE();
+  return (Etot != 0. ? cluster->sumEY()/Etot : -100.);
 }
 // X coordinate of center of gravity of cluster, calculated as hit energy
 // weighted average. Put X out of the calorimeter (-100 cm), if there is no
 // energy deposition in the cluster.
 //
 Double_t clX(THcShowerCluster* cluster) {
-  Double_t Etot = accumulate((*cluster).begin(),(*cluster).end(),0.,addE);
-  return (Etot != 0. ?
-	  accumulate((*cluster).begin(),(*cluster).end(),0.,addX)/Etot : -100.);
+  Double_t Etot = cluster->sumE();
+  return (Etot != 0. ? cluster->sumEX()/Etot : -100.);
 }
 
 // Z coordinate of center of gravity of cluster, calculated as a hit energy
@@ -960,21 +960,20 @@ Double_t clX(THcShowerCluster* cluster) {
 // deposition in the cluster.
 //
 Double_t clZ(THcShowerCluster* cluster) {
-  Double_t Etot = accumulate((*cluster).begin(),(*cluster).end(),0.,addE);
-  return (Etot != 0. ?
-	  accumulate((*cluster).begin(),(*cluster).end(),0.,addZ)/Etot : 0.);
+  Double_t Etot = cluster->sumE();
+  return (Etot != 0. ? cluster->sumEZ()/Etot : 0.);
 }
 
 //Energy depostion in a cluster
 //
 Double_t clE(THcShowerCluster* cluster) {
-    return accumulate((*cluster).begin(),(*cluster).end(),0.,addE);
+    return cluster->sumE();
 }
 
 //Energy deposition in the Preshower (1st plane) for a cluster
 //
 Double_t clEpr(THcShowerCluster* cluster) {
-    return accumulate((*cluster).begin(),(*cluster).end(),0.,addEpr);
+    return cluster->sumEpr();
 }
 
 //Cluster energy deposition in plane iplane=0,..,3:
@@ -990,27 +989,7 @@ Double_t clEplane(THcShowerCluster* cluster, Int_t iplane, Int_t side) {
     return -1;
   }
 
-  THcShowerHitSet pcluster;
-  for (THcShowerHitIt it=(*cluster).begin(); it!=(*cluster).end(); ++it) {
-    if ((*it)->hitColumn() == iplane) pcluster.insert(*it);
-  }
-
-  Double_t Eplane;
-  switch (side) {
-  case 0 :
-    Eplane = accumulate(pcluster.begin(),pcluster.end(),0.,addEpos);
-    break;
-  case 1 :
-    Eplane = accumulate(pcluster.begin(),pcluster.end(),0.,addEneg);
-    break;
-  case 2 :
-    Eplane = accumulate(pcluster.begin(),pcluster.end(),0.,addE);
-    break;
-  default :
-    Eplane = 0. ;
-  }
-
-  return Eplane;
+  return cluster->sumEplane(iplane, side);
 }
 
 //-----------------------------------------------------------------------------
@@ -226,6 +226,13 @@ protected:
   Double_t fETotTrackNorm;   // Total energy divided by momentum of the best track
 
   THcShowerClusterList* fClusterList;   // List of hit clusters
+  THcShowerHitList fHitList;            // Hits of the event
+  vector<THcShowerCluster> fClusterPool; // Storage of the clusters
+
+  // Work space of ClusterHits, kept between events
+  vector<Int_t> fClusterGrid;    // Hit in each (column,row) cell, -1 if none
+  vector<Int_t> fClusterParent;  // Union-find parent of each hit
+  vector<Int_t> fClusterIndex;   // Cluster number of each root hit
 
 
   // Geometrical parameters.
@@ -278,7 +285,9 @@ protected:
   // Cluster to track association method.
   Int_t MatchCluster(THaTrack*, Double_t&, Double_t&);
 
-  void ClusterHits(THcShowerHitSet& HitSet, THcShowerClusterList* ClusterList);
+  void ClusterHits(THcShowerHitList& HitList,
+		   vector<THcShowerCluster>& ClusterPool,
+		   THcShowerClusterList* ClusterList);
 
   virtual Int_t      End(THaRunBase *r = 0);
 
@@ -290,14 +299,6 @@ protected:
 
 ///////////////////////////////////////////////////////////////////////////////
 
-// Various helper functions to accumulate hit related quantities.
-
-Double_t addE(Double_t x, THcShowerHit* h);
-Double_t addX(Double_t x, THcShowerHit* h);
-Double_t addY(Double_t x, THcShowerHit* h);
-Double_t addZ(Double_t x, THcShowerHit* h);
-Double_t addEpr(Double_t x, THcShowerHit* h);
-
 // Methods to calculate coordinates and energy depositions for a given cluster.
 
 Double_t clX(THcShowerCluster* cluster);
@@ -9,6 +9,7 @@
 #include "THcHodoscope.h"
 #include "TClonesArray.h"
 #include "THcSignalHit.h"
+#include "THcSignalTable.h"
 #include "THcGlobals.h"
 #include "THcParmList.h"
 #include "THcHitList.h"
@@ -20,13 +21,11 @@
 #include "THaTrackProj.h"
 #include "THcCherenkov.h"         //for efficiency calculations
 #include "THcHallCSpectrometer.h"
-#include "Helper.h"
 
 #include <cstring>
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
-#include <cassert>
 #include <fstream>
 
 using namespace std;
@@ -43,16 +42,7 @@ THcShowerArray::THcShowerArray( const char* name,
   fADCHits = new TClonesArray("THcSignalHit",100);
   fLayerNum = layernum;
 
-  frAdcPedRaw       = new TClonesArray("THcSignalHit", 16);
-  frAdcErrorFlag    = new TClonesArray("THcSignalHit", 16);
-  frAdcPulseIntRaw  = new TClonesArray("THcSignalHit", 16);
-  frAdcPulseAmpRaw  = new TClonesArray("THcSignalHit", 16);
-  frAdcPulseTimeRaw = new TClonesArray("THcSignalHit", 16);
-
-  frAdcPed       = new TClonesArray("THcSignalHit", 16);
-  frAdcPulseInt  = new TClonesArray("THcSignalHit", 16);
-  frAdcPulseAmp  = new TClonesArray("THcSignalHit", 16);
-  frAdcPulseTime = new TClonesArray("THcSignalHit", 16);
+  frAdc = new THcSignalTable(THcSignalTable::kAdcSignals, 16);
 
   fClusterList = new THcShowerClusterList;         // List of hit clusters
 }
@@ -62,7 +52,7 @@ THcShowerArray::~THcShowerArray()
 {
   // Destructor
 
-  Clear(); // deletes allocations in fClusterList
+  Clear();
   for (UInt_t i=0; i<fNRows; i++) {
     delete [] fXPos[i];
     delete [] fYPos[i];
@@ -83,16 +73,7 @@ THcShowerArray::~THcShowerArray()
 
   delete fADCHits; fADCHits = NULL;
 
-  delete frAdcPedRaw; frAdcPedRaw = NULL;
-  delete frAdcErrorFlag; frAdcErrorFlag = NULL;
-  delete frAdcPulseIntRaw; frAdcPulseIntRaw = NULL;
-  delete frAdcPulseAmpRaw; frAdcPulseAmpRaw = NULL;
-  delete frAdcPulseTimeRaw; frAdcPulseTimeRaw = NULL;
-
-  delete frAdcPed; frAdcPed = NULL;
-  delete frAdcPulseInt; frAdcPulseInt = NULL;
-  delete frAdcPulseAmp; frAdcPulseAmp = NULL;
-  delete frAdcPulseTime; frAdcPulseTime = NULL;
+  delete frAdc; frAdc = NULL;
 
   //  delete [] fA;
   //delete [] fP;
@@ -424,27 +405,31 @@ Int_t THcShowerArray::DefineVariables( EMode mode )
 
   // Register variables in global list
   if (fDebugAdc) {
-    RVarDef vars[] = {
-      {"adcPedRaw",       "List of raw ADC pedestals",         "frAdcPedRaw.THcSignalHit.GetData()"},
-      {"adcPulseIntRaw",  "List of raw ADC pulse integrals.",  "frAdcPulseIntRaw.THcSignalHit.GetData()"},
-      {"adcPulseAmpRaw",  "List of raw ADC pulse amplitudes.", "frAdcPulseAmpRaw.THcSignalHit.GetData()"},
-      {"adcPulseTimeRaw", "List of raw ADC pulse times.",      "frAdcPulseTimeRaw.THcSignalHit.GetData()"},
-
-      {"adcPed",          "List of ADC pedestals",             "frAdcPed.THcSignalHit.GetData()"},
-      {"adcPulseInt",     "List of ADC pulse integrals.",      "frAdcPulseInt.THcSignalHit.GetData()"},
-      {"adcPulseAmp",     "List of ADC pulse amplitudes.",     "frAdcPulseAmp.THcSignalHit.GetData()"},
-      {"adcPulseTime",    "List of ADC pulse times.",          "frAdcPulseTime.THcSignalHit.GetData()"},
+    THcSignalTable::SignalVar_t adcvars[] = {
+      {"adcPedRaw",       "List of raw ADC pedestals",         THcSignalTable::kPedRaw},
+      {"adcPulseIntRaw",  "List of raw ADC pulse integrals.",  THcSignalTable::kPulseIntRaw},
+      {"adcPulseAmpRaw",  "List of raw ADC pulse amplitudes.", THcSignalTable::kPulseAmpRaw},
+      {"adcPulseTimeRaw", "List of raw ADC pulse times.",      THcSignalTable::kPulseTimeRaw},
+
+      {"adcPed",          "List of ADC pedestals",             THcSignalTable::kPed},
+      {"adcPulseInt",     "List of ADC pulse integrals.",      THcSignalTable::kPulseInt},
+      {"adcPulseAmp",     "List of ADC pulse amplitudes.",     THcSignalTable::kPulseAmp},
+      {"adcPulseTime",    "List of ADC pulse times.",          THcSignalTable::kPulseTime},
       { 0 }
     };
-    DefineVarsFromList( vars, mode);
+    frAdc->DefineVariables(mode, GetPrefix(), adcvars);
   } //end debug statement
 
+  THcSignalTable::SignalVar_t adcvars[] = {
+    {"adcErrorFlag",       "Error Flag When FPGA Fails",      THcSignalTable::kErrorFlag},
+    {"adcCounter",      "List of ADC counter numbers.",      THcSignalTable::kPaddle},  //raw occupancy
+    { 0 }
+  };
+  frAdc->DefineVariables(mode, GetPrefix(), adcvars);
+
   RVarDef vars[] = {
     //{"adchits", "List of ADC hits", "fADCHits.THcSignalHit.GetPaddleNumber()"}, // appears an empty histogram in the root file
 
-    {"adcErrorFlag",       "Error Flag When FPGA Fails",      "frAdcErrorFlag.THcSignalHit.GetData()"},
-
-    {"adcCounter",      "List of ADC counter numbers.",      "frAdcPulseIntRaw.THcSignalHit.GetPaddleNumber()"},  //raw occupancy
     {"numGoodAdcHits", "Number of Good ADC Hits per PMT", "fNumGoodAdcHits" },                                   //good occupancy
 
     {"totNumAdcHits", "Total Number of ADC Hits", "fTotNumAdcHits" },                                            // raw multiplicity
@@ -487,23 +472,10 @@ void THcShowerArray::Clear( Option_t* )
   fMatchClY = -1000.;
   fMatchClMaxEnergyBlock = -1000.;
 
-  for (THcShowerClusterListIt i=fClusterList->begin(); i!=fClusterList->end();
-       ++i) {
-    Podd::DeleteContainer(**i);
-    delete *i;
-  }
   fClusterList->clear();
+  fHitList.clear();
 
-  frAdcPedRaw->Clear();
-  frAdcErrorFlag->Clear();
-  frAdcPulseIntRaw->Clear();
-  frAdcPulseAmpRaw->Clear();
-  frAdcPulseTimeRaw->Clear();
-
-  frAdcPed->Clear();
-  frAdcPulseInt->Clear();
-  frAdcPulseAmp->Clear();
-  frAdcPulseTime->Clear();
+  frAdc->Clear();
 
   for (UInt_t ielem = 0; ielem < fGoodAdcPed.size(); ielem++) {
     fGoodAdcPulseIntRaw.at(ielem)      = 0.0;
@@ -536,7 +508,7 @@ Int_t THcShowerArray::CoarseProcess( TClonesArray& tracks )
   // Save energy deposition in the module as hit mean energy, do not use
   // positive and negative side energies.
 
-  THcShowerHitSet HitSet;         //set of hits
+  fHitList.clear();
 
   UInt_t k=0;
   for(UInt_t j=0; j < fNColumns; j++) {
@@ -544,10 +516,8 @@ Int_t THcShowerArray::CoarseProcess( TClonesArray& tracks )
 
       if (fGoodAdcPulseInt.at(k) > 0) {    //hit
 
-	THcShowerHit* hit =
-	  new THcShowerHit(i, j, fXPos[i][j], fYPos[i][j], fZPos[i][j], fE[k], 0., 0.);
-
-	HitSet.insert(hit);
+	fHitList.push_back(THcShowerHit(i, j, fXPos[i][j], fYPos[i][j],
+					fZPos[i][j], fE[k], 0., 0.));
       }
 
       k++;
@@ -561,26 +531,25 @@ Int_t THcShowerArray::CoarseProcess( TClonesArray& tracks )
 	 << endl;
 
     cout << "  List of unclustered hits. Total hits:     " << fTotNumAdcHits << endl;
-    THcShowerHitIt it = HitSet.begin();    //<set> version
-    for (Int_t i=0; i!=fTotNumGoodAdcHits; i++) {
+    for (UInt_t i=0; i!=fHitList.size(); i++) {
       cout << "  hit " << i << ": ";
-      (*(it++))->show();
+      fHitList[i].show();
     }
   }
 
   ////Sanity check. (Vardan)
 
-  // if ((int)HitSet.size() != fTotNumGoodAdcHits) {
+  // if ((int)fHitList.size() != fTotNumGoodAdcHits) {
   //	cout << "***" << endl;
-  //	cout << "*** THcShowerArray::CoarseProcess: HitSet.size = " << HitSet.size()
+  //	cout << "*** THcShowerArray::CoarseProcess: HitSet.size = " << fHitList.size()
   //	     << " != fTotNumGoodAdcHits = " << fTotNumGoodAdcHits << endl;
   //	cout << "***" << endl;
   //    }
 
   // Cluster hits and fill list of clusters.
 
-  static_cast<THcShower*>(fParent)->ClusterHits(HitSet, fClusterList);
-  assert( HitSet.empty() );  // else bug in ClusterHits()
+  static_cast<THcShower*>(fParent)->ClusterHits(fHitList, fClusterPool,
+						 fClusterList);
 
   fNclust = (*fClusterList).size();         //number of clusters
 
@@ -873,16 +842,16 @@ void THcShowerArray::FillADC_DynamicPedestal()
 {
   Double_t StartTime = 0.0;
   if( fglHod ) StartTime = fglHod->GetStartTime();
-  for (Int_t ielem=0;ielem<frAdcPulseInt->GetEntries();ielem++) {
+  for (Int_t ielem=0;ielem<frAdc->GetNRows();ielem++) {
     
-    Int_t npad           = ((THcSignalHit*) frAdcPulseInt->ConstructedAt(ielem))->GetPaddleNumber() - 1;
-    Double_t pulseIntRaw = ((THcSignalHit*) frAdcPulseIntRaw->ConstructedAt(ielem))->GetData();
-    Double_t pulsePed    = ((THcSignalHit*) frAdcPed->ConstructedAt(ielem))->GetData();
-    Double_t pulseInt    = ((THcSignalHit*) frAdcPulseInt->ConstructedAt(ielem))->GetData();
-    Double_t pulseAmp    = ((THcSignalHit*) frAdcPulseAmp->ConstructedAt(ielem))->GetData();
-    Double_t pulseTime   = ((THcSignalHit*) frAdcPulseTime->ConstructedAt(ielem))->GetData();
+    Int_t npad           = frAdc->GetPaddle(ielem) - 1;
+    Double_t pulseIntRaw = frAdc->Get(ielem, THcSignalTable::kPulseIntRaw);
+    Double_t pulsePed    = frAdc->Get(ielem, THcSignalTable::kPed);
+    Double_t pulseInt    = frAdc->Get(ielem, THcSignalTable::kPulseInt);
+    Double_t pulseAmp    = frAdc->Get(ielem, THcSignalTable::kPulseAmp);
+    Double_t pulseTime   = frAdc->Get(ielem, THcSignalTable::kPulseTime);
     Double_t adctdcdiffTime = StartTime-pulseTime;
-    Bool_t errorflag     = ((THcSignalHit*) frAdcErrorFlag->ConstructedAt(ielem))->GetData();
+    Bool_t errorflag     = frAdc->Get(ielem, THcSignalTable::kErrorFlag);
     Bool_t pulseTimeCut  = (adctdcdiffTime > fAdcTimeWindowMin[npad]) &&  (adctdcdiffTime < fAdcTimeWindowMax[npad]);
 
     if (!errorflag)
@@ -923,16 +892,7 @@ Int_t THcShowerArray::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
 
   fADCHits->Clear();
 
-  frAdcPedRaw->Clear();
-  frAdcErrorFlag->Clear();
-  frAdcPulseIntRaw->Clear();
-  frAdcPulseAmpRaw->Clear();
-  frAdcPulseTimeRaw->Clear();
-
-  frAdcPed->Clear();
-  frAdcPulseInt->Clear();
-  frAdcPulseAmp->Clear();
-  frAdcPulseTime->Clear();
+  frAdc->Clear();
 
   for(Int_t i=0;i<fNelem;i++) {
     //fA[i] = 0;
@@ -951,8 +911,6 @@ Int_t THcShowerArray::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
 
   Int_t ihit = nexthit;
 
-  UInt_t nrAdcHits = 0;
-
   while(ihit < nrawhits) {
     THcRawShowerHit* hit = (THcRawShowerHit *) rawhits->At(ihit);
 
@@ -964,25 +922,14 @@ Int_t THcShowerArray::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
     THcRawAdcHit& rawAdcHit = hit->GetRawAdcHitPos();
     //
     for (UInt_t thit=0; thit<rawAdcHit.GetNPulses(); ++thit) {
-      ((THcSignalHit*) frAdcPedRaw->ConstructedAt(nrAdcHits))->Set(padnum, rawAdcHit.GetPedRaw());
-        fThresh[padnum-1]=rawAdcHit.GetPedRaw()*rawAdcHit.GetF250_PeakPedestalRatio()+fAdcThreshold;
-     ((THcSignalHit*) frAdcPed->ConstructedAt(nrAdcHits))->Set(padnum, rawAdcHit.GetPed());
-
-      ((THcSignalHit*) frAdcPulseIntRaw->ConstructedAt(nrAdcHits))->Set(padnum, rawAdcHit.GetPulseIntRaw(thit));
-      ((THcSignalHit*) frAdcPulseInt->ConstructedAt(nrAdcHits))->Set(padnum, rawAdcHit.GetPulseInt(thit));
-
-      ((THcSignalHit*) frAdcPulseAmpRaw->ConstructedAt(nrAdcHits))->Set(padnum, rawAdcHit.GetPulseAmpRaw(thit));
-      ((THcSignalHit*) frAdcPulseAmp->ConstructedAt(nrAdcHits))->Set(padnum, rawAdcHit.GetPulseAmp(thit));
-
-      ((THcSignalHit*) frAdcPulseTimeRaw->ConstructedAt(nrAdcHits))->Set(padnum, rawAdcHit.GetPulseTimeRaw(thit));
-      ((THcSignalHit*) frAdcPulseTime->ConstructedAt(nrAdcHits))->Set(padnum, rawAdcHit.GetPulseTime(thit)+fAdcTdcOffset);
+      Int_t row = frAdc->AddAdcPulse(padnum, rawAdcHit, thit, fAdcTdcOffset);
+      fThresh[padnum-1]=rawAdcHit.GetPedRaw()*rawAdcHit.GetF250_PeakPedestalRatio()+fAdcThreshold;
 
       if (rawAdcHit.GetPulseAmp(thit)>0&&rawAdcHit.GetPulseIntRaw(thit)>0) {
-	((THcSignalHit*) frAdcErrorFlag->ConstructedAt(nrAdcHits))->Set(padnum,0);
+	frAdc->Set(row, THcSignalTable::kErrorFlag, 0);
       } else {
-	((THcSignalHit*) frAdcErrorFlag->ConstructedAt(nrAdcHits))->Set(padnum,1);
+	frAdc->Set(row, THcSignalTable::kErrorFlag, 1);
       }
-      ++nrAdcHits;
     }
     ihit++;
   }
@@ -28,6 +28,7 @@
 class THaEvData;
 class THaSignalHit;
 class THcHodoscope;
+class THcSignalTable;
 
 class THcShowerArray : public THaSubDetector {
 
@@ -187,17 +188,10 @@ protected:
   Double_t fClustSize;
 
   THcShowerClusterList* fClusterList;   // List of hit clusters
+  THcShowerHitList fHitList;            // Hits of the event
+  vector<THcShowerCluster> fClusterPool; // Storage of the clusters
 
-  TClonesArray* frAdcPedRaw;
-  TClonesArray* frAdcErrorFlag;
-  TClonesArray* frAdcPulseIntRaw;
-  TClonesArray* frAdcPulseAmpRaw;
-  TClonesArray* frAdcPulseTimeRaw;
-
-  TClonesArray* frAdcPed;
-  TClonesArray* frAdcPulseInt;
-  TClonesArray* frAdcPulseAmp;
-  TClonesArray* frAdcPulseTime;
+  THcSignalTable* frAdc;   // Raw ADC pulses
 
   //Quatitites for efficiency calculations.
 
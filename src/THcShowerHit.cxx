@@ -59,3 +59,57 @@ bool THcShowerHit::operator<(THcShowerHit rhs) const {
   else
     return fRow < rhs.fRow;
 }
+
+//____________________________________________________________________________
+// Reset the cluster to an empty one.
+//
+void THcShowerCluster::clear() {
+  fHits.clear();
+  fE=fEX=fEY=fEZ=0.;
+  fEpr=0.;
+  fEpos.clear();
+  fEneg.clear();
+  fEcol.clear();
+}
+
+//____________________________________________________________________________
+// Add a hit to the cluster and accumulate its contributions to the
+// cluster sums.
+//
+void THcShowerCluster::addHit(THcShowerHit* hit) {
+  fHits.push_back(hit);
+
+  Double_t E = hit->hitE();
+  fE  += E;
+  fEX += E * hit->hitX();
+  fEY += E * hit->hitY();
+  fEZ += E * hit->hitZ();
+
+  Int_t col = hit->hitColumn();
+  if (col == 0) fEpr += E;
+  if (col >= 0) {
+    if (col >= (Int_t)fEcol.size()) {
+      fEpos.resize(col+1, 0.);
+      fEneg.resize(col+1, 0.);
+      fEcol.resize(col+1, 0.);
+    }
+    fEpos[col] += hit->hitEpos();
+    fEneg[col] += hit->hitEneg();
+    fEcol[col] += E;
+  }
+}
+
+//____________________________________________________________________________
+// Energy deposition in a column of the cluster.
+//
+Double_t THcShowerCluster::sumEplane(Int_t icol, Int_t side) const {
+  if (icol < 0 || icol >= (Int_t)fEcol.size()) return 0.;
+  switch (side) {
+  case 0 :
+    return fEpos[icol];
+  case 1 :
+    return fEneg[icol];
+  default :
+    return fEcol[icol];
+  }
+}
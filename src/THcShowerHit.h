@@ -3,7 +3,7 @@
 
 // HMS calorimeter hits, version 2
 
-#include <set>
+#include <vector>
 #include <iterator>
 #include <iostream>
 #include <memory>
@@ -72,12 +72,74 @@ public:
 
 //____________________________________________________________________________
 
-// Container (collection) of hits and its iterator.
+// Flat list of the hits of an event.
 //
-typedef set<THcShowerHit*> THcShowerHitSet;
-typedef THcShowerHitSet::iterator THcShowerHitIt;
+typedef vector<THcShowerHit> THcShowerHitList;
+
+//____________________________________________________________________________
+
+// Cluster of neighbouring hits. The hits are owned by the hit list the
+// cluster was built from. Energy sums needed for the cluster coordinates
+// and energy depositions are accumulated as hits are added.
+//
+class THcShowerCluster {
+
+  vector<THcShowerHit*> fHits;  //hits in the cluster
+  Double_t fE;                  //sum of hit energies
+  Double_t fEX, fEY, fEZ;       //sums of hit energy weighted coordinates
+  Double_t fEpr;                //energy deposition in the 1-st column
+  vector<Double_t> fEpos;       //energy deposition per column, positive PMTs
+  vector<Double_t> fEneg;       //energy deposition per column, negative PMTs
+  vector<Double_t> fEcol;       //energy deposition per column, both sides
+
+public:
+
+  typedef vector<THcShowerHit*>::iterator iterator;
+
+  THcShowerCluster() {
+    clear();
+  }
+
+  void clear();
+  void addHit(THcShowerHit* hit);
+
+  iterator begin() {
+    return fHits.begin();
+  }
+
+  iterator end() {
+    return fHits.end();
+  }
+
+  UInt_t size() const {
+    return fHits.size();
+  }
+
+  Double_t sumE() const {
+    return fE;
+  }
+
+  Double_t sumEX() const {
+    return fEX;
+  }
+
+  Double_t sumEY() const {
+    return fEY;
+  }
+
+  Double_t sumEZ() const {
+    return fEZ;
+  }
+
+  Double_t sumEpr() const {
+    return fEpr;
+  }
+
+  // Energy deposition in column icol: side=0 -- positive PMTs,
+  // side=1 -- negative PMTs, otherwise both.
+  Double_t sumEplane(Int_t icol, Int_t side) const;
+};
 
-typedef THcShowerHitSet THcShowerCluster;
 typedef THcShowerCluster::iterator THcShowerClusterIt;
 
 //______________________________________________________________________________
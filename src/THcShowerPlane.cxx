@@ -9,6 +9,7 @@
 #include "THcHodoscope.h"
 #include "TClonesArray.h"
 #include "THcSignalHit.h"
+#include "THcSignalTable.h"
 #include "THcGlobals.h"
 #include "THcParmList.h"
 #include "THcHitList.h"
@@ -42,29 +43,10 @@ THcShowerPlane::THcShowerPlane( const char* name,
   fPosADCHits = new TClonesArray("THcSignalHit",fNelem);
   fNegADCHits = new TClonesArray("THcSignalHit",fNelem);
 
-  frPosAdcErrorFlag    = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPedRaw       = new TClonesArray("THcSignalHit", 16);
-  frPosAdcThreshold    = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseIntRaw  = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseAmpRaw  = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseTimeRaw = new TClonesArray("THcSignalHit", 16);
-
-  frPosAdcPed       = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseInt  = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseAmp  = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseTime = new TClonesArray("THcSignalHit", 16);
-
-  frNegAdcErrorFlag    = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPedRaw       = new TClonesArray("THcSignalHit", 16);
-  frNegAdcThreshold    = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseIntRaw  = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseAmpRaw  = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseTimeRaw = new TClonesArray("THcSignalHit", 16);
-
-  frNegAdcPed       = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseInt  = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseAmp  = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseTime = new TClonesArray("THcSignalHit", 16);
+  frPosAdc = new THcSignalTable(THcSignalTable::kAdcSignals |
+				(1<<THcSignalTable::kThreshold), 16);
+  frNegAdc = new THcSignalTable(THcSignalTable::kAdcSignals |
+				(1<<THcSignalTable::kThreshold), 16);
 
   //#if ROOT_VERSION_CODE < ROOT_VERSION(5,32,0)
   //  fPosADCHitsClass = fPosADCHits->GetClass();
@@ -81,29 +63,8 @@ THcShowerPlane::~THcShowerPlane()
   delete fPosADCHits; fPosADCHits = NULL;
   delete fNegADCHits; fNegADCHits = NULL;
 
-  delete  frPosAdcErrorFlag; frPosAdcErrorFlag = NULL;
-  delete  frPosAdcPedRaw; frPosAdcPedRaw = NULL;
-  delete  frPosAdcThreshold; frPosAdcThreshold = NULL;
-  delete  frPosAdcPulseIntRaw; frPosAdcPulseIntRaw = NULL;
-  delete  frPosAdcPulseAmpRaw; frPosAdcPulseAmpRaw = NULL;
-  delete  frPosAdcPulseTimeRaw; frPosAdcPulseTimeRaw = NULL;
-
-  delete  frPosAdcPed; frPosAdcPed = NULL;
-  delete  frPosAdcPulseInt; frPosAdcPulseInt = NULL;
-  delete  frPosAdcPulseAmp; frPosAdcPulseAmp = NULL;
-  delete  frPosAdcPulseTime; frPosAdcPulseTime = NULL;
-
-  delete  frNegAdcErrorFlag; frNegAdcErrorFlag = NULL;
-  delete  frNegAdcPedRaw; frNegAdcPedRaw = NULL;
-  delete  frNegAdcThreshold; frNegAdcThreshold = NULL;
-  delete  frNegAdcPulseIntRaw; frNegAdcPulseIntRaw = NULL;
-  delete  frNegAdcPulseAmpRaw; frNegAdcPulseAmpRaw = NULL;
-  delete  frNegAdcPulseTimeRaw; frNegAdcPulseTimeRaw = NULL;
-
-  delete  frNegAdcPed; frNegAdcPed = NULL;
-  delete  frNegAdcPulseInt; frNegAdcPulseInt = NULL;
-  delete  frNegAdcPulseAmp; frNegAdcPulseAmp = NULL;
-  delete  frNegAdcPulseTime; frNegAdcPulseTime = NULL;
+  delete frPosAdc; frPosAdc = NULL;
+  delete frNegAdc; frNegAdc = NULL;
 
   delete [] fPosPedSum;
   delete [] fPosPedSum2;
@@ -325,29 +286,33 @@ Int_t THcShowerPlane::DefineVariables( EMode mode )
   // Register variables in global list
 
   if (fDebugAdc) {
-    RVarDef vars[] = {
-      {"posAdcPedRaw",       "List of positive raw ADC pedestals",         "frPosAdcPedRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseIntRaw",  "List of positive raw ADC pulse integrals.",  "frPosAdcPulseIntRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseAmpRaw",  "List of positive raw ADC pulse amplitudes.", "frPosAdcPulseAmpRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseTimeRaw", "List of positive raw ADC pulse times.",      "frPosAdcPulseTimeRaw.THcSignalHit.GetData()"},
-
-      {"posAdcPed",          "List of positive ADC pedestals",             "frPosAdcPed.THcSignalHit.GetData()"},
-      {"posAdcPulseInt",     "List of positive ADC pulse integrals.",      "frPosAdcPulseInt.THcSignalHit.GetData()"},
-      {"posAdcPulseAmp",     "List of positive ADC pulse amplitudes.",     "frPosAdcPulseAmp.THcSignalHit.GetData()"},
-      {"posAdcPulseTime",    "List of positive ADC pulse times.",          "frPosAdcPulseTime.THcSignalHit.GetData()"},
-
-      {"negAdcPedRaw",       "List of negative raw ADC pedestals",         "frNegAdcPedRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseIntRaw",  "List of negative raw ADC pulse integrals.",  "frNegAdcPulseIntRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseAmpRaw",  "List of negative raw ADC pulse amplitudes.", "frNegAdcPulseAmpRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseTimeRaw", "List of negative raw ADC pulse times.",      "frNegAdcPulseTimeRaw.THcSignalHit.GetData()"},
-
-      {"negAdcPed",          "List of negative ADC pedestals",             "frNegAdcPed.THcSignalHit.GetData()"},
-      {"negAdcPulseInt",     "List of negative ADC pulse integrals.",      "frNegAdcPulseInt.THcSignalHit.GetData()"},
-      {"negAdcPulseAmp",     "List of negative ADC pulse amplitudes.",     "frNegAdcPulseAmp.THcSignalHit.GetData()"},
-      {"negAdcPulseTime",    "List of negative ADC pulse times.",          "frNegAdcPulseTime.THcSignalHit.GetData()"},
+    THcSignalTable::SignalVar_t posvars[] = {
+      {"posAdcPedRaw",       "List of positive raw ADC pedestals",         THcSignalTable::kPedRaw},
+      {"posAdcPulseIntRaw",  "List of positive raw ADC pulse integrals.",  THcSignalTable::kPulseIntRaw},
+      {"posAdcPulseAmpRaw",  "List of positive raw ADC pulse amplitudes.", THcSignalTable::kPulseAmpRaw},
+      {"posAdcPulseTimeRaw", "List of positive raw ADC pulse times.",      THcSignalTable::kPulseTimeRaw},
+
+      {"posAdcPed",          "List of positive ADC pedestals",             THcSignalTable::kPed},
+      {"posAdcPulseInt",     "List of positive ADC pulse integrals.",      THcSignalTable::kPulseInt},
+      {"posAdcPulseAmp",     "List of positive ADC pulse amplitudes.",     THcSignalTable::kPulseAmp},
+      {"posAdcPulseTime",    "List of positive ADC pulse times.",          THcSignalTable::kPulseTime},
       { 0 }
     };
-    DefineVarsFromList( vars, mode);
+    frPosAdc->DefineVariables(mode, GetPrefix(), posvars);
+
+    THcSignalTable::SignalVar_t negvars[] = {
+      {"negAdcPedRaw",       "List of negative raw ADC pedestals",         THcSignalTable::kPedRaw},
+      {"negAdcPulseIntRaw",  "List of negative raw ADC pulse integrals.",  THcSignalTable::kPulseIntRaw},
+      {"negAdcPulseAmpRaw",  "List of negative raw ADC pulse amplitudes.", THcSignalTable::kPulseAmpRaw},
+      {"negAdcPulseTimeRaw", "List of negative raw ADC pulse times.",      THcSignalTable::kPulseTimeRaw},
+
+      {"negAdcPed",          "List of negative ADC pedestals",             THcSignalTable::kPed},
+      {"negAdcPulseInt",     "List of negative ADC pulse integrals.",      THcSignalTable::kPulseInt},
+      {"negAdcPulseAmp",     "List of negative ADC pulse amplitudes.",     THcSignalTable::kPulseAmp},
+      {"negAdcPulseTime",    "List of negative ADC pulse times.",          THcSignalTable::kPulseTime},
+      { 0 }
+    };
+    frNegAdc->DefineVariables(mode, GetPrefix(), negvars);
   } //end debug statement
 
   // Register counters for efficiency calculations in gHcParms so that the
@@ -363,13 +328,20 @@ Int_t THcShowerPlane::DefineVariables( EMode mode )
        << Form("%sstat_hitsum%d",fParent->GetPrefix(),fLayerNum) << endl;
   //  getchar();
     
-  RVarDef vars[] = {
-    {"posAdcErrorFlag",    "List of positive raw ADC Error Flags",  "frPosAdcErrorFlag.THcSignalHit.GetData()"},
-    {"negAdcErrorFlag",    "List of negative raw ADC Error Flags ", "frNegAdcErrorFlag.THcSignalHit.GetData()"},
-
-    {"posAdcCounter",      "List of positive ADC counter numbers.", "frPosAdcPulseIntRaw.THcSignalHit.GetPaddleNumber()"}, //PreSh+ raw occupancy
-    {"negAdcCounter",      "List of negative ADC counter numbers.", "frNegAdcPulseIntRaw.THcSignalHit.GetPaddleNumber()"}, //PreSh- raw occupancy
+  THcSignalTable::SignalVar_t posvars[] = {
+    {"posAdcErrorFlag",    "List of positive raw ADC Error Flags",  THcSignalTable::kErrorFlag},
+    {"posAdcCounter",      "List of positive ADC counter numbers.", THcSignalTable::kPaddle}, //PreSh+ raw occupancy
+    { 0 }
+  };
+  frPosAdc->DefineVariables(mode, GetPrefix(), posvars);
+  THcSignalTable::SignalVar_t negvars[] = {
+    {"negAdcErrorFlag",    "List of negative raw ADC Error Flags ", THcSignalTable::kErrorFlag},
+    {"negAdcCounter",      "List of negative ADC counter numbers.", THcSignalTable::kPaddle}, //PreSh- raw occupancy
+    { 0 }
+  };
+  frNegAdc->DefineVariables(mode, GetPrefix(), negvars);
 
+  RVarDef vars[] = {
     {"totNumPosAdcHits", "Total Number of Positive ADC Hits",   "fTotNumPosAdcHits"}, // PreSh+ raw multiplicity
     {"totNumNegAdcHits", "Total Number of Negative ADC Hits",   "fTotNumNegAdcHits"}, // PreSh+ raw multiplicity
     {"totnumAdcHits",    "Total Number of ADC Hits Per PMT",    "fTotNumAdcHits"},    // PreSh raw multiplicity
@@ -416,29 +388,8 @@ void THcShowerPlane::Clear( Option_t* )
   fPosADCHits->Clear();
   fNegADCHits->Clear();
 
-  frPosAdcErrorFlag->Clear();
-  frPosAdcPedRaw->Clear();
-  frPosAdcThreshold->Clear();
-  frPosAdcPulseIntRaw->Clear();
-  frPosAdcPulseAmpRaw->Clear();
-  frPosAdcPulseTimeRaw->Clear();
-
-  frPosAdcPed->Clear();
-  frPosAdcPulseInt->Clear();
-  frPosAdcPulseAmp->Clear();
-  frPosAdcPulseTime->Clear();
-
-  frNegAdcErrorFlag->Clear();
-  frNegAdcPedRaw->Clear();
-  frNegAdcThreshold->Clear();
-  frNegAdcPulseIntRaw->Clear();
-  frNegAdcPulseAmpRaw->Clear();
-  frNegAdcPulseTimeRaw->Clear();
-
-  frNegAdcPed->Clear();
-  frNegAdcPulseInt->Clear();
-  frNegAdcPulseAmp->Clear();
-  frNegAdcPulseTime->Clear();
+  frPosAdc->Clear();
+  frNegAdc->Clear();
 
   for (UInt_t ielem = 0; ielem < fGoodPosAdcPed.size(); ielem++) {
     fGoodPosAdcPed.at(ielem)              = 0.0;
@@ -534,29 +485,8 @@ Int_t THcShowerPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
   fPosADCHits->Clear();
   fNegADCHits->Clear();
 
-  frPosAdcErrorFlag->Clear();
-  frPosAdcPedRaw->Clear();
-  frPosAdcThreshold->Clear();
-  frPosAdcPulseIntRaw->Clear();
-  frPosAdcPulseAmpRaw->Clear();
-  frPosAdcPulseTimeRaw->Clear();
-
-  frPosAdcPed->Clear();
-  frPosAdcPulseInt->Clear();
-  frPosAdcPulseAmp->Clear();
-  frPosAdcPulseTime->Clear();
-
-  frNegAdcErrorFlag->Clear();
-  frNegAdcPedRaw->Clear();
-  frNegAdcThreshold->Clear();
-  frNegAdcPulseIntRaw->Clear();
-  frNegAdcPulseAmpRaw->Clear();
-  frNegAdcPulseTimeRaw->Clear();
-
-  frNegAdcPed->Clear();
-  frNegAdcPulseInt->Clear();
-  frNegAdcPulseAmp->Clear();
-  frNegAdcPulseTime->Clear();
+  frPosAdc->Clear();
+  frNegAdc->Clear();
 
   /*
     for(Int_t i=0;i<fNelem;i++) {
@@ -571,9 +501,6 @@ Int_t THcShowerPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
   fEplane_pos = 0;
   fEplane_neg = 0;
 
-  UInt_t nrPosAdcHits = 0;
-  UInt_t nrNegAdcHits = 0;
-
   // Process raw hits. Get ADC hits for the plane, assign variables for each
   // channel.
 
@@ -594,50 +521,28 @@ Int_t THcShowerPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
 
     THcRawAdcHit& rawPosAdcHit = hit->GetRawAdcHitPos();
     for (UInt_t thit=0; thit<rawPosAdcHit.GetNPulses(); ++thit) {
-      ((THcSignalHit*) frPosAdcPedRaw->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPedRaw());
-      ((THcSignalHit*) frPosAdcThreshold->ConstructedAt(nrPosAdcHits))->Set(padnum,rawPosAdcHit.GetPedRaw()*rawPosAdcHit.GetF250_PeakPedestalRatio()+fAdcPosThreshold);
-      ((THcSignalHit*) frPosAdcPed->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPed());
-
-      ((THcSignalHit*) frPosAdcPulseIntRaw->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseIntRaw(thit));
-      ((THcSignalHit*) frPosAdcPulseInt->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseInt(thit));
-
-      ((THcSignalHit*) frPosAdcPulseAmpRaw->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseAmpRaw(thit));
-      ((THcSignalHit*) frPosAdcPulseAmp->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseAmp(thit));
-
-      ((THcSignalHit*) frPosAdcPulseTimeRaw->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseTimeRaw(thit));
-      ((THcSignalHit*) frPosAdcPulseTime->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseTime(thit)+fAdcTdcOffset);
+      Int_t row = frPosAdc->AddAdcPulse(padnum, rawPosAdcHit, thit, fAdcTdcOffset);
+      frPosAdc->Set(row, THcSignalTable::kThreshold, rawPosAdcHit.GetPedRaw()*rawPosAdcHit.GetF250_PeakPedestalRatio()+fAdcPosThreshold);
 
       if (rawPosAdcHit.GetPulseAmp(thit)>0&&rawPosAdcHit.GetPulseIntRaw(thit)>0) {
-	((THcSignalHit*) frPosAdcErrorFlag->ConstructedAt(nrPosAdcHits))->Set(padnum,0);
+	frPosAdc->Set(row, THcSignalTable::kErrorFlag, 0);
       } else {
-	((THcSignalHit*) frPosAdcErrorFlag->ConstructedAt(nrPosAdcHits))->Set(padnum,1);
+	frPosAdc->Set(row, THcSignalTable::kErrorFlag, 1);
       }
-      ++nrPosAdcHits;
       fTotNumAdcHits++;
       fTotNumPosAdcHits++;
 
     }
     THcRawAdcHit& rawNegAdcHit = hit->GetRawAdcHitNeg();
     for (UInt_t thit=0; thit<rawNegAdcHit.GetNPulses(); ++thit) {
-      ((THcSignalHit*) frNegAdcPedRaw->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPedRaw());
-      ((THcSignalHit*) frNegAdcThreshold->ConstructedAt(nrNegAdcHits))->Set(padnum,rawNegAdcHit.GetPedRaw()*rawNegAdcHit.GetF250_PeakPedestalRatio()+fAdcNegThreshold);
-      ((THcSignalHit*) frNegAdcPed->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPed());
-
-      ((THcSignalHit*) frNegAdcPulseIntRaw->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseIntRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseInt->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseInt(thit));
-
-      ((THcSignalHit*) frNegAdcPulseAmpRaw->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseAmpRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseAmp->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseAmp(thit));
-
-      ((THcSignalHit*) frNegAdcPulseTimeRaw->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseTimeRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseTime->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseTime(thit)+fAdcTdcOffset);
+      Int_t row = frNegAdc->AddAdcPulse(padnum, rawNegAdcHit, thit, fAdcTdcOffset);
+      frNegAdc->Set(row, THcSignalTable::kThreshold, rawNegAdcHit.GetPedRaw()*rawNegAdcHit.GetF250_PeakPedestalRatio()+fAdcNegThreshold);
 
       if (rawNegAdcHit.GetPulseAmp(thit)>0&&rawNegAdcHit.GetPulseIntRaw(thit)>0) {
-	((THcSignalHit*) frNegAdcErrorFlag->ConstructedAt(nrNegAdcHits))->Set(padnum,0);
+	frNegAdc->Set(row, THcSignalTable::kErrorFlag, 0);
       } else {
-	((THcSignalHit*) frNegAdcErrorFlag->ConstructedAt(nrNegAdcHits))->Set(padnum,1);
+	frNegAdc->Set(row, THcSignalTable::kErrorFlag, 1);
       }
-      ++nrNegAdcHits;
       fTotNumAdcHits++;
       fTotNumNegAdcHits++;
     }
@@ -715,9 +620,9 @@ void THcShowerPlane::FillADC_SampleIntegral()
 //_____________________________________________________________________________
 void THcShowerPlane::FillADC_Standard()
 {
-  for (Int_t ielem=0;ielem<frNegAdcPulseIntRaw->GetEntries();ielem++) {
-    Int_t npad = ((THcSignalHit*) frNegAdcPulseIntRaw->ConstructedAt(ielem))->GetPaddleNumber() - 1;
-    Double_t pulseIntRaw = ((THcSignalHit*) frNegAdcPulseIntRaw->ConstructedAt(ielem))->GetData();
+  for (Int_t ielem=0;ielem<frNegAdc->GetNRows();ielem++) {
+    Int_t npad = frNegAdc->GetPaddle(ielem) - 1;
+    Double_t pulseIntRaw = frNegAdc->Get(ielem, THcSignalTable::kPulseIntRaw);
     fGoodNegAdcPulseIntRaw.at(npad) = pulseIntRaw;
       if(fGoodNegAdcPulseIntRaw.at(npad) >  fNegThresh[npad]) {
 	fGoodNegAdcPulseInt.at(npad) = pulseIntRaw-fNegPed[npad];
@@ -726,9 +631,9 @@ void THcShowerPlane::FillADC_Standard()
 	fEplane_neg += fEneg.at(npad);
       }
   }
-  for (Int_t ielem=0;ielem<frPosAdcPulseIntRaw->GetEntries();ielem++) {
-    Int_t npad = ((THcSignalHit*) frPosAdcPulseIntRaw->ConstructedAt(ielem))->GetPaddleNumber() - 1;
-    Double_t pulseIntRaw = ((THcSignalHit*) frPosAdcPulseIntRaw->ConstructedAt(ielem))->GetData();
+  for (Int_t ielem=0;ielem<frPosAdc->GetNRows();ielem++) {
+    Int_t npad = frPosAdc->GetPaddle(ielem) - 1;
+    Double_t pulseIntRaw = frPosAdc->Get(ielem, THcSignalTable::kPulseIntRaw);
     fGoodPosAdcPulseIntRaw.at(npad) =pulseIntRaw;
     if(fGoodPosAdcPulseIntRaw.at(npad) > fPosThresh[npad]) {
       fGoodPosAdcPulseInt.at(npad) =pulseIntRaw-fPosPed[npad] ;
@@ -744,16 +649,16 @@ void THcShowerPlane::FillADC_DynamicPedestal()
 {
   Double_t StartTime = 0.0;
   if( fglHod ) StartTime = fglHod->GetStartTime();
-  for (Int_t ielem=0;ielem<frNegAdcPulseInt->GetEntries();ielem++) {
-   Int_t    npad         = ((THcSignalHit*) frNegAdcPulseInt->ConstructedAt(ielem))->GetPaddleNumber() - 1;
-   Double_t pulseInt     = ((THcSignalHit*) frNegAdcPulseInt->ConstructedAt(ielem))->GetData();
-    Double_t pulsePed     = ((THcSignalHit*) frNegAdcPed->ConstructedAt(ielem))->GetData();
-    Double_t pulseAmp     = ((THcSignalHit*) frNegAdcPulseAmp->ConstructedAt(ielem))->GetData();
-    Double_t pulseIntRaw  = ((THcSignalHit*) frNegAdcPulseIntRaw->ConstructedAt(ielem))->GetData();
-    Double_t pulseTime    = ((THcSignalHit*) frNegAdcPulseTime->ConstructedAt(ielem))->GetData();
+  for (Int_t ielem=0;ielem<frNegAdc->GetNRows();ielem++) {
+   Int_t    npad         = frNegAdc->GetPaddle(ielem) - 1;
+   Double_t pulseInt     = frNegAdc->Get(ielem, THcSignalTable::kPulseInt);
+    Double_t pulsePed     = frNegAdc->Get(ielem, THcSignalTable::kPed);
+    Double_t pulseAmp     = frNegAdc->Get(ielem, THcSignalTable::kPulseAmp);
+    Double_t pulseIntRaw  = frNegAdc->Get(ielem, THcSignalTable::kPulseIntRaw);
+    Double_t pulseTime    = frNegAdc->Get(ielem, THcSignalTable::kPulseTime);
     Double_t adctdcdiffTime = StartTime-pulseTime;
-    Double_t threshold    = ((THcSignalHit*) frNegAdcThreshold->ConstructedAt(ielem))->GetData();
-    Bool_t   errorflag    = ((THcSignalHit*) frNegAdcErrorFlag->ConstructedAt(ielem))->GetData();
+    Double_t threshold    = frNegAdc->Get(ielem, THcSignalTable::kThreshold);
+    Bool_t   errorflag    = frNegAdc->Get(ielem, THcSignalTable::kErrorFlag);
     Bool_t   pulseTimeCut = (adctdcdiffTime > static_cast<THcShower*>(fParent)->GetWindowMin(npad,fLayerNum-1,1)) && (adctdcdiffTime < static_cast<THcShower*>(fParent)->GetWindowMax(npad,fLayerNum-1,1) );
 
     
@@ -785,16 +690,16 @@ void THcShowerPlane::FillADC_DynamicPedestal()
     }
   }
   //
-  for (Int_t ielem=0;ielem<frPosAdcPulseInt->GetEntries();ielem++) {
-   Int_t    npad         = ((THcSignalHit*) frPosAdcPulseInt->ConstructedAt(ielem))->GetPaddleNumber() - 1;
-      Double_t pulsePed     = ((THcSignalHit*) frPosAdcPed->ConstructedAt(ielem))->GetData();
-    Double_t threshold    = ((THcSignalHit*) frPosAdcThreshold->ConstructedAt(ielem))->GetData();
-    Double_t pulseAmp     = ((THcSignalHit*) frPosAdcPulseAmp->ConstructedAt(ielem))->GetData();
-    Double_t pulseInt     = ((THcSignalHit*) frPosAdcPulseInt->ConstructedAt(ielem))->GetData();
-    Double_t pulseIntRaw  = ((THcSignalHit*) frPosAdcPulseIntRaw->ConstructedAt(ielem))->GetData();
-    Double_t pulseTime    = ((THcSignalHit*) frPosAdcPulseTime->ConstructedAt(ielem))->GetData();
+  for (Int_t ielem=0;ielem<frPosAdc->GetNRows();ielem++) {
+   Int_t    npad         = frPosAdc->GetPaddle(ielem) - 1;
+      Double_t pulsePed     = frPosAdc->Get(ielem, THcSignalTable::kPed);
+    Double_t threshold    = frPosAdc->Get(ielem, THcSignalTable::kThreshold);
+    Double_t pulseAmp     = frPosAdc->Get(ielem, THcSignalTable::kPulseAmp);
+    Double_t pulseInt     = frPosAdc->Get(ielem, THcSignalTable::kPulseInt);
+    Double_t pulseIntRaw  = frPosAdc->Get(ielem, THcSignalTable::kPulseIntRaw);
+    Double_t pulseTime    = frPosAdc->Get(ielem, THcSignalTable::kPulseTime);
      Double_t adctdcdiffTime = StartTime-pulseTime;
-   Bool_t   errorflag    = ((THcSignalHit*) frPosAdcErrorFlag->ConstructedAt(ielem))->GetData();
+   Bool_t   errorflag    = frPosAdc->Get(ielem, THcSignalTable::kErrorFlag);
    Bool_t   pulseTimeCut = (adctdcdiffTime > static_cast<THcShower*>(fParent)->GetWindowMin(npad,fLayerNum-1,0)) && (adctdcdiffTime < static_cast<THcShower*>(fParent)->GetWindowMax(npad,fLayerNum-1,0) );
 
 
@@ -25,6 +25,7 @@ using namespace std;
 class THaEvData;
 class THaSignalHit;
 class THcHodoscope;
+class THcSignalTable;
 
 class THcShowerPlane : public THaSubDetector {
 
@@ -202,29 +203,8 @@ protected:
   Float_t *fNegSig;
   Float_t *fNegThresh;
 
-  TClonesArray* frPosAdcErrorFlag;
-  TClonesArray* frPosAdcPedRaw;
-  TClonesArray* frPosAdcThreshold;
-  TClonesArray* frPosAdcPulseIntRaw;
-  TClonesArray* frPosAdcPulseAmpRaw;
-  TClonesArray* frPosAdcPulseTimeRaw;
-
-  TClonesArray* frPosAdcPed;
-  TClonesArray* frPosAdcPulseInt;
-  TClonesArray* frPosAdcPulseAmp;
-  TClonesArray* frPosAdcPulseTime;
-
-  TClonesArray* frNegAdcErrorFlag;
-  TClonesArray* frNegAdcPedRaw;
-  TClonesArray* frNegAdcThreshold;
-  TClonesArray* frNegAdcPulseIntRaw;
-  TClonesArray* frNegAdcPulseAmpRaw;
-  TClonesArray* frNegAdcPulseTimeRaw;
-
-  TClonesArray* frNegAdcPed;
-  TClonesArray* frNegAdcPulseInt;
-  TClonesArray* frNegAdcPulseAmp;
-  TClonesArray* frNegAdcPulseTime;
+  THcSignalTable* frPosAdc;   // Raw positive ADC pulses
+  THcSignalTable* frNegAdc;   // Raw negative ADC pulses
 
   virtual Int_t  ReadDatabase( const TDatime& date );
   virtual Int_t  DefineVariables( EMode mode = kDefine );
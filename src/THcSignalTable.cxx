@@ -0,0 +1,122 @@
+/** \class THcSignalTable
+    \ingroup DetSupport
+
+ Table of the raw ADC or TDC signals of a detector plane for one event.
+
+ Each row is one FADC pulse or TDC hit.  The paddle/PMT number of the row
+ and each quantity (pedestal, pulse integral, ...) are kept in separate
+ contiguous vectors, so filling a row is a handful of array stores and the
+ vectors can be exported directly as global variables.  Only the columns
+ selected at construction are filled.
+
+ Replaces one TClonesArray of THcSignalHit per quantity.
+*/
+
+#include "THcSignalTable.h"
+#include "THcRawAdcHit.h"
+#include "THcRawTdcHit.h"
+#include "THaGlobals.h"
+#include "THaVarList.h"
+#include "VarType.h"
+#include "TString.h"
+
+//_____________________________________________________________________________
+THcSignalTable::THcSignalTable(UInt_t signals, UInt_t capacity) :
+  fSignals(signals)
+{
+  fPaddle.reserve(capacity);
+  for(Int_t i=0;i<kNSignals;i++) {
+    if(HasSignal((ESignal)i)) fColumn[i].reserve(capacity);
+  }
+}
+
+//_____________________________________________________________________________
+THcSignalTable::~THcSignalTable()
+{
+}
+
+//_____________________________________________________________________________
+void THcSignalTable::Clear(Option_t*)
+{
+  // Remove all rows.  Keeps the allocated space for the next event.
+
+  fPaddle.clear();
+  for(Int_t i=0;i<kNSignals;i++) {
+    fColumn[i].clear();
+  }
+}
+
+//_____________________________________________________________________________
+Int_t THcSignalTable::AddRow(Int_t paddle)
+{
+  // Append a row for paddle with all values zero.  Returns the row number.
+
+  fPaddle.push_back(paddle);
+  for(Int_t i=0;i<kNSignals;i++) {
+    if(HasSignal((ESignal)i)) fColumn[i].push_back(0.0);
+  }
+  return fPaddle.size()-1;
+}
+
+//_____________________________________________________________________________
+Int_t THcSignalTable::AddAdcPulse(Int_t paddle, const THcRawAdcHit& hit,
+				  UInt_t ipulse, Double_t timeoffset)
+{
+  // Append pulse ipulse of hit.  Fills the pedestal, integral, amplitude
+  // and time columns; timeoffset is added to the pulse time.  Error flag
+  // and threshold are left for the caller, since detectors differ in how
+  // they define them.
+
+  Int_t row = AddRow(paddle);
+  if(HasSignal(kPedRaw))       fColumn[kPedRaw][row]       = hit.GetPedRaw();
+  if(HasSignal(kPed))          fColumn[kPed][row]          = hit.GetPed();
+  if(HasSignal(kPulseIntRaw))  fColumn[kPulseIntRaw][row]  = hit.GetPulseIntRaw(ipulse);
+  if(HasSignal(kPulseInt))     fColumn[kPulseInt][row]     = hit.GetPulseInt(ipulse);
+  if(HasSignal(kPulseAmpRaw))  fColumn[kPulseAmpRaw][row]  = hit.GetPulseAmpRaw(ipulse);
+  if(HasSignal(kPulseAmp))     fColumn[kPulseAmp][row]     = hit.GetPulseAmp(ipulse);
+  if(HasSignal(kPulseTimeRaw)) fColumn[kPulseTimeRaw][row] = hit.GetPulseTimeRaw(ipulse);
+  if(HasSignal(kPulseTime))    fColumn[kPulseTime][row]    = hit.GetPulseTime(ipulse)+timeoffset;
+  return row;
+}
+
+//_____________________________________________________________________________
+Int_t THcSignalTable::AddTdcHit(Int_t paddle, const THcRawTdcHit& hit,
+				UInt_t ihit)
+{
+  // Append hit ihit of a multihit TDC channel
+
+  Int_t row = AddRow(paddle);
+  if(HasSignal(kTimeRaw)) fColumn[kTimeRaw][row] = hit.GetTimeRaw(ihit);
+  if(HasSignal(kTime))    fColumn[kTime][row]    = hit.GetTime(ihit);
+  return row;
+}
+
+//_____________________________________________________________________________
+Int_t THcSignalTable::DefineVariables(THaAnalysisObject::EMode mode,
+				      const char* prefix,
+				      const SignalVar_t* list) const
+{
+  // Define (mode kDefine) or remove (kDelete) a global variable prefix+name
+  // for each column in list.  The variables point at the column vectors
+  // and so always have the current number of rows.
+
+  if(!gHaVars) return THaAnalysisObject::kInitError;
+
+  for(const SignalVar_t* item = list; item->name; item++) {
+    TString name = TString(prefix) + item->name;
+    if(mode == THaAnalysisObject::kDefine) {
+      if(item->signal == kPaddle) {
+	gHaVars->DefineByType(name.Data(), item->desc, &fPaddle, kIntV, 0,
+			      "THcSignalTable::DefineVariables");
+      } else {
+	gHaVars->DefineByType(name.Data(), item->desc, &fColumn[item->signal],
+			      kDoubleV, 0, "THcSignalTable::DefineVariables");
+      }
+    } else if(mode == THaAnalysisObject::kDelete) {
+      gHaVars->RemoveName(name.Data());
+    }
+  }
+  return THaAnalysisObject::kOK;
+}
+
+ClassImp(THcSignalTable)
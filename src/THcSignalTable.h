@@ -0,0 +1,75 @@
+#ifndef ROOT_THcSignalTable
+#define ROOT_THcSignalTable
+
+/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+// THcSignalTable                                                          //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+#include "TObject.h"
+#include "THaAnalysisObject.h"
+#include <vector>
+
+class THcRawAdcHit;
+class THcRawTdcHit;
+
+class THcSignalTable : public TObject {
+
+ public:
+  // Quantities a table can hold, one column each
+  enum ESignal { kPedRaw = 0, kPed, kPulseIntRaw, kPulseInt,
+		 kPulseAmpRaw, kPulseAmp, kPulseTimeRaw, kPulseTime,
+		 kErrorFlag, kThreshold, kTimeRaw, kTime, kNSignals };
+  // Column number used in SignalVar_t to export the paddle numbers
+  enum { kPaddle = -1 };
+
+  // Column sets for the usual FADC and TDC tables
+  static const UInt_t kAdcSignals =
+    (1<<kPedRaw) | (1<<kPed) | (1<<kPulseIntRaw) | (1<<kPulseInt) |
+    (1<<kPulseAmpRaw) | (1<<kPulseAmp) | (1<<kPulseTimeRaw) | (1<<kPulseTime) |
+    (1<<kErrorFlag);
+  static const UInt_t kTdcSignals = (1<<kTimeRaw) | (1<<kTime);
+
+  // Global variable for one column
+  struct SignalVar_t {
+    const char* name;
+    const char* desc;
+    Int_t       signal;		// ESignal or kPaddle
+  };
+
+  THcSignalTable(UInt_t signals=kAdcSignals, UInt_t capacity=16);
+  virtual ~THcSignalTable();
+
+  virtual void Clear(Option_t* opt="");
+
+  Int_t AddRow(Int_t paddle);
+  Int_t AddAdcPulse(Int_t paddle, const THcRawAdcHit& hit, UInt_t ipulse,
+		    Double_t timeoffset=0.0);
+  Int_t AddTdcHit(Int_t paddle, const THcRawTdcHit& hit, UInt_t ihit);
+
+  void Set(Int_t row, ESignal signal, Double_t value)
+  { fColumn[signal][row] = value; }
+
+  Int_t    GetNRows() const { return fPaddle.size(); }
+  Int_t    GetPaddle(Int_t row) const { return fPaddle[row]; }
+  Double_t Get(Int_t row, ESignal signal) const
+  { return fColumn[signal][row]; }
+  Bool_t   HasSignal(ESignal signal) const { return (fSignals>>signal) & 1; }
+
+  const std::vector<Int_t>&    GetPaddles() const { return fPaddle; }
+  const std::vector<Double_t>& GetColumn(ESignal signal) const
+  { return fColumn[signal]; }
+
+  Int_t DefineVariables(THaAnalysisObject::EMode mode, const char* prefix,
+			const SignalVar_t* list) const;
+
+ protected:
+  UInt_t                fSignals;	    // Bit mask of filled columns
+  std::vector<Int_t>    fPaddle;	    // Paddle/PMT number of each row
+  std::vector<Double_t> fColumn[kNSignals]; // One entry per row if filled
+
+  ClassDef(THcSignalTable,0); // Per-event columns of ADC/TDC signals
+};
+/////////////////////////////////////////////////////////////////
+#endif
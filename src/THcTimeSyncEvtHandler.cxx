@@ -20,6 +20,14 @@
     ...
     gHaEvtHandlers->Add(timesync);
 
+    To only write a corrected CODA file, the analyzer is not needed:
+
+    THcTimeSyncEvtHandler *timesync = new THcTimeSyncEvtHandler("timesync","ADC/TI Time synchrnoziation"));
+    timesync->SetBadROC(3);
+    timesync->FilterFile("coin_all_03302.dat", "coin_all_03302_fixed.dat", 4);
+
+    The last argument is the number of threads scanning events.
+
     Assumes that all FADCs are in banks with the tag 250 and all
     TIblob banks are tag 4.  And that these banks are contained
     without further structure in ROC banks.  Also asssumes that the
@@ -39,16 +47,24 @@ the next event comes.
 
 #include "THcTimeSyncEvtHandler.h"
 #include "THaEvData.h"
+#include "THcEvioBankIndex.h"
 #include "THaGlobals.h"
 #include "THcGlobals.h"
 #include "THcParmList.h"
 #include "THaCodaFile.h"
 #include "THaRunBase.h"
+#include "TDatime.h"
 #include <cstring>
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
+#if __cplusplus >= 201103L
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
 //#include "evio.h"
 
 using namespace std;
@@ -63,10 +79,13 @@ THcTimeSyncEvtHandler::THcTimeSyncEvtHandler(const char *name, const char* descr
   fBadSyncSizeTrigger = 450;
   fCodaOut = 0;
   fLastEventWasSync = kFALSE;
+  fScan.rocMask = 0;
+  fStatsRocMask = 0;
 }
 
 THcTimeSyncEvtHandler::~THcTimeSyncEvtHandler()
 {
+  delete fCodaOut;
 }
 
 //Float_t THcTimeSyncEvtHandler::GetData(const std::string& tag)
@@ -94,61 +113,79 @@ Int_t THcTimeSyncEvtHandler::Analyze(THaEvData *evdata)
 
   if (fDebug) cout << "------------------\n  Time Syncronization Checker"<<endl;
 
-  Int_t evlen = evdata->GetEvLength();
-
   UInt_t *rdata = (UInt_t*) evdata->GetRawDataBuffer();
 
-  UInt_t *pslippedbank=0;
-
-  UInt_t *p = (UInt_t*) rdata;
-  UInt_t *plast = p+*p;		// Index to last word in the bank
-  Int_t roc = -1;
-  Bool_t issyncevent=kFALSE;
+  ScanEvent(rdata, fBankIndex, fScan);
+  return ProcessEvent(rdata, evdata->GetEvNum(), fScan);
+}
 
-  CrateTimeMap.clear();
+void THcTimeSyncEvtHandler::ScanEvent(UInt_t *rdata, THcEvioBankIndex& index,
+				      EventScan_t& scan) const
+{
+  /** Collect the TI, FADC and 1190 times of one event and the location
+      of the 1190 banks in the bad ROC.  Does not modify the handler, so
+      it may be called for several events at once with separate index
+      and scan objects.  Debug output is kept in scan and printed by
+      ProcessEvent, so events do not interleave their output.
+  */
+  Int_t evlen = rdata[0]+1;
 
-  while(p<plast) {
-    Int_t banklen = *p;
-    p++;
+  UInt_t *p;
+  Int_t roc = -1;
+  RocTimes_t *roctimes=0;
+
+  scan.rocMask = 0;
+  scan.issyncevent = kFALSE;
+  scan.badRocTdcBanks.clear();
+  scan.debugFile.clear();
+  scan.debugOut.clear();
+  Bool_t debug = (fDebug || fDebugFile);
+  ostringstream dbgfile, dbgout;
+
+  index.Build(rdata);
+  for(Int_t ib=0; ib<index.GetNBanks(); ib++) {
+    const THcEvioBankIndex::Bank& bank = index.GetBank(ib);
+    Int_t banklen = bank.length;
     if (fDebugFile) {
-      *fDebugFile << "Bank: " << hex << *p << dec << " len: " << banklen << endl;
+      dbgfile << "Bank: " << hex << bank.header << dec << " len: " << banklen << endl;
     }
-    if((*p & 0xff00) == 0x1000) {	// Bank Containing banks
-      if(evlen-*(p-1) > 1) { // Don't use overall event header
-        roc = (*p>>16) & 0xf;
-	if(fDebug) cout << "ROC: " << roc << " " << evlen << " " << *(p-1) << hex << " " << *p << dec << endl;
-        CrateTimeMap[roc] = new RocTimes_t;
+    if(bank.kind == THcEvioBankIndex::kBankOfBanks) {	// Bank Containing banks
+      if(evlen-banklen > 1) { // Don't use overall event header
+        roc = bank.tag & 0xf;
+	if(fDebug) dbgout << "ROC: " << roc << " " << evlen << " " << banklen << hex << " " << bank.header << dec << endl;
+        roctimes = &scan.rocTimes[roc];
+        roctimes->Clear();
+        scan.rocMask |= (1U<<roc);
       }
-      p++;				// Now pointing to a bank in the bank
-    } else if (((*p & 0xff00) == 0x100) && (*p != 0xC0000100)) {
+    } else if (bank.kind == THcEvioBankIndex::kUInt32) {
       // Bank containing integers.
       // This is either ROC bank containing integers or
       // a bank within a ROC containing data from modules of a single type
       // Look for TI and FADC banks.
-      UInt_t tag = (*p>>16) & 0xffff;
-      UInt_t num = *p & 0xff;
-      UInt_t *pnext = p+banklen;	// Next bank
-      p++;			// First data word
-      if(tag==4) { // This is a TI blob banks
+      UInt_t tag = bank.tag;
+      UInt_t num = bank.num;
+      UInt_t *pnext = index.GetEnd(ib);	// Next bank
+      p = index.GetData(ib);		// First data word
+      if(tag==4 && roctimes) { // This is a TI blob banks
         // Actually second word is usually a filler
 	// This could be done in a safer way, but it works for now
         Int_t ifill = ((((*p)>>27)&0x1F) == 0x1F) ? 1 : 0;
         if(ifill) {
           p++; banklen--;  // Skip filler word
         }
-	CrateTimeMap[roc]->ti_evcount = p[3];
+	roctimes->ti_evcount = p[3];
         if(banklen>=5) {   // Need bank header, at least 2 TI  headers, the  trailer and 2 data words
           UInt_t titime = p[4];
-	  if(fDebug) cout << roc << ": TItime " << titime << endl;
-          CrateTimeMap[roc]->has_ti_ttime = kTRUE;
-          CrateTimeMap[roc]->ti_ttime = titime;
+	  if(fDebug) dbgout << roc << ": TItime " << titime << endl;
+          roctimes->has_ti_ttime = kTRUE;
+          roctimes->ti_ttime = titime;
         }
       } else if (tag==3801) {
 	if(fResync && num==1) {
-	  issyncevent = kTRUE;
+	  scan.issyncevent = kTRUE;
 	}
-      } else if (tag==250) { // This is an FADC bank
-	if(fDebug) cout << roc << ": FADC" << endl;
+      } else if (tag==250 && roctimes) { // This is an FADC bank
+	if(fDebug) dbgout << roc << ": FADC" << endl;
         // Walk through this bank looking for FADC headers.
         Int_t slot=-1;
         while(p<pnext) {
@@ -161,8 +198,11 @@ Int_t THcTimeSyncEvtHandler::Analyze(THaEvData *evdata)
 	  case 0x13:  // trigger time word
 	    {
 	      UInt_t fadctime = ((*p)&0xFFFFFF) + (((*(p+1))&0xFF)<<24);
-	      if(fDebug) cout << "    " << slot << ": " << fadctime << endl;
-	      CrateTimeMap[roc]->fadcTimesMap[slot] = fadctime;
+	      if(fDebug) dbgout << "    " << slot << ": " << fadctime << endl;
+	      if(slot >= 0) {
+		roctimes->fadcTimes[slot] = fadctime;
+		roctimes->fadcSlotMask |= (1U<<slot);
+	      }
 	      p += 2;
 	      break;
 	    }
@@ -172,45 +212,69 @@ Int_t THcTimeSyncEvtHandler::Analyze(THaEvData *evdata)
 	  }
 	}
       } else if (tag==1190) {	// Bank with CAEN 1190 TDCs
-	if(roc==fBadROC) {		// Point to slipped bank
-	  if(fSlippage) {
-	    pslippedbank = p-2;
-	    //	    cout << banklen << " " << pslippedbank[0] << endl;
-	    if(AllTdcsPresent(pslippedbank) && (banklen > fBadSyncSizeTrigger)) {
-	      cout << "Slippage detected at event " << evdata->GetEvNum() << " with size " << banklen << " but not corrected" << endl;
-	    }
-	  } else {
-	    if(AllTdcsPresent(p-2) && (banklen > fBadSyncSizeTrigger)) {
-	      cout << "Slippage enabled at event " << evdata->GetEvNum() << " with size " << banklen << endl;
-	      fSlippage = 1;
-	    }
-	  }
+	if(roc==fBadROC) {		// Slip checks are done in ProcessEvent
+	  scan.badRocTdcBanks.push_back(bank.offset);
 	}
-	if(fDebug) cout << roc << ": 1190" << endl;
+	if(fDebug) dbgout << roc << ": 1190" << endl;
 	// Walk through this bank looking for TDC headers
 	while(p<pnext) {
 	  if((*p & 0xf8000000) == 0x40000000) {
 	    Int_t slot= *p & 0x1f;
 	    Int_t evcount = (*p >> 5) & 0x3fffff;
-	    CrateTimeMap[roc]->ftdcEvCountMap[slot] = evcount;
+	    if(roctimes) {
+	      roctimes->tdcEvCount[slot] = evcount;
+	      roctimes->tdcSlotMask |= (1U<<slot);
+	    }
 	  }
 	  p++;
 	}
       }
-      p=pnext;    // Skip to next bank
+    }
+  }
+  if(debug) {
+    scan.debugFile = dbgfile.str();
+    scan.debugOut = dbgout.str();
+  }
+}
+
+Int_t THcTimeSyncEvtHandler::ProcessEvent(UInt_t *rdata, UInt_t evnum,
+					  const EventScan_t& scan)
+{
+  /** Apply a scanned event, in event order: slip detection on the bad
+      ROC, statistics, and writing of the (possibly corrected) event.
+  */
+  UInt_t *pslippedbank=0;
+  UInt_t *p;
+  Bool_t issyncevent=scan.issyncevent;
+
+  if(fDebugFile && !scan.debugFile.empty()) *fDebugFile << scan.debugFile;
+  if(!scan.debugOut.empty()) cout << scan.debugOut;
+
+  for(UInt_t ib=0; ib<scan.badRocTdcBanks.size(); ib++) {
+    UInt_t *pbank = rdata + scan.badRocTdcBanks[ib];
+    Int_t banklen = pbank[0];
+    if(fSlippage) {		// Point to slipped bank
+      pslippedbank = pbank;
+      //	    cout << banklen << " " << pslippedbank[0] << endl;
+      if(AllTdcsPresent(pslippedbank) && (banklen > fBadSyncSizeTrigger)) {
+	cout << "Slippage detected at event " << evnum << " with size " << banklen << " but not corrected" << endl;
+      }
     } else {
-      p = p+*(p-1);
+      if(AllTdcsPresent(pbank) && (banklen > fBadSyncSizeTrigger)) {
+	cout << "Slippage enabled at event " << evnum << " with size " << banklen << endl;
+	fSlippage = 1;
+      }
     }
   }
 
   if(fFirstTime) {
-    InitStats();
+    InitStats(scan);
     fLastEvent[0] = 0;
     fFirstTime = kFALSE;
     fDumpNew=2;
   }
   if(issyncevent) cout << "SYNC event" << endl;
-  AccumulateStats(fLastEventWasSync);
+  AccumulateStats(scan, fLastEventWasSync);
   fLastEventWasSync = issyncevent;
 
   if(!fCodaOut) return(1);
@@ -220,11 +284,11 @@ Int_t THcTimeSyncEvtHandler::Analyze(THaEvData *evdata)
       fWriteDelayed=kTRUE;
       //      cout << "Will write corrected event" << endl;
     } else {
-      cout << "Skipping event " << evdata->GetEvNum() << endl;
+      cout << "Skipping event " << evnum << endl;
     }
   } else {			// Not slipping yet, just copy event
     if(fCodaOut) {
-      fCodaOut->codaWrite(evdata->GetRawDataBuffer());
+      fCodaOut->codaWrite(rdata);
     }
   }    
 
@@ -244,42 +308,25 @@ Int_t THcTimeSyncEvtHandler::Analyze(THaEvData *evdata)
     // Find the 1190 bank.  Shift everything beyond that bank forward or
     // or back to make room for the 1190 bank from the current event.
     // Copy the current 1190 bank into fLastEvent.  Write the event.
-    p = fLastEvent;
-    plast = p+*p;
-    roc = -1;
+    UInt_t *plast = fLastEvent+fLastEvent[0];
     UInt_t *poverwrite=0;
-    Int_t replacementlen;
-    Int_t banklen;
-    UInt_t *rocbanklenp=0;
+    Int_t replacementlen=0;
+    Int_t banklen=0;
     UInt_t *roc3banklenp=0;
 
     //    cout << "Old Size: " << fLastEvent[0] << " " << pslippedbank[0] << " ";
-    while(p<plast) {
-      banklen = *p;
-      p++;
-      if((*p & 0xff00) == 0x1000) {	// Bank Containing banks
-	if((fLastEvent[0]+1)-*(p-1) > 1) { // Don't use overall event header
-	  roc = (*p>>16) & 0xf;
-	  rocbanklenp = p-1;	// Pointer to rocbank length
-	}
-      p++;				// Now pointing to a bank in the bank
-      } else if (((*p & 0xff00) == 0x100) && (*p != 0xC0000100)) {
-	// Bank containing integers.
-	// This is either ROC bank containing integers or
-	// a bank within a ROC containing data from modules of a single type
-	// Look for TI and FADC banks.
-	UInt_t tag = (*p>>16) & 0xffff;
-	UInt_t *pnext = p+banklen;	// Next bank
-	p++;			// First data word
-	if(tag==1190 && roc==fBadROC) { // The TDC bank we want to replace
-	  replacementlen=pslippedbank[0];
-	  roc3banklenp=rocbanklenp; // Save pointer to ROC bank header
-	  poverwrite=p-2;	// Where to write the slipped bank
-	  break;
-	}
-	p=pnext;
-      } else {
-	p=p+*(p-1);
+    fBankIndex.Build(fLastEvent);
+    for(Int_t ib=0; ib<fBankIndex.GetNBanks(); ib++) {
+      const THcEvioBankIndex::Bank& bank = fBankIndex.GetBank(ib);
+      // The TDC bank we want to replace
+      if(bank.kind == THcEvioBankIndex::kUInt32 && bank.tag==1190
+	 && bank.parent >= 0 && (bank.roc & 0xf)==fBadROC) {
+	banklen = bank.length;
+	replacementlen=pslippedbank[0];
+	// Save pointer to ROC bank header
+	roc3banklenp=fLastEvent+fBankIndex.GetBank(bank.parent).offset;
+	poverwrite=fLastEvent+bank.offset;	// Where to write the slipped bank
+	break;
       }
     }
     Int_t icopied=0;
@@ -325,8 +372,8 @@ Int_t THcTimeSyncEvtHandler::Analyze(THaEvData *evdata)
       //      cout << dec << endl;
       fCodaOut->codaWrite(fLastEvent);
       if(issyncevent) {		// If this was a sync event, write it out and stop rewriting
-	cout << "Run back in sync at event " << evdata->GetEvNum() << endl;
-	fCodaOut->codaWrite(evdata->GetRawDataBuffer());
+	cout << "Run back in sync at event " << evnum << endl;
+	fCodaOut->codaWrite(rdata);
 	fSlippage = 0;
 	fLastEvent[0] = 0;
 	fWriteDelayed = kFALSE;
@@ -334,119 +381,122 @@ Int_t THcTimeSyncEvtHandler::Analyze(THaEvData *evdata)
     }
   }
   if(fSlippage>0) {		// Just handle slippage of 1 now
-    for(UInt_t i=0;i<=rdata[0];i++) {
-      fLastEvent[i]=rdata[i];
+    if(rdata[0] < sizeof(fLastEvent)/sizeof(fLastEvent[0])) {
+      memcpy(fLastEvent, rdata, (rdata[0]+1)*sizeof(UInt_t));
+    } else {
+      cout << "Event " << evnum << " too large to cache" << endl;
     }
-    //    cout << "Cached event " << evdata->GetEvNum() << " " << fLastEvent[0] << endl;
+    //    cout << "Cached event " << evnum << " " << fLastEvent[0] << endl;
   }
 
   return 1;
 }
 
-void THcTimeSyncEvtHandler::InitStats() {
+void THcTimeSyncEvtHandler::InitStats(const EventScan_t& scan) {
   /** Initialize structure to hold statistics
       Record the offset of each TI and FADC time relative to the
       trigger time of the master TI.
   */
   // Assume the smallest ROC # is the TI master
   if(fMasterRoc < 0) {
-    fMasterRoc = CrateTimeMap.begin()->first;
+    for(Int_t roc=0;roc<kMaxRoc;roc++) {
+      if((scan.rocMask>>roc)&1) {
+	fMasterRoc = roc;
+	break;
+      }
+    }
   }
   if(fDebug) cout << "fMasterRoc " << fMasterRoc << endl;
-  UInt_t master_ttime = CrateTimeMap[fMasterRoc]->ti_ttime;
+  UInt_t master_ttime = (fMasterRoc >= 0) ? scan.rocTimes[fMasterRoc].ti_ttime : 0;
   if(fDebug) cout << "master_ttime " << master_ttime << endl;
 
-  CrateStatsMap.clear();
+  fStatsRocMask = scan.rocMask;
 
-  std::map<Int_t, struct RocTimes *>::iterator it = CrateTimeMap.begin();
-  while(it != CrateTimeMap.end()) {
-    Int_t roc = it->first;
-    struct RocTimes *roctimes = it->second;
-    it++;
-    CrateStatsMap[roc] = new RocStats_t;
-    CrateStatsMap[roc]->ti_ttime_offset = roctimes->ti_ttime - master_ttime;
-    if(roctimes->fadcTimesMap.size()>0) {
+  for(Int_t roc=0;roc<kMaxRoc;roc++) {
+    if(!((scan.rocMask>>roc)&1)) continue;
+    const RocTimes_t& roctimes = scan.rocTimes[roc];
+    RocStats_t& rocstats = fRocStats[roc];
+    rocstats.Clear();
+    rocstats.ti_ttime_offset = roctimes.ti_ttime - master_ttime;
+    if(roctimes.fadcSlotMask) {
       if(fDebug) cout << endl << " FADC";
-      std::map<Int_t, UInt_t>::iterator itt = roctimes->fadcTimesMap.begin();
       Bool_t use_expected_offset = kFALSE;
       Int_t expected_offset = 0;
       if(ExpectedOffsetMap.find(roc) != ExpectedOffsetMap.end()) {
 	expected_offset = ExpectedOffsetMap[roc];
 	use_expected_offset = kTRUE;
       }
-      while(itt != roctimes->fadcTimesMap.end()) {
-        Int_t slot = itt->first;
-        UInt_t fadctime = itt->second;
-        itt++;
+      rocstats.fadcSlotMask = roctimes.fadcSlotMask;
+      for(Int_t slot=0;slot<kMaxSlot;slot++) {
+	if(!((roctimes.fadcSlotMask>>slot)&1)) continue;
 	if(use_expected_offset) {
-	  CrateStatsMap[roc]->fadcOffsetMap[slot] = expected_offset;
+	  rocstats.fadcOffset[slot] = expected_offset;
 	} else {
-	  CrateStatsMap[roc]->fadcOffsetMap[slot] = fadctime - master_ttime;
+	  rocstats.fadcOffset[slot] = roctimes.fadcTimes[slot] - master_ttime;
 	}
-        CrateStatsMap[roc]->fadcEarlySlipCountMap[slot] = 0;
-        CrateStatsMap[roc]->fadcLateSlipCountMap[slot] = 0;
+	rocstats.fadcEarlySlipCount[slot] = 0;
+	rocstats.fadcLateSlipCount[slot] = 0;
       }
     }
-    if(roctimes->ftdcEvCountMap.size()>0) {
+    if(roctimes.tdcSlotMask) {
       if(fDebug) cout << endl << " 1190";
-      std::map<Int_t, UInt_t>::iterator itt = roctimes->ftdcEvCountMap.begin();
-      while(itt != roctimes->ftdcEvCountMap.end()) {
-        Int_t slot = itt->first;
-	itt++;
-	CrateStatsMap[roc]->ftdcEvCountWrongMap[slot] = 0;
+      rocstats.tdcSlotMask = roctimes.tdcSlotMask;
+      for(Int_t slot=0;slot<kMaxSlot;slot++) {
+	if(!((roctimes.tdcSlotMask>>slot)&1)) continue;
+	rocstats.tdcEvCountWrong[slot] = 0;
+	rocstats.tdcEvCountOffset[slot] = 1;
       }
     }
   }
 }
 
-void THcTimeSyncEvtHandler::AccumulateStats(Bool_t sync) {
+void THcTimeSyncEvtHandler::AccumulateStats(const EventScan_t& scan, Bool_t sync) {
+  /** Compare this event's times with the offsets recorded by InitStats.
+      ROCs and slots missing from the event count as time 0.
+  */
   fNEvents++;
   // Get trigger time from master CrateInfo
-  UInt_t master_ttime = CrateTimeMap[fMasterRoc]->ti_ttime;
-  std::map<Int_t, RocStats_t *>::iterator it = CrateStatsMap.begin();
-  while(it != CrateStatsMap.end()) {
-    Int_t roc = it->first;
-    RocStats* rocstats = it->second;
-    it++;
-    if(CrateTimeMap[roc]->ti_ttime < master_ttime + rocstats->ti_ttime_offset) {
-      rocstats->ti_earlyslipcount++;
-    } else if(CrateTimeMap[roc]->ti_ttime > master_ttime + rocstats->ti_ttime_offset) {
-      rocstats->ti_lateslipcount++;
+  UInt_t master_ttime = 0;
+  if(fMasterRoc >= 0 && ((scan.rocMask>>fMasterRoc)&1)) {
+    master_ttime = scan.rocTimes[fMasterRoc].ti_ttime;
+  }
+  for(Int_t roc=0;roc<kMaxRoc;roc++) {
+    if(!((fStatsRocMask>>roc)&1)) continue;
+    RocStats_t& rocstats = fRocStats[roc];
+    Bool_t present = (scan.rocMask>>roc)&1;
+    const RocTimes_t& roctimes = scan.rocTimes[roc];
+    UInt_t ti_ttime = present ? roctimes.ti_ttime : 0;
+    if(ti_ttime < master_ttime + rocstats.ti_ttime_offset) {
+      rocstats.ti_earlyslipcount++;
+    } else if(ti_ttime > master_ttime + rocstats.ti_ttime_offset) {
+      rocstats.ti_lateslipcount++;
     }
-    if(rocstats->fadcOffsetMap.size()>0) {
-      std::map<Int_t, Int_t>::iterator itt = rocstats->fadcOffsetMap.begin();
-      while(itt != rocstats->fadcOffsetMap.end()) {
-        Int_t slot = itt->first;
-        Int_t fadcoffset = itt->second;
-        itt++;
-        if(CrateTimeMap[roc]->fadcTimesMap[slot] < master_ttime+fadcoffset) {
-          rocstats->fadcEarlySlipCountMap[slot]++;
-	} else if(CrateTimeMap[roc]->fadcTimesMap[slot] > master_ttime+fadcoffset) {
-	  rocstats->fadcLateSlipCountMap[slot]++;
-        }
+    for(Int_t slot=0;slot<kMaxSlot && (rocstats.fadcSlotMask>>slot);slot++) {
+      if(!((rocstats.fadcSlotMask>>slot)&1)) continue;
+      Int_t fadcoffset = rocstats.fadcOffset[slot];
+      UInt_t fadctime = present ? roctimes.GetFadcTime(slot) : 0;
+      if(fadctime < master_ttime+fadcoffset) {
+	rocstats.fadcEarlySlipCount[slot]++;
+      } else if(fadctime > master_ttime+fadcoffset) {
+	rocstats.fadcLateSlipCount[slot]++;
       }
     }
-    if(rocstats->ftdcEvCountWrongMap.size()>0) {
-      std::map<Int_t, Int_t>::iterator itt = rocstats->ftdcEvCountWrongMap.begin();
-      while(itt != rocstats->ftdcEvCountWrongMap.end()) {
-	Int_t slot = itt->first;
-	itt++;
-	if(rocstats->ftdcEvCountOffsetMap.find(slot)==rocstats->ftdcEvCountOffsetMap.end()) {
-	  rocstats->ftdcEvCountOffsetMap[slot] = 1;
-	}
-	Int_t cdiff = (CrateTimeMap[roc]->ti_evcount & 0x3fffff) -
-	  ((CrateTimeMap[roc]->ftdcEvCountMap[slot]+rocstats->ftdcEvCountOffsetMap[slot])&0x3fffff);
-	if(sync) { // Need to do this check on the event after the sync event too
-	  if(cdiff>2) {
-	    cout << "ROC/Slot " << roc << "/" << slot << " count diff correction " << cdiff << endl;
-	    rocstats->ftdcEvCountOffsetMap[slot] += cdiff;
-	    cdiff = 0;
-	  }
-	}
-	if(cdiff != 0) {
-	  rocstats->ftdcEvCountWrongMap[slot]++;
+    UInt_t ti_evcount = present ? roctimes.ti_evcount : 0;
+    for(Int_t slot=0;slot<kMaxSlot && (rocstats.tdcSlotMask>>slot);slot++) {
+      if(!((rocstats.tdcSlotMask>>slot)&1)) continue;
+      UInt_t tdcevcount = present ? roctimes.GetTdcEvCount(slot) : 0;
+      Int_t cdiff = (ti_evcount & 0x3fffff) -
+	((tdcevcount+rocstats.tdcEvCountOffset[slot])&0x3fffff);
+      if(sync) { // Need to do this check on the event after the sync event too
+	if(cdiff>2) {
+	  cout << "ROC/Slot " << roc << "/" << slot << " count diff correction " << cdiff << endl;
+	  rocstats.tdcEvCountOffset[slot] += cdiff;
+	  cdiff = 0;
 	}
       }
+      if(cdiff != 0) {
+	rocstats.tdcEvCountWrong[slot]++;
+      }
     }
   }
 }
@@ -459,33 +509,25 @@ void THcTimeSyncEvtHandler::PrintStats()
   cout << "------ TI and FADC250 trigger time synchronization statitics ------" << endl;
   cout << "-------------------------------------------------------------------" << endl;
   cout << "      " << fNEvents << " events analyzed" << endl;
-  // Dump the map to see if we did it right.
-  std::map<Int_t, RocStats_t *>::iterator it = CrateStatsMap.begin();
-  while(it != CrateStatsMap.end()) {
-    Int_t roc = it->first;
-    struct RocStats *rocstats = it->second;
-    it++;
-    cout << "ROC " << roc << "  TI Offset " << rocstats->ti_ttime_offset << "  Slips " << rocstats->ti_earlyslipcount << "   " << rocstats->ti_lateslipcount << endl;
-    std::map<Int_t, Int_t>::iterator itt = rocstats->fadcEarlySlipCountMap.begin();
-    while(itt != rocstats->fadcEarlySlipCountMap.end()) {
-      Int_t slot = itt->first;
-      Int_t earlyslips = itt->second;
-      Int_t lateslips = rocstats->fadcLateSlipCountMap[slot];
-      itt++;
+  for(Int_t roc=0;roc<kMaxRoc;roc++) {
+    if(!((fStatsRocMask>>roc)&1)) continue;
+    const RocStats_t& rocstats = fRocStats[roc];
+    cout << "ROC " << roc << "  TI Offset " << rocstats.ti_ttime_offset << "  Slips " << rocstats.ti_earlyslipcount << "   " << rocstats.ti_lateslipcount << endl;
+    for(Int_t slot=0;slot<kMaxSlot;slot++) {
+      if(!((rocstats.fadcSlotMask>>slot)&1)) continue;
+      Int_t earlyslips = rocstats.fadcEarlySlipCount[slot];
+      Int_t lateslips = rocstats.fadcLateSlipCount[slot];
       if(earlyslips+lateslips > 0) { // Only print slots with slippage
-	cout << "    " << slot << " " << rocstats->fadcOffsetMap[slot] << "    " << earlyslips << "    " << lateslips << endl;
+	cout << "    " << slot << " " << rocstats.fadcOffset[slot] << "    " << earlyslips << "    " << lateslips << endl;
       }
     }
-    std::map<Int_t, Int_t>::iterator itw = rocstats->ftdcEvCountWrongMap.begin();
-    while(itw != rocstats->ftdcEvCountWrongMap.end()) {
-      Int_t slot = itw->first;
-      Int_t wrongcount = itw->second;
-      itw++;
+    for(Int_t slot=0;slot<kMaxSlot;slot++) {
+      if(!((rocstats.tdcSlotMask>>slot)&1)) continue;
+      Int_t wrongcount = rocstats.tdcEvCountWrong[slot];
       if(wrongcount > 0) {
 	cout << "    " << slot << " " << wrongcount << endl;
       }
     }
-	
   }
   cout << "-------------------------------------------------------------------" << endl;
 }
@@ -516,7 +558,8 @@ THaAnalysisObject::EStatus THcTimeSyncEvtHandler::Init(const TDatime& date)
   fFirstTdcCheck = kTRUE;
   fMasterRoc = -1;
   fNEvents = 0;
-  CrateTimeMap.clear();
+  fScan.rocMask = 0;
+  fStatsRocMask = 0;
   fSlippage=0;
   fWriteDelayed=kFALSE;
   fLastEvent[0]=0;
@@ -537,8 +580,12 @@ Int_t THcTimeSyncEvtHandler::End( THaRunBase* r) {
 }
 
 Int_t THcTimeSyncEvtHandler::SetRewriteFile(const char *filename) {
-  if(filename==0 || strlen(filename)==0) {
+  if(fCodaOut) {		// Close and drop the previous output file
+    fCodaOut->codaClose();
+    delete fCodaOut;
     fCodaOut = 0;
+  }
+  if(filename==0 || strlen(filename)==0) {
     cout << "THcTimeSyncEvtHandler sync filtering disabled" << endl;
   } else {
     TString ts=filename;
@@ -599,5 +646,166 @@ Int_t THcTimeSyncEvtHandler::AllTdcsPresent(UInt_t *bank) {
     }
   }
 }
-  
+
+Int_t THcTimeSyncEvtHandler::FilterFile(const char *infile, const char *outfile,
+					Int_t nthreads)
+{
+  /**
+     Rewrite a CODA file without running the analyzer.  Every event of
+     infile is passed through the same code as Analyze and written to
+     outfile, so the output is identical to that of a replay with
+     SetRewriteFile(outfile).
+
+     With nthreads > 1, a reader thread fills a ring of event buffers,
+     nthreads worker threads scan them (ScanEvent) and the calling
+     thread applies them in order (ProcessEvent), which does the slip
+     detection, the bank patching and the writing.  The slip state
+     carries from one event to the next, so only the scan runs in
+     parallel.
+
+     The event type and number are taken from the CODA 2 event header
+     and event ID bank.  Returns the number of events read, or a negative
+     value if a file can not be opened.
+  */
+  THaCodaFile codain;
+  if( codain.codaOpen(infile, "r", 1) ) {
+    Error(Here("FilterFile"),"Cannot open CODA file %s for reading.",infile);
+    return -1;
+  }
+  if( outfile==0 || strlen(outfile)==0 ) {
+    Error(Here("FilterFile"),"No output file given.");
+    codain.codaClose();
+    return -2;
+  }
+  Int_t status = SetRewriteFile(outfile);
+  if( status != 0 ) {
+    codain.codaClose();
+    return status;
+  }
+  Init(TDatime());
+
+  Int_t nevents = 0;
+#if __cplusplus < 201103L
+  if(nthreads > 1) {
+    Warning(Here("FilterFile"),"Built without C++11 threads, "
+	    "scanning with one thread instead of %d.",nthreads);
+  }
+#else
+  if(nthreads > 1) {
+    // Ring of event slots.  A slot goes kFree -> kRead (reader) ->
+    // kScanned (worker) -> kFree (writer, after ProcessEvent).
+    enum { kFree, kRead, kScanning, kScanned };
+    struct Slot {
+      std::vector<UInt_t> buf;
+      Int_t evtype;
+      UInt_t evnum;
+      Int_t state;
+      EventScan_t scan;
+    };
+    const Int_t nslots = 4*nthreads;
+    std::vector<Slot> slots(nslots);
+    for(Int_t i=0;i<nslots;i++) slots[i].state = kFree;
+    std::mutex mtx;
+    std::condition_variable slotfree, slotread, slotscanned;
+    Int_t nread = 0;		// Events read so far
+    Int_t nextscan = 0;		// Next event for a worker
+    Bool_t eof = kFALSE;
+
+    std::thread reader([&]() {
+      while( codain.codaRead() == CODA_OK ) {
+	UInt_t *evbuffer = codain.getEvBuffer();
+	Slot& slot = slots[nread%nslots];
+	{
+	  std::unique_lock<std::mutex> lock(mtx);
+	  slotfree.wait(lock, [&]{ return slot.state == kFree; });
+	}
+	slot.buf.assign(evbuffer, evbuffer+evbuffer[0]+1);
+	slot.evtype = evbuffer[1]>>16;
+	slot.evnum = (evbuffer[0]>=4 && evbuffer[3]==0xC0000100) ? evbuffer[4] : 0;
+	{
+	  std::lock_guard<std::mutex> lock(mtx);
+	  slot.state = kRead;
+	  nread++;
+	}
+	slotread.notify_all();
+      }
+      {
+	std::lock_guard<std::mutex> lock(mtx);
+	eof = kTRUE;
+      }
+      slotread.notify_all();
+      slotscanned.notify_all();
+    });
+
+    std::vector<std::thread> workers;
+    for(Int_t it=0;it<nthreads;it++) {
+      workers.push_back(std::thread([&]() {
+	THcEvioBankIndex index;
+	for(;;) {
+	  Int_t iev;
+	  {
+	    std::unique_lock<std::mutex> lock(mtx);
+	    slotread.wait(lock, [&]{ return nextscan < nread || eof; });
+	    if(nextscan >= nread) break;
+	    iev = nextscan++;
+	    slots[iev%nslots].state = kScanning;
+	  }
+	  Slot& slot = slots[iev%nslots];
+	  if(IsMyEvent(slot.evtype)) {
+	    ScanEvent(&slot.buf[0], index, slot.scan);
+	  }
+	  {
+	    std::lock_guard<std::mutex> lock(mtx);
+	    slot.state = kScanned;
+	  }
+	  slotscanned.notify_all();
+	}
+      }));
+    }
+
+    // Writer: apply the events in the order they were read
+    for(;;) {
+      Slot& slot = slots[nevents%nslots];
+      {
+	std::unique_lock<std::mutex> lock(mtx);
+	slotscanned.wait(lock, [&]{ return slot.state == kScanned ||
+	      (eof && nevents >= nread); });
+	if(slot.state != kScanned) break;
+      }
+      if(IsMyEvent(slot.evtype)) {
+	ProcessEvent(&slot.buf[0], slot.evnum, slot.scan);
+      } else {
+	fCodaOut->codaWrite(&slot.buf[0]);
+      }
+      nevents++;
+      {
+	std::lock_guard<std::mutex> lock(mtx);
+	slot.state = kFree;
+      }
+      slotfree.notify_all();
+    }
+    reader.join();
+    for(UInt_t it=0;it<workers.size();it++) workers[it].join();
+  } else
+#endif
+  {
+    while( codain.codaRead() == CODA_OK ) {
+      UInt_t *evbuffer = codain.getEvBuffer();
+      Int_t evtype = evbuffer[1]>>16;
+      UInt_t evnum = (evbuffer[0]>=4 && evbuffer[3]==0xC0000100) ? evbuffer[4] : 0;
+      if(IsMyEvent(evtype)) {
+	ScanEvent(evbuffer, fBankIndex, fScan);
+	ProcessEvent(evbuffer, evnum, fScan);
+      } else {
+	fCodaOut->codaWrite(evbuffer);
+      }
+      nevents++;
+    }
+  }
+  codain.codaClose();
+  End();
+  cout << "THcTimeSyncEvtHandler filtered " << nevents << " events from " << infile << endl;
+  return nevents;
+}
+
 ClassImp(THcTimeSyncEvtHandler)
@@ -9,6 +9,7 @@
 
 #include "THaEvtTypeHandler.h"
 #include "Decoder.h"
+#include "THcEvioBankIndex.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -34,11 +35,10 @@ public:
   virtual void SetResync(Bool_t b) {fResync = b;}
   virtual void SetBadSyncSizeTrigger(Int_t sizetrigger) {fBadSyncSizeTrigger = sizetrigger;}
   virtual Int_t AllTdcsPresent(UInt_t *bank);
+  virtual Int_t FilterFile(const char *infile, const char *outfile,
+			   Int_t nthreads=1);
 private:
 
-  virtual void InitStats();
-  virtual void AccumulateStats(Bool_t sync);
-
   Bool_t fFirstTime;
   Int_t fMasterRoc; // ROC with the TI master
   Int_t fNEvents;   // Number of events analyzed
@@ -57,16 +57,28 @@ private:
   Decoder::THaCodaFile* fCodaOut; // The CODA output file
   Int_t handle;
 
+  // ROC numbers are the low 4 bits of the ROC bank tag and slots are 5 bit
+  // fields, so per-event and per-run data fit in fixed arrays indexed by
+  // ROC and slot.  Bit masks record which entries are in use.
+  enum { kMaxRoc = 16, kMaxSlot = 32 };
+
   typedef struct RocTimes {
     Bool_t has_ti_ttime;
     UInt_t ti_ttime;
     UInt_t ti_evcount;
-    std::map<Int_t, UInt_t> fadcTimesMap;
-    std::map<Int_t, UInt_t> ftdcEvCountMap;
-    RocTimes() : has_ti_ttime(kFALSE) {
-      fadcTimesMap.clear();
-      ftdcEvCountMap.clear();
+    UInt_t fadcSlotMask;	// Slots with an FADC trigger time
+    UInt_t tdcSlotMask;		// Slots with a 1190 header
+    UInt_t fadcTimes[kMaxSlot];
+    UInt_t tdcEvCount[kMaxSlot];
+    void Clear() {
+      has_ti_ttime = kFALSE; ti_ttime = 0; ti_evcount = 0;
+      fadcSlotMask = 0; tdcSlotMask = 0;
     }
+    // Values for slots that were not seen this event read as 0
+    UInt_t GetFadcTime(Int_t slot) const
+    { return ((fadcSlotMask>>slot)&1) ? fadcTimes[slot] : 0; }
+    UInt_t GetTdcEvCount(Int_t slot) const
+    { return ((tdcSlotMask>>slot)&1) ? tdcEvCount[slot] : 0; }
   } RocTimes_t;
 
   typedef struct RocStats {
@@ -74,24 +86,41 @@ private:
     Int_t ti_earlyslipcount;
     Int_t ti_lateslipcount;
     Int_t fadc_expected_offset;
-    std::map<Int_t, Int_t> fadcOffsetMap;
-    std::map<Int_t, Int_t> fadcEarlySlipCountMap;
-    std::map<Int_t, Int_t> fadcLateSlipCountMap;
-    std::map<Int_t, Int_t> ftdcEvCountWrongMap;
-    std::map<Int_t, Int_t> ftdcEvCountOffsetMap;
-    RocStats() : ti_ttime_offset(0), ti_earlyslipcount(0), ti_lateslipcount(0),
-      fadc_expected_offset(0)
-    {
-      fadcOffsetMap.clear();
-      fadcEarlySlipCountMap.clear();
-      fadcLateSlipCountMap.clear();
-      ftdcEvCountWrongMap.clear();
-      ftdcEvCountOffsetMap.clear();
+    UInt_t fadcSlotMask;	// Slots with FADC statistics
+    UInt_t tdcSlotMask;		// Slots with 1190 statistics
+    Int_t fadcOffset[kMaxSlot];
+    Int_t fadcEarlySlipCount[kMaxSlot];
+    Int_t fadcLateSlipCount[kMaxSlot];
+    Int_t tdcEvCountWrong[kMaxSlot];
+    Int_t tdcEvCountOffset[kMaxSlot];
+    void Clear() {
+      ti_ttime_offset = 0; ti_earlyslipcount = 0; ti_lateslipcount = 0;
+      fadc_expected_offset = 0; fadcSlotMask = 0; tdcSlotMask = 0;
     }
   } RocStats_t;
 
-  std::map<Int_t, RocTimes_t *> CrateTimeMap;
-  std::map<Int_t, RocStats_t *> CrateStatsMap;
+  // What ScanEvent extracts from one event.  Filling it only reads the
+  // event buffer and the configuration, so events can be scanned in
+  // parallel; ProcessEvent then applies them in order.
+  typedef struct EventScan {
+    RocTimes_t rocTimes[kMaxRoc];	// Times seen in the event
+    UInt_t rocMask;		// ROCs seen in the event
+    Bool_t issyncevent;
+    std::vector<UInt_t> badRocTdcBanks;	// Offsets of fBadROC 1190 banks
+    std::string debugFile;	// Debug output for fDebugFile
+    std::string debugOut;	// Debug output for cout
+  } EventScan_t;
+
+  void ScanEvent(UInt_t *rdata, THcEvioBankIndex& index,
+		 EventScan_t& scan) const;
+  Int_t ProcessEvent(UInt_t *rdata, UInt_t evnum, const EventScan_t& scan);
+  void InitStats(const EventScan_t& scan);
+  void AccumulateStats(const EventScan_t& scan, Bool_t sync);
+
+  THcEvioBankIndex fBankIndex;	// Bank index of the current event
+  EventScan_t fScan;		// Scan of the current event
+  RocStats_t fRocStats[kMaxRoc];	// Run statistics
+  UInt_t fStatsRocMask;		// ROCs with statistics
   std::map<Int_t, Int_t> ExpectedOffsetMap;
 
   THcTimeSyncEvtHandler(const THcTimeSyncEvtHandler& fh);
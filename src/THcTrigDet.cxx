@@ -250,7 +250,7 @@ Int_t THcTrigDet::Decode(const THaEvData& evData) {
 
     Int_t cnt = hit->fCounter-1;
     if (hit->fPlane == 1) {
-      THcRawAdcHit rawAdcHit = hit->GetRawAdcHit();
+      const THcRawAdcHit& rawAdcHit = hit->GetRawAdcHit();
       fAdcMultiplicity[cnt] = rawAdcHit.GetNPulses();
       UInt_t good_hit=999;
           for (UInt_t thit=0; thit<rawAdcHit.GetNPulses(); ++thit) {
@@ -271,7 +271,7 @@ Int_t THcTrigDet::Decode(const THaEvData& evData) {
 	 }
     }
     else if (hit->fPlane == 2) {
-      THcRawTdcHit rawTdcHit = hit->GetRawTdcHit();
+      const THcRawTdcHit& rawTdcHit = hit->GetRawTdcHit();
 
       UInt_t good_hit=999;
            for (UInt_t thit=0; thit<rawTdcHit.GetNHits(); ++thit) {
@@ -51,6 +51,14 @@ It supports rich data from flash 250 ADC modules.
 \throw std::out_of_range Tried to set wrong signal.
 */
 
+/**
+\fn void THcTrigRawHit::SetSampleArena(Int_t signal, std::vector<Int_t>* arena)
+\brief Sets the per-event storage for the waveform samples.
+\param[in] signal ADC.
+\param[in] arena Sample arena owned by the hit list.
+\throw std::out_of_range Tried to set wrong signal.
+*/
+
 /**
 \fn void THcTrigRawHit::SetDataTimePedestalPeak(
   Int_t signal, Int_t data, Int_t time, Int_t pedestal, Int_t peak)
@@ -202,6 +210,18 @@ void THcTrigRawHit::SetSample(Int_t signal, Int_t data) {
 }
 
 
+void THcTrigRawHit::SetSampleArena(Int_t signal, std::vector<Int_t>* arena) {
+  if (0 <= signal && signal < fNAdcSignals) {
+    fAdcHits[signal].SetSampleArena(arena);
+  }
+  else {
+    throw std::out_of_range(
+      "`THcTrigRawHit::SetSampleArena`: only signal `0` available!"
+    );
+  }
+}
+
+
 void THcTrigRawHit::SetDataTimePedestalPeak(
   Int_t signal, Int_t data, Int_t time, Int_t pedestal, Int_t peak
 ) {
@@ -308,11 +328,21 @@ THcRawAdcHit& THcTrigRawHit::GetRawAdcHit() {
 }
 
 
+const THcRawAdcHit& THcTrigRawHit::GetRawAdcHit() const {
+  return fAdcHits[0];
+}
+
+
 THcRawTdcHit& THcTrigRawHit::GetRawTdcHit() {
   return fTdcHits[0];
 }
 
 
+const THcRawTdcHit& THcTrigRawHit::GetRawTdcHit() const {
+  return fTdcHits[0];
+}
+
+
 void THcTrigRawHit::SetF250Params(Int_t NSA, Int_t NSB, Int_t NPED) {
   for (Int_t iAdcSig=0; iAdcSig<fNAdcSignals; ++iAdcSig) {
     fAdcHits[iAdcSig].SetF250Params(NSA, NSB, NPED);
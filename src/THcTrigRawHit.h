@@ -17,6 +17,7 @@ class THcTrigRawHit : public THcRawHit {
 
     void SetData(Int_t signal, Int_t data);
     void SetSample(Int_t signal, Int_t data);
+    void SetSampleArena(Int_t signal, std::vector<Int_t>* arena);
     void SetDataTimePedestalPeak(
       Int_t signal, Int_t data, Int_t time, Int_t pedestal, Int_t peak
     );
@@ -31,7 +32,9 @@ class THcTrigRawHit : public THcRawHit {
     Bool_t HasReference(Int_t signal);
 
     THcRawAdcHit& GetRawAdcHit();
+    const THcRawAdcHit& GetRawAdcHit() const;
     THcRawTdcHit& GetRawTdcHit();
+    const THcRawTdcHit& GetRawTdcHit() const;
 
     void SetF250Params(Int_t NSA, Int_t NSB, Int_t NPED);
 
@@ -43,6 +46,9 @@ class THcTrigRawHit : public THcRawHit {
     THcRawTdcHit fTdcHits[fNTdcSignals];
 
   private:
+    // Not implemented; pass raw hits by reference.
+    THcTrigRawHit(const THcTrigRawHit&);
+
     ClassDef(THcTrigRawHit, 0);
 };
 
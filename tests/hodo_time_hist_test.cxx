@@ -0,0 +1,88 @@
+// Check THcHodoTimeHist, the focal plane time histogram of THcHodoscope,
+// against a TH1F with the same binning on the same fills: bin numbers,
+// maximum bin, RMS and integral, including under/overflow and NaN times.
+// Also prints the time per event of both, as a microbenchmark.
+
+#include "THcHodoscope.h"
+#include "TH1.h"
+#include "TH1F.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TMath.h"
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+int main()
+{
+  TH1::AddDirectory(kFALSE);
+  const Int_t nbins = 400;
+  const Double_t xlow = 0., xup = 200.;
+  THcHodoTimeHist hist(nbins, xlow, xup);
+  TH1F th1("th1", "reference", nbins, xlow, xup);
+
+  TRandom3 rnd(1);
+  const Int_t nevents = 100000;
+  Int_t nbadbin = 0, nbadevent = 0;
+
+  for(Int_t iev=0;iev<nevents;iev++) {
+    hist.Reset();
+    th1.Reset();
+    Int_t ntimes = rnd.Integer(40);
+    for(Int_t i=0;i<ntimes;i++) {
+      Double_t x;
+      if(rnd.Rndm() < 0.1) {
+	x = rnd.Uniform(-50., 250.);	// Also under- and overflow
+      } else {
+	x = 30. + 0.5*rnd.Integer(20) + 0.25*rnd.Integer(3); // Bin edges, ties
+      }
+      if(rnd.Rndm() < 0.002) x = TMath::QuietNaN();
+      if(hist.FindBin(x) != th1.FindBin(x)) {
+	if(nbadbin++ < 10) {
+	  cout << "x = " << x << ": bin " << hist.FindBin(x) << " vs "
+	       << th1.FindBin(x) << endl;
+	}
+      }
+      hist.Fill(x);
+      th1.Fill(x);
+    }
+    Double_t rms = th1.GetRMS();
+    if(hist.GetMaximumBin() != th1.GetMaximumBin() ||
+       hist.Integral() != th1.Integral() ||
+       TMath::Abs(hist.GetRMS() - rms) > 1e-12*(1.+rms)) {
+      if(nbadevent++ < 10) {
+	cout << "event " << iev << ": max bin " << hist.GetMaximumBin()
+	     << " vs " << th1.GetMaximumBin() << ", integral "
+	     << hist.Integral() << " vs " << th1.Integral() << ", rms "
+	     << hist.GetRMS() << " vs " << rms << endl;
+      }
+    }
+  }
+  cout << "hodo_time_hist_test: " << nbadbin << " bins and " << nbadevent
+       << " of " << nevents << " events differ" << endl;
+
+  // Typical event: 20 times around the peak
+  const Int_t nbench = 100000, nfill = 20;
+  vector<Double_t> times(nbench*nfill);
+  for(UInt_t i=0;i<times.size();i++) times[i] = rnd.Gaus(40., 2.);
+  Double_t sum = 0.;
+  TStopwatch timer;
+  for(Int_t iev=0;iev<nbench;iev++) {
+    hist.Reset();
+    for(Int_t i=0;i<nfill;i++) hist.Fill(times[iev*nfill+i]);
+    sum += hist.GetMaximumBin() + hist.GetRMS() + hist.Integral();
+  }
+  Double_t tnew = timer.RealTime();
+  timer.Start();
+  for(Int_t iev=0;iev<nbench;iev++) {
+    th1.Reset();
+    for(Int_t i=0;i<nfill;i++) th1.Fill(times[iev*nfill+i]);
+    sum -= th1.GetMaximumBin() + th1.GetRMS() + th1.Integral();
+  }
+  Double_t tth1 = timer.RealTime();
+  cout << "THcHodoTimeHist " << 1e9*tnew/nbench << " ns/event, TH1F "
+       << 1e9*tth1/nbench << " ns/event (check " << sum << ")" << endl;
+
+  return (nbadbin == 0 && nbadevent == 0) ? 0 : 1;
+}
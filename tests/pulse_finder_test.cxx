@@ -0,0 +1,91 @@
+// Check THcFADC250PulseFinder on synthetic FADC250 windows: pedestal sum,
+// integral truncated at the window edges (NSB at the start, NSA at the
+// end), re-arming only after the signal falls below threshold, the NP
+// limit, and the leading edge time in units of 1/64 sample.
+
+#include "THcFADC250PulseFinder.h"
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+static Int_t nfail = 0;
+
+static void Check(const char* what, Int_t got, Int_t expected)
+{
+  if(got != expected) {
+    cout << what << ": " << got << ", expected " << expected << endl;
+    nfail++;
+  }
+}
+
+int main()
+{
+  const Int_t ped = 100;
+  const Int_t tet = 10;
+  THcFADC250PulseFinder finder(6, 3, 4);	// NSA, NSB, NPED
+
+  // Flat baseline: the pedestal is the raw sum of NPED samples, no pulse
+  vector<Int_t> flat(20, ped);
+  flat[2] = ped+3;
+  Check("flat npulses", finder.FindPulses(&flat[0], flat.size(), tet), 0);
+  Check("flat pedestal", finder.GetPedestal(), 4*ped+3);
+
+  // One pulse in the middle of the window.  The crossing is sample 10,
+  // the peak 300 at sample 11, half height 200 crossed at 10+50/150.
+  vector<Int_t> mid(30, ped);
+  mid[10] = 150; mid[11] = 300; mid[12] = 250; mid[13] = 180; mid[14] = 120;
+  Check("mid npulses", finder.FindPulses(&mid[0], mid.size(), tet), 1);
+  const THcFADC250PulseFinder::Pulse_t& p = finder.GetPulse(0);
+  Int_t sum = 0;
+  for(Int_t i=10-3;i<10+6;i++) sum += mid[i];
+  Check("mid integral", p.integral, sum);
+  Check("mid crossing", p.crossing, 10);
+  Check("mid peak", p.peak, 300);
+  Check("mid time", p.time, 64*10 + (64*50)/150);
+  Check("mid pedestal", finder.GetPedestal(), 4*ped);
+
+  // NSB truncated at the start of the window.  With NPED=1 the pulse can
+  // cross at sample 1, so only one sample before it is summed.
+  finder.SetParams(6, 3, 1);
+  vector<Int_t> early(20, ped);
+  early[1] = 200; early[2] = 400; early[3] = 200;
+  Check("early npulses", finder.FindPulses(&early[0], early.size(), tet), 1);
+  sum = 0;
+  for(Int_t i=0;i<1+6;i++) sum += early[i];
+  Check("early integral", finder.GetPulse(0).integral, sum);
+  Check("early time", finder.GetPulse(0).time, 64*1 + (64*50)/200);
+
+  // NSA truncated at the end of the window, peak on the last sample
+  finder.SetParams(6, 3, 4);
+  vector<Int_t> late(20, ped);
+  late[18] = 200; late[19] = 260;
+  Check("late npulses", finder.FindPulses(&late[0], late.size(), tet), 1);
+  sum = 0;
+  for(Int_t i=18-3;i<20;i++) sum += late[i];
+  Check("late integral", finder.GetPulse(0).integral, sum);
+  Check("late peak", finder.GetPulse(0).peak, 260);
+  Check("late time", finder.GetPulse(0).time, 64*17 + (64*80)/100);
+
+  // Re-arming.  The first pulse stays above threshold past the end of its
+  // NSA window, so no new pulse starts there; the second one only starts
+  // after the signal dropped back to the baseline.
+  vector<Int_t> two(40, ped);
+  for(Int_t i=5;i<15;i++) two[i] = 200;
+  two[20] = 200; two[21] = 300;
+  Check("rearm npulses", finder.FindPulses(&two[0], two.size(), tet), 2);
+  Check("rearm crossing 1", finder.GetPulse(0).crossing, 5);
+  Check("rearm crossing 2", finder.GetPulse(1).crossing, 20);
+
+  // NP limits the number of pulses reported
+  finder.SetParams(6, 3, 4, 1);
+  Check("np npulses", finder.FindPulses(&two[0], two.size(), tet), 1);
+
+  // Unknown parameters (-1 from the configuration event) find nothing;
+  // THcHitList keeps the firmware pulses in that case
+  finder.SetParams(-1, -1, -1, 4);
+  Check("unknown npulses", finder.FindPulses(&mid[0], mid.size(), tet), 0);
+
+  cout << "pulse_finder_test: " << nfail << " checks failed" << endl;
+  return nfail ? 1 : 0;
+}
@@ -0,0 +1,142 @@
+// Regression test of the left/right stub fit in THcDriftChamber.
+// THcDriftChamber::FindStub works on per space point tables of the hit
+// fit terms.  Check that it gives the same stub and chi2, bit for bit,
+// as the previous fit done with TVectorD/TMatrixD from the hit positions
+// and distances, and that the early exit on chi2 does not change which
+// left/right combination has the minimum chi2.
+
+#include "THcDriftChamber.h"
+#include "TVectorD.h"
+#include "TMatrixD.h"
+#include "TRandom3.h"
+#include "TMath.h"
+#include <iostream>
+
+using namespace std;
+
+// Gives access to the protected fit kernel
+class StubFitter : public THcDriftChamber {
+public:
+  using THcDriftChamber::FindStub;
+};
+
+const Int_t kNPlanes = 6;
+
+// The fit as it was done before the kernel
+Double_t OldFindStub(Int_t nhits, const Double_t* pos, const Double_t* dist,
+		     const Int_t* plane_list, const Double_t* psi0,
+		     const Double_t* sigma, Double_t coefs[][3],
+		     const TMatrixD& aa3inv, const Int_t* plusminus,
+		     Double_t* stub)
+{
+  Double_t zeros[] = {0.0,0.0,0.0};
+  TVectorD TT; TT.Use(3, zeros);
+  Double_t dpos[kNPlanes];
+  for(Int_t ihit=0;ihit<nhits; ihit++) {
+    dpos[ihit] = pos[ihit] + plusminus[ihit]*dist[ihit]
+      - psi0[plane_list[ihit]];
+    for(Int_t index=0;index<3;index++) {
+      TT[index]+= dpos[ihit]*coefs[plane_list[ihit]][index]
+	/sigma[plane_list[ihit]];
+    }
+  }
+  TT *= aa3inv;
+  stub[0] = TT[0];
+  stub[1] = TT[1];
+  stub[2] = TT[2];
+  stub[3] = 0.0;
+  Double_t chi2=0.0;
+  for(Int_t ihit=0;ihit<nhits; ihit++) {
+    chi2 += pow( dpos[ihit]/sigma[plane_list[ihit]]
+		 - coefs[plane_list[ihit]][0]*stub[0]
+		 - coefs[plane_list[ihit]][1]*stub[1]
+		 - coefs[plane_list[ihit]][2]*stub[2]
+		 , 2);
+  }
+  return chi2;
+}
+
+int main()
+{
+  TRandom3 rnd(1);
+  Int_t nbadfit = 0, nbadsel = 0;
+  const Int_t ntrials = 20000;
+
+  for(Int_t itrial=0;itrial<ntrials;itrial++) {
+    Double_t psi0[kNPlanes], sigma[kNPlanes], coefs[kNPlanes][3];
+    for(Int_t ip=0;ip<kNPlanes;ip++) {
+      sigma[ip] = 0.02 + 0.01*rnd.Rndm();
+      psi0[ip] = rnd.Uniform(-1,1);
+      for(Int_t k=0;k<3;k++) coefs[ip][k] = rnd.Uniform(-50,50);
+    }
+    TMatrixD aa3inv(3,3);
+    for(Int_t i=0;i<3;i++)
+      for(Int_t j=0;j<3;j++) aa3inv(i,j) = rnd.Uniform(-1e-3,1e-3);
+
+    Int_t nhits = 4 + itrial%3;
+    Double_t pos[kNPlanes], dist[kNPlanes];
+    Int_t plane_list[kNPlanes];
+    for(Int_t ihit=0;ihit<nhits;ihit++) {
+      pos[ihit] = rnd.Uniform(-50,50);
+      dist[ihit] = rnd.Uniform(0,0.5);
+      plane_list[ihit] = ihit;
+    }
+
+    // The tables LeftRight sets up once per space point
+    Double_t hitterms[8*kNPlanes], hitcoefs[3*kNPlanes], aa3[9];
+    for(Int_t ihit=0;ihit<nhits;ihit++) {
+      Int_t pindex = plane_list[ihit];
+      for(Int_t isign=0;isign<2;isign++) {
+	Int_t pm = (isign==0) ? -1 : 1;
+	Double_t dpos = pos[ihit] + pm*dist[ihit] - psi0[pindex];
+	Double_t* terms = &hitterms[8*ihit+4*isign];
+	for(Int_t index=0;index<3;index++) {
+	  terms[index] = dpos*coefs[pindex][index]/sigma[pindex];
+	}
+	terms[3] = dpos/sigma[pindex];
+      }
+      for(Int_t index=0;index<3;index++) {
+	hitcoefs[3*ihit+index] = coefs[pindex][index];
+      }
+    }
+    const Double_t* m = aa3inv.GetMatrixArray();
+    for(Int_t i=0;i<9;i++) aa3[i] = m[i];
+
+    Double_t oldmin = 1e10, newmin = 1e10;
+    Int_t oldbest = -1, newbest = -1;
+    Int_t nplusminus = 1<<nhits;
+    for(Int_t pmloop=0;pmloop<nplusminus;pmloop++) {
+      Int_t plusminus[kNPlanes];
+      for(Int_t ihit=0;ihit<nhits;ihit++) {
+	plusminus[ihit] = (pmloop & (1<<ihit)) ? 1 : -1;
+      }
+      Double_t oldstub[4], newstub[4], prunedstub[4];
+      Double_t oldchi2 = OldFindStub(nhits, pos, dist, plane_list, psi0,
+				     sigma, coefs, aa3inv, plusminus, oldstub);
+      Double_t newchi2 = StubFitter::FindStub(nhits, hitterms, hitcoefs, aa3,
+					      plusminus, newstub);
+      if(oldchi2 != newchi2 || oldstub[0] != newstub[0] ||
+	 oldstub[1] != newstub[1] || oldstub[2] != newstub[2]) {
+	if(nbadfit++ < 10) {
+	  cout << "trial " << itrial << " pmloop " << pmloop << ": chi2 "
+	       << oldchi2 << " vs " << newchi2 << endl;
+	}
+      }
+      Double_t prunedchi2 = StubFitter::FindStub(nhits, hitterms, hitcoefs,
+						 aa3, plusminus, prunedstub,
+						 newmin);
+      if(oldchi2 < oldmin) { oldmin = oldchi2; oldbest = pmloop; }
+      if(prunedchi2 < newmin) { newmin = prunedchi2; newbest = pmloop; }
+    }
+    if(oldbest != newbest || oldmin != newmin) {
+      if(nbadsel++ < 10) {
+	cout << "trial " << itrial << ": best combination " << oldbest
+	     << " vs " << newbest << endl;
+      }
+    }
+  }
+
+  cout << "stub_fit_test: " << nbadfit << " fits and " << nbadsel
+       << " of " << ntrials << " selections differ" << endl;
+  return (nbadfit == 0 && nbadsel == 0) ? 0 : 1;
+}
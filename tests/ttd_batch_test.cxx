@@ -0,0 +1,48 @@
+// Check that the batch drift time to distance conversion of
+// THcDCLookupTTDConv gives the same bits as the per-hit conversion,
+// including times before the table, past its end and far out of range.
+
+#include "THcDCLookupTTDConv.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+int main()
+{
+  const Int_t nbins = 100;
+  Double_t table[nbins];
+  for(Int_t i=0;i<nbins;i++) {
+    table[i] = i/99.0 + 0.001*((i*7)%5);
+  }
+  THcDCLookupTTDConv conv(-20.0, 0.5, 2.0, nbins, table);
+
+  // Odd length, so the vector kernel also leaves a remainder
+  const UInt_t n = 100003;
+  vector<Double_t> times(n), dists(n);
+  srand(1);
+  for(UInt_t i=0;i<n;i++) {
+    times[i] = -300.0 + 600.0*rand()/RAND_MAX;
+  }
+  // Table edges and huge values
+  times[0] = -21.0;  times[1] = -19.9;  times[2] = 178.0;
+  times[3] = 179.0;  times[4] = 1e12;   times[5] = -1e12;
+  times[6] = 177.999;
+
+  conv.ConvertTimeToDist(&times[0], &dists[0], n);
+
+  Int_t nbad = 0;
+  for(UInt_t i=0;i<n;i++) {
+    Double_t single = conv.ConvertTimeToDist(times[i]);
+    if(memcmp(&single, &dists[i], sizeof(Double_t)) != 0) {
+      if(nbad++ < 10) {
+	cout << "time " << times[i] << ": single " << single
+	     << " batch " << dists[i] << endl;
+      }
+    }
+  }
+  cout << "ttd_batch_test: " << nbad << " of " << n << " differ" << endl;
+  return (nbad == 0) ? 0 : 1;
+}